@@ -23,9 +23,21 @@
 
 #pragma once
 
+#include <array>
 #include <chrono>
+#include <functional>
+#include <future>
+#include <list>
 
+#include "ComputeBaseline.h"
+#include "DescriptorHeap.h"
 #include "Device.h"
+#include "GpuTimer.h"
+#include "InputRecording.h"
+#include "MaxRecordsAdvisor.h"
+#include "NodeCostModel.h"
+#include "RecordTrace.h"
+#include "SafeMode.h"
 #include "ShaderCompiler.h"
 #include "Swapchain.h"
 #include "Window.h"
@@ -41,6 +53,116 @@ public:
         bool forceWarpAdapter         = false;
         bool enableDebugLayer         = false;
         bool enableGpuValidationLayer = false;
+
+        // Adapter selected by the first launch (see Device). Empty path disables the cache.
+        std::filesystem::path adapterCacheFile  = "adapter.cache";
+        // Benchmarks all adapters with work graphs support and stores the fastest one in the adapter cache
+        bool                  benchmarkAdapters = false;
+
+        // Output file for CPU trace zones. Trace is written on exit if "writeTraceOnExit" is set,
+        // or on demand from the "Trace" menu.
+        std::filesystem::path traceFile        = "trace.json";
+        bool                  writeTraceOnExit = false;
+
+        // Records per-frame input to file.
+        std::filesystem::path recordInputFile = "";
+        // Replays per-frame input from file (instead of live input) and exits once all frames were replayed.
+        std::filesystem::path replayInputFile = "";
+
+        // Renders every tutorial and sample solution offscreen and compares the results against golden images.
+        struct RegressionTestOptions {
+            bool                  enabled              = false;
+            // Writes the rendered images as new golden images instead of comparing them
+            bool                  updateGoldenImages   = false;
+            std::filesystem::path goldenImageDirectory = "goldens";
+        } regressionTest;
+
+        // Size of the offscreen render target, i.e. "RenderSize" in shaders. Zero follows the window size.
+        // Render targets that differ from the window size are shown as scaled preview.
+        std::uint32_t renderWidth  = 0;
+        std::uint32_t renderHeight = 0;
+
+        // Renders every tutorial and sample solution at a list of resolutions, writes the GPU times to this file and
+        // exits.
+        std::filesystem::path resolutionSweepFile = "";
+
+        // Compiles all tutorials under a matrix of compiler flags, writes a report to this file and exits.
+        std::filesystem::path optimizationReportFile = "";
+
+        // Dispatches a single node with synthetic input records at multiple record counts, writes the GPU times to
+        // "outputFile" and exits. See NodeBenchmark.h
+        struct NodeBenchmarkOptions {
+            std::filesystem::path      outputFile          = "";
+            std::uint32_t              tutorialIndex       = 0;
+            bool                       sampleSolution      = false;
+            // Node ID (e.g., "ShadePixel[1]") or function name of node
+            std::string                node                = "";
+            // Record fields (see NodeBenchmark::ParseRecordFields) or binary file with captured records
+            std::string                recordFields        = "";
+            std::filesystem::path      recordFile          = "";
+            std::vector<std::uint32_t> recordCounts        = {1, 16, 256, 4096, 65536};
+            // Splits records into DispatchGraph calls of at most this many records. Zero dispatches all at once.
+            std::uint32_t              maxBatchRecordCount = 0;
+        } nodeBenchmark;
+
+        // Measures GPU time and memory of every tutorial with a classic compute baseline (see ComputeBaseline.h) against
+        // its work graph, writes the results to this file and exits.
+        std::filesystem::path baselineBenchmarkFile = "";
+
+        // Rebuilds the backing memory of every tutorial and sample solution at sizes from MinSizeInBytes to
+        // MaxSizeInBytes, writes GPU time and initialization cost of each size to "outputFile" and exits.
+        struct BackingMemorySweepOptions {
+            std::filesystem::path outputFile = "";
+            // Number of sizes between MinSizeInBytes and MaxSizeInBytes (inclusive)
+            std::uint32_t         stepCount  = 16;
+            // Recommends the smallest size whose GPU time is within this percentage of the fastest size
+            double                tolerance  = 5.0;
+        } backingMemorySweep;
+
+        // Tiered compilation: work graphs are first created from an unoptimized build (-Od) for fast iteration,
+        // while the optimized build is compiled in the background and swapped in once it is ready.
+        bool tieredCompilation = true;
+
+        // Number of inactive work graphs kept alive for instant switching between tutorials and sample solutions.
+        // Least recently used work graphs are released if the cache exceeds this count or the memory limit.
+        std::uint32_t workGraphCacheSize        = 8;
+        // Limit for backing memory of all cached work graphs in bytes
+        std::uint64_t workGraphCacheMemoryLimit = 256 * 1024 * 1024;
+
+        // Compiles shaders using the shared compile server (see CompileServer.h) instead of in-process.
+        bool useCompileServer = false;
+        // Pack of compiled shaders (see ShaderPack.h). Shaders are loaded from the pack if their source files are
+        // unchanged, and newly compiled shaders are appended. Empty path disables the shader pack.
+        std::filesystem::path shaderPackFile = "shaders.pack";
+
+        // Watchdog against runaway work graphs (see "Watchdog" in the readme).
+        // Number of watchdog::Consume calls allowed per dispatch, see tutorials/Common.h. Zero disables the budget.
+        std::uint32_t         dispatchBudget        = 1 << 26;
+        // Time in milliseconds after which a frame that did not finish on the GPU is treated as a hang. Zero waits
+        // indefinitely.
+        std::uint32_t         gpuTimeout            = 10000;
+        // Last work graph that completed on the GPU. Safe mode starts with it instead of compiling the tutorial.
+        std::filesystem::path lastGoodWorkGraphFile = "lastgood.bin";
+        bool                  safeMode              = false;
+
+        // Dynamic record trace of a single frame (see RecordTrace.h), captured from the "Trace" menu or at
+        // "captureFrame".
+        struct RecordTraceOptions {
+            // ".json" files are written in Perfetto JSON format, other files as compact binary capture
+            std::filesystem::path outputFile   = "recordtrace.json";
+            // Capacity of the trace buffer in events of 16 bytes
+            std::uint32_t         capacity     = 1024 * 1024;
+            // Frame (counted from one) that is captured automatically. Zero only captures on demand.
+            std::uint64_t         captureFrame = 0;
+        } recordTrace;
+
+        // Profiling of [MaxRecords(...)] declarations (see MaxRecordsAdvisor.h), toggled in the "Trace" menu
+        struct MaxRecordsOptions {
+            // Written by "Write MaxRecords report" in the "Trace" menu and on exit, if MaxRecords were profiled
+            std::filesystem::path reportFile = "maxrecords.csv";
+            // Profiles from the first frame
+            bool                  profile    = false;
+        } maxRecords;
     };
 
     Application(const Options& options);
@@ -51,9 +173,78 @@ public:
     static std::span<const WorkGraph::WorkGraphTutorial> GetTutorials();
 
 private:
+    // Renders all tutorials offscreen and compares them against golden images. Throws if any test fails.
+    void RunRegressionTests();
+    // Writes optimization report (see OptimizationReport.h) including GPU times
+    void RunOptimizationReport();
+    // Writes GPU time of every tutorial and sample solution at multiple resolutions
+    void RunResolutionSweep();
+    // Writes GPU time of a single node at multiple record counts
+    void RunNodeBenchmark();
+    // Writes GPU time and memory of work graphs and their classic compute baselines
+    void RunBaselineBenchmark();
+    // Writes GPU time and initialization cost of work graphs at multiple backing memory sizes
+    void RunBackingMemorySweep();
+    // Number of frames every benchmark mode measures, the median GPU time of these frames is reported
+    static constexpr std::uint32_t BenchmarkFrameCount = 9;
+    // Returns the input of all benchmark modes: centered mouse and fixed time at the writable backbuffer size
+    InputFrame MakeBenchmarkInput(std::uint32_t tutorialIndex, bool sampleSolution) const;
+    // Dispatches "workGraph" "frameCount" times with "input" and returns median GPU time in milliseconds.
+    double MeasureDispatchTime(WorkGraph& workGraph, const InputFrame& input, std::uint32_t frameCount);
+    double MeasureDispatchTime(ComputeBaseline& baseline, const InputFrame& input, std::uint32_t frameCount);
+    // Records "dispatch" after binding shader resources with "bind" and returns median GPU time of "dispatch"
+    double MeasureGpuTime(std::uint32_t                                           frameCount,
+                          const std::function<void(ID3D12GraphicsCommandList10*)>& bind,
+                          const std::function<void(ID3D12GraphicsCommandList10*)>& dispatch);
+
     void OnRender(ID3D12GraphicsCommandList10* commandList, const Swapchain::RenderTarget& renderTarget);
+    // Sets root signature, root constants and descriptor tables for dispatching "workGraph" with "input".
+    // "descriptorIndex" selects the resource descriptors: 0 for the main view, 3 for the right half of split screen.
+    void BindShaderResources(ID3D12GraphicsCommandList10* commandList,
+                             const InputFrame&            input,
+                             const WorkGraph&             workGraph,
+                             std::uint32_t                descriptorIndex = 0);
+    // Binds "declaredResourceTable" for u3 - u10 instead of the resources declared by a work graph
+    void BindShaderResources(ID3D12GraphicsCommandList10* commandList,
+                             const InputFrame&            input,
+                             D3D12_GPU_DESCRIPTOR_HANDLE  declaredResourceTable,
+                             std::uint32_t                descriptorIndex = 0);
+    // Dispatches tutorial to the left and sample solution to the right half of the writable backbuffer
+    void DispatchSplitScreen(ID3D12GraphicsCommandList10* commandList, const InputFrame& input);
+    // Captures input of current frame from ImGui and window state
+    InputFrame GetLiveInputFrame() const;
+
     void OnRenderUserInterface(ID3D12GraphicsCommandList10* commandList, const Swapchain::RenderTarget& renderTarget);
     void OnResize(std::uint32_t width, std::uint32_t height);
+    // Resizes render target resources to the new render size. Resources are only re-created if they are too small or
+    // too large, as they are over-allocated.
+    void OnRenderSizeChanged(std::uint32_t width, std::uint32_t height);
+
+    // Render size is the window size, unless set explicitly
+    std::uint32_t GetRenderWidth() const;
+    std::uint32_t GetRenderHeight() const;
+
+    // Placement of the writable backbuffer in the window. Render targets that differ from the window size are scaled
+    // to fit the window.
+    struct PreviewRect {
+        float x;
+        float y;
+        float scale;
+    };
+    PreviewRect GetPreviewRect() const;
+    bool        IsScaledPreview() const;
+    // Writes shader resource view of writable backbuffer to a new descriptor for the scaled preview
+    void        CreatePreviewDescriptor();
+
+    // Processes window messages. Returns false if the window was closed.
+    bool HandleWindowEvents();
+
+    // Writes CPU trace zones to trace file. Writes the entire trace if "lastSeconds" is zero.
+    void WriteTrace(double lastSeconds);
+
+    // Runs static cost model on all nodes of the current work graph
+    void AnalyzeNodeCosts();
+    void OnRenderNodeCostWindow();
 
     void CreateImGuiContext();
     void DestroyImGuiContext();
@@ -61,13 +252,70 @@ private:
     void CreateWorkGraphRootSignature();
     // Creates work graph. Returns if creation was successful
     bool CreateWorkGraph();
+    // Releases least recently used work graphs until the cache is within its limits
+    void EvictCachedWorkGraphs();
+    // Creates, caches or releases the second work graph for split screen
+    void UpdateSplitScreenWorkGraph();
+    // Creates or releases the compute baseline of the current tutorial
+    void UpdateComputeBaseline();
+    // Starts compiling the optimized library of the current work graph on a background thread
+    void CompileOptimizedWorkGraph();
+    // Replaces the preview work graph once its optimized library finished compiling
+    void SwapOptimizedWorkGraph();
 
     // Util methods for shader resources
     void CreateResourceDescriptorHeaps();
+    // Sets render size of writable backbuffer, re-creating it if the current one does not fit
     void CreateWritableBackbuffer(std::uint32_t width, std::uint32_t height);
     void CreateScratchBuffer();
     void CreatePersistentScratchBuffer();
+    void CreateDispatchBudgetBuffer();
+    // Copies dispatch budget counters of the current frame to its readback slot
+    void ReadbackDispatchBudget(ID3D12GraphicsCommandList10* commandList);
+    // Checks counters of the frame that previously used the current frame context
+    void CheckDispatchBudget();
+    // Stores the current work graph as last good work graph once the GPU finished the current frame
+    void SaveLastGoodWorkGraph();
+    // Clears the record trace buffer if a record trace of the current frame was requested. Returns false if no record
+    // trace is captured.
+    bool BeginRecordTrace(ID3D12GraphicsCommandList10* commandList);
+    // Reads back the record trace buffer and writes the record trace once the GPU finished the current frame
+    void EndRecordTrace(ID3D12GraphicsCommandList10* commandList);
+    // Collects MaxRecords peaks of completed frames and resets them if the work graph changed. Returns false if
+    // MaxRecords are not profiled.
+    bool BeginMaxRecordsProfiling(ID3D12GraphicsCommandList10* commandList);
+    void EndMaxRecordsProfiling(ID3D12GraphicsCommandList10* commandList);
+    // Merges peaks of the readback slot of a completed frame
+    void MergeMaxRecordsPeaks(std::uint32_t frameIndex);
+    // Writes suggested bounds of the current work graph to maxRecordsReportFile_. Backing memory savings are measured
+    // by compiling variants of the shader file with the suggested bounds.
+    void WriteMaxRecordsReport();
+    // Returns MaxSizeInBytes of the backing memory of "shaderFileName" with rewritten MaxRecords bounds.
+    // The variant is compiled from memory and backing memory is never allocated.
+    std::uint64_t GetBackingMemorySize(const std::string&                  shaderFileName,
+                                       const std::string&                  source,
+                                       const std::vector<MaxRecordsProbe>& probes,
+                                       const std::vector<std::uint32_t>&   maxRecords);
+    // Creates shader resources for the right half of split screen
+    void CreateSplitScreenResources(std::uint32_t width, std::uint32_t height);
     void ClearShaderResources(ID3D12GraphicsCommandList10* commandList);
+    void ClearSplitScreenResources(ID3D12GraphicsCommandList10* commandList);
+
+    // Creates resource and writes its UAV descriptor at "descriptorIndex" to the clear descriptor heap
+    ComPtr<ID3D12Resource> CreateUnorderedAccessTexture(std::uint32_t width,
+                                                        std::uint32_t height,
+                                                        std::uint32_t descriptorIndex);
+    ComPtr<ID3D12Resource> CreateUnorderedAccessBuffer(std::uint32_t elementCount, std::uint32_t descriptorIndex);
+    // Clears texture to white and buffer to zero
+    void ClearUnorderedAccessTexture(ID3D12GraphicsCommandList10* commandList,
+                                     ID3D12Resource*              resource,
+                                     std::uint32_t                descriptorIndex);
+    void ClearUnorderedAccessBuffer(ID3D12GraphicsCommandList10* commandList,
+                                    ID3D12Resource*              resource,
+                                    std::uint32_t                descriptorIndex);
+    // Copies changed descriptors to a new range of shader visible descriptors
+    void                        UpdateResourceDescriptors();
+    D3D12_GPU_DESCRIPTOR_HANDLE GetResourceDescriptorHandle(std::uint32_t descriptorIndex) const;
 
     void CreateFontBuffer();
 
@@ -77,18 +325,127 @@ private:
 
     bool vsync_ = true;
 
-    // Descriptor heap for ImGui
-    ComPtr<ID3D12DescriptorHeap> uiDescriptorHeap_;
+    std::filesystem::path traceFile_;
+    bool                  writeTraceOnExit_;
 
-    // Descriptor heaps for shader resources
+    // Input recording & replay
+    std::unique_ptr<InputRecorder> inputRecorder_;
+    std::unique_ptr<InputReplay>   inputReplay_;
+    InputFrame                     replayFrame_ = {};
+
+    Options::RegressionTestOptions     regressionTestOptions_;
+    std::filesystem::path              optimizationReportFile_;
+    std::filesystem::path              resolutionSweepFile_;
+    Options::NodeBenchmarkOptions      nodeBenchmarkOptions_;
+    std::filesystem::path              baselineBenchmarkFile_;
+    Options::BackingMemorySweepOptions backingMemorySweepOptions_;
+
+    // Explicit render size. Zero follows the window size.
+    std::uint32_t renderWidth_;
+    std::uint32_t renderHeight_;
+
+    // Static node cost estimates of current work graph. Analyzed on demand, as disassembly requires the compiler.
+    std::vector<NodeCost> nodeCosts_;
+    bool                  nodeCostsValid_     = false;
+    bool                  showNodeCostWindow_ = false;
+
+    static constexpr std::uint32_t DescriptorHeapSize      = 4096;
+    static constexpr std::uint32_t ResourceDescriptorCount = 9;
+
+    // Single shader visible descriptor heap for ImGui, shader resources and resources declared by tutorials.
+    // Descriptors used by frames in flight are never overwritten, changed descriptors are written to a new range.
+    std::unique_ptr<DescriptorHeap> descriptorHeap_;
+    std::uint32_t                   previewDescriptorIndex_ = DescriptorHeap::InvalidIndex;
+
+    // Descriptors for shader resources are created in the clear descriptor heap and copied to the shader visible
+    // descriptor heap on their next use.
     ComPtr<ID3D12DescriptorHeap> clearDescriptorHeap_;
-    ComPtr<ID3D12DescriptorHeap> resourceDescriptorHeap_;
+    std::uint32_t                resourceDescriptorIndex_    = DescriptorHeap::InvalidIndex;
+    bool                         resourceDescriptorsChanged_ = true;
 
     // Shader resources
     ComPtr<ID3D12Resource> writableBackbuffer_;
+    // Render size of writable backbuffer. Backbuffer is over-allocated, such that window resizing can reuse it.
+    std::uint32_t          writableBackbufferWidth_  = 0;
+    std::uint32_t          writableBackbufferHeight_ = 0;
     ComPtr<ID3D12Resource> scratchBuffer_;
     ComPtr<ID3D12Resource> persistentScratchBuffer_;
 
+    // Sizes of scratch buffers in 32-bit elements. See tutorials/Common.h
+    static constexpr std::uint32_t ScratchBufferElementCount           = 100 * 1024;
+    static constexpr std::uint32_t PersistentScratchBufferElementCount = 100 * 1024 * 1024;
+
+    // Split screen: second work graph and shader resources for the right half.
+    // Resources are created on first use, as the persistent scratch buffer is large.
+    bool                       splitScreen_ = false;
+    std::unique_ptr<WorkGraph> splitWorkGraph_;
+    // See workGraphLibraryHash_ and shaderSourceGeneration_
+    std::uint64_t              splitLibraryHash_      = 0;
+    std::uint64_t              splitSourceGeneration_ = 0;
+    ComPtr<ID3D12Resource>     splitBackbuffer_;
+    ComPtr<ID3D12Resource>     splitScratchBuffer_;
+    ComPtr<ID3D12Resource>     splitPersistentScratchBuffer_;
+    bool                       clearSplitPersistentScratchBuffer_ = true;
+    std::unique_ptr<GpuTimer>  splitGpuTimer_;
+    // Smoothed GPU times of left and right half in milliseconds
+    std::array<double, 2>      splitGpuTimes_ = {};
+
+    // Classic compute baseline of the current tutorial, dispatched instead of its work graph
+    bool                             useComputeBaseline_ = false;
+    std::unique_ptr<ComputeBaseline> computeBaseline_;
+    // See shaderSourceGeneration_
+    std::uint64_t                    computeBaselineSourceGeneration_ = 0;
+
+    // Watchdog: per-dispatch counters of watchdog::Consume calls (main view at offset 0, right half of split screen at
+    // offset 16), cleared every frame and copied to one readback slot per frame in flight.
+    std::uint32_t          dispatchBudget_;
+    ComPtr<ID3D12Resource> dispatchBudgetBuffer_;
+    ComPtr<ID3D12Resource> dispatchBudgetReadbackBuffer_;
+    const std::uint32_t*   dispatchBudgetReadback_ = nullptr;
+    bool                   dispatchBudgetExceeded_ = false;
+
+    // Two counters with 16 byte alignment for root UAV offsets
+    static constexpr std::uint32_t DispatchBudgetBufferSize = 32;
+
+    // Dynamic record trace, see RecordTrace.h. Trace buffers are created on the first capture.
+    Options::RecordTraceOptions recordTraceOptions_;
+    bool                        recordTraceRequested_ = false;
+    // Bound as "RecordTraceCapacity", only non-zero while the captured frame is recorded
+    std::uint32_t               recordTraceCapacity_  = 0;
+    // Readback of a capture is in flight
+    bool                        recordTracePending_   = false;
+    ComPtr<ID3D12Resource>      recordTraceBuffer_;
+    ComPtr<ID3D12Resource>      recordTraceReadbackBuffer_;
+    // Rebuilds and writes the execution tree of the last capture on a worker thread
+    std::future<void>           recordTraceWriter_;
+    // Number of frames rendered by OnRender
+    std::uint64_t               frameCount_ = 0;
+
+    // MaxRecords profiling, see MaxRecordsAdvisor.h. Profiling buffers are created on first use.
+    std::filesystem::path  maxRecordsReportFile_;
+    bool                   maxRecordsProfiling_  = false;
+    // Bound as "MaxRecordsProbeCount", only non-zero for dispatches of the main work graph while profiling
+    std::uint32_t          maxRecordsProbeCount_ = 0;
+    ComPtr<ID3D12Resource> maxRecordsBuffer_;
+    // One readback slot per frame in flight, persistently mapped
+    ComPtr<ID3D12Resource> maxRecordsReadbackBuffer_;
+    const std::uint32_t*   maxRecordsReadback_ = nullptr;
+    // Peaks are reset whenever the work graph changes, as probe ids may refer to other declarations.
+    // Readback slots are only merged if they were written after the last reset.
+    bool                   resetMaxRecordsPeaks_          = true;
+    std::uint64_t          maxRecordsPeakGeneration_      = 0;
+    std::uint64_t          maxRecordsWorkGraphGeneration_ = 0;
+
+    std::array<std::uint64_t, Device::BufferedFramesCount>      maxRecordsReadbackGeneration_ = {};
+    std::array<std::uint32_t, MaxRecordsAdvisor::MaxProbeCount> maxRecordsPeaks_              = {};
+
+    static constexpr std::uint32_t MaxRecordsBufferSize = MaxRecordsAdvisor::MaxProbeCount * sizeof(std::uint32_t);
+
+    // Last work graph that completed on the GPU, see SafeMode.h
+    std::filesystem::path lastGoodWorkGraphFile_;
+    // Work graph generation that was last written to the last good work graph file
+    std::uint64_t         lastGoodWorkGraphGeneration_ = 0;
+
     // Buffer resource containing font atlas
     ComPtr<ID3D12Resource> fontBuffer_;
 
@@ -99,6 +456,10 @@ private:
     std::chrono::high_resolution_clock::time_point errorMessageEndTime_ = std::chrono::high_resolution_clock::now();
     // Start time of current tutorial. Delta to current time is available in the shader as "Time"
     std::chrono::high_resolution_clock::time_point startTime_           = std::chrono::high_resolution_clock::now();
+    // Construction time of the application, for measuring the time to the first presented frame
+    std::chrono::high_resolution_clock::time_point launchTime_          = std::chrono::high_resolution_clock::now();
+    std::chrono::high_resolution_clock::duration   initialCompileTime_  = {};
+    bool                                           firstFramePresented_ = false;
 
     // Work Graph resources
     ShaderCompiler              shaderCompiler_;
@@ -106,4 +467,60 @@ private:
     std::uint32_t               workGraphTutorialIndex_     = 0;
     bool                        workGraphUseSampleSolution_ = false;
     std::unique_ptr<WorkGraph>  workGraph_;
+    // Code hash (see ShaderCompiler::HashShaderCode) of the library compiled by the last CreateWorkGraph call.
+    // For tiered compilation, this is the hash of the preview build, even after the optimized build was swapped in.
+    std::uint64_t workGraphLibraryHash_ = 0;
+    // Incremented whenever shader source files change. Work graphs and baselines of an older generation are
+    // re-validated by their library hash once they are used again, and only re-created if their library changed.
+    std::uint64_t shaderSourceGeneration_    = 0;
+    std::uint64_t workGraphSourceGeneration_ = 0;
+
+    // Tiered compilation
+    enum class CompileTier {
+        // Unoptimized build (-Od) for fast iteration
+        Preview,
+        Optimized,
+    };
+    struct OptimizedLibrary {
+        std::uint64_t    generation;
+        ComPtr<IDxcBlob> library;
+    };
+    struct CompiledLibrary {
+        ComPtr<IDxcBlob>                             library;
+        CompileTier                                  tier;
+        std::uint64_t                                libraryHash;
+        std::vector<WorkGraph::ResourceDeclaration>  resourceDeclarations;
+        std::chrono::high_resolution_clock::duration compileTime;
+    };
+
+    // Compiles library of tutorial using shaderCompiler_. For tiered compilation, this is the preview build, unless
+    // the optimized build is already in the shader pack. Throws on compile errors.
+    CompiledLibrary CompileWorkGraphLibrary(std::uint32_t tutorialIndex, bool sampleSolution);
+    // Switches to cached work graph of the selected tutorial. Returns false if the work graph is not cached.
+    // Work graphs cached before shader sources changed are only activated if "compiled" (the current library of the
+    // tutorial) is given and matches their library, otherwise they are released.
+    bool ActivateCachedWorkGraph(const CompiledLibrary* compiled = nullptr);
+
+    bool        tieredCompilation_;
+    CompileTier workGraphTier_ = CompileTier::Optimized;
+    // Incremented whenever the work graph is re-created. Optimized libraries of older generations are discarded.
+    std::uint64_t workGraphGeneration_ = 0;
+    // Separate compiler instance for the background thread, as DXC compiler instances are not thread-safe
+    ShaderCompiler                       optimizingShaderCompiler_;
+    std::shared_future<OptimizedLibrary> optimizedLibrary_;
+    // First work graph library, compiled on a worker thread during initialization
+    std::future<CompiledLibrary>         initialLibrary_;
+
+    // Inactive work graphs, most recently used first
+    struct CachedWorkGraph {
+        std::unique_ptr<WorkGraph> workGraph;
+        CompileTier                tier;
+        // See workGraphLibraryHash_ and shaderSourceGeneration_
+        std::uint64_t              libraryHash;
+        std::uint64_t              sourceGeneration;
+    };
+
+    std::list<CachedWorkGraph> workGraphCache_;
+    std::uint32_t              workGraphCacheSize_;
+    std::uint64_t              workGraphCacheMemoryLimit_;
 };
\ No newline at end of file
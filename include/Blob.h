@@ -0,0 +1,61 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include "Device.h"
+
+//
+#include <dxcapi.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// IDxcBlob that either owns a copy of its data or references memory kept alive by an owner (e.g. a mapped file).
+// Allows handing out compiled shaders (e.g. received from the compile server) without loading dxcompiler.dll.
+class Blob : public IDxcBlob {
+public:
+    static ComPtr<IDxcBlob> Create(std::vector<std::uint8_t> data);
+    // Does not copy "data". "owner" is kept alive for the lifetime of the blob.
+    static ComPtr<IDxcBlob> CreateView(const void* data, std::size_t size, std::shared_ptr<const void> owner);
+
+    LPVOID STDMETHODCALLTYPE GetBufferPointer(void) override;
+    SIZE_T STDMETHODCALLTYPE GetBufferSize(void) override;
+
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, _COM_Outptr_ void __RPC_FAR* __RPC_FAR* ppvObject) override;
+    ULONG STDMETHODCALLTYPE   AddRef(void) override;
+    ULONG STDMETHODCALLTYPE   Release(void) override;
+
+private:
+    Blob(std::vector<std::uint8_t> data);
+    Blob(const void* data, std::size_t size, std::shared_ptr<const void> owner);
+
+    std::atomic<ULONG> refCount_ = 1;
+
+    std::vector<std::uint8_t>   data_;
+    const void*                 pointer_ = nullptr;
+    std::size_t                 size_    = 0;
+    std::shared_ptr<const void> owner_;
+};
@@ -0,0 +1,88 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include "ShaderCompiler.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Local compile server process, started with "--compileServer".
+// Keeps dxcompiler.dll loaded and shares compiled shaders between all playground instances and tools on this machine.
+// Requests are served over a named pipe; each connection is handled by its own thread & compiler instance.
+// Crashes of the compiler only take down the server, and clients report them as compile errors.
+class CompileServer {
+public:
+    static constexpr const wchar_t* PipeName = L"\\\\.\\pipe\\WorkGraphPlaygroundCompiler";
+
+    // Server exits once no client was connected for "idleTimeout"
+    CompileServer(std::chrono::seconds idleTimeout = std::chrono::minutes(10));
+    ~CompileServer();
+
+    // Serves clients until idle timeout is reached
+    void Run();
+
+private:
+    void ServeClient(HANDLE pipe);
+
+    ShaderCompileResult CompileCached(ShaderCompiler& compiler, const ShaderCompileRequest& request);
+
+    std::chrono::seconds idleTimeout_;
+
+    std::vector<std::thread>   clientThreads_;
+    std::atomic<std::uint32_t> activeClientCount_ = 0;
+
+    // Guards cache & last activity time
+    std::mutex                                             mutex_;
+    std::unordered_map<std::uint64_t, ShaderCompileResult> cache_;
+    std::chrono::steady_clock::time_point                  lastActivityTime_;
+};
+
+// Client-side of the compile server connection. Used by ShaderCompiler.
+class CompileClient {
+public:
+    CompileClient() = default;
+    ~CompileClient();
+
+    // Connects to the compile server and launches it, if no server is running.
+    // Returns false if no connection could be established.
+    bool Connect();
+
+    // Throws if connection to the server was lost, e.g. if the compiler crashed.
+    ShaderCompileResult Compile(const ShaderCompileRequest& request);
+
+private:
+    bool OpenPipe();
+    bool LaunchServer();
+    void Disconnect();
+
+    HANDLE pipe_              = INVALID_HANDLE_VALUE;
+    // Set if server could not be launched. All further shaders are compiled in-process.
+    bool   serverUnavailable_ = false;
+};
@@ -0,0 +1,118 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <array>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "DescriptorHeap.h"
+#include "Device.h"
+#include "ShaderCompiler.h"
+#include "WorkGraph.h"
+
+// Classic compute implementation of a tutorial, i.e., what would be shipped without work graphs.
+// Baselines are shader files next to the tutorial ("<Tutorial>Baseline.hlsl") and consist of compute passes, which
+// are declared with annotation comments and executed in order of declaration:
+//   // @Pass(<function>, <x>, <y>, <z>)           dispatches a fixed number of thread groups
+//   // @Pass(<function>, RenderSize, <w>, <h>)   dispatches one thread per pixel, with <w>x<h> threads per group
+//   // @Pass(<function>, Indirect, <offset>)      dispatches D3D12_DISPATCH_ARGUMENTS read from ScratchBuffer at
+//                                                 byte <offset>, e.g. written by an append queue of a previous pass
+// An optional last argument repeats the pass, e.g. once per recursion level. The repetition is available in shaders
+// as "PassIteration". Repetition i of an indirect pass reads its arguments at <offset> + i * IndirectArgumentStride.
+// Baselines can declare resources (e.g., queues) like tutorials, see WorkGraph::ResourceDeclaration.
+class ComputeBaseline {
+public:
+    struct Pass {
+        enum class Type {
+            Fixed,
+            RenderSize,
+            Indirect,
+        };
+
+        std::string                  functionName;
+        Type                         type;
+        // Thread group count for fixed passes, threads per group for render size passes
+        std::array<std::uint32_t, 3> size           = {1, 1, 1};
+        // Byte offset of dispatch arguments in ScratchBuffer for indirect passes
+        std::uint32_t                argumentOffset = 0;
+        std::uint32_t                iterations     = 1;
+    };
+
+    // Stride between dispatch arguments of repeated indirect passes
+    static constexpr std::uint32_t IndirectArgumentStride = 16;
+    // Offset of "PassIteration" in root constants (root parameter 0)
+    static constexpr std::uint32_t PassIterationConstant  = 6;
+
+    // Compiles all passes of the baseline of the given tutorial. Throws if the tutorial has no baseline.
+    ComputeBaseline(const Device*        device,
+                    ShaderCompiler&      shaderCompiler,
+                    DescriptorHeap&      descriptorHeap,
+                    ID3D12RootSignature* rootSignature,
+                    std::uint32_t        tutorialIndex);
+    ~ComputeBaseline();
+
+    // Executes all passes. Root signature, root constants and descriptor tables must be bound.
+    // "scratchBuffer" must be in UNORDERED_ACCESS state and is used as source for indirect arguments.
+    void Dispatch(ID3D12GraphicsCommandList10* commandList,
+                  std::uint32_t                renderWidth,
+                  std::uint32_t                renderHeight,
+                  ID3D12Resource*              scratchBuffer);
+
+    std::uint32_t GetTutorialIndex() const;
+    // Allocated size of declared resources and the indirect argument buffer in bytes
+    std::uint64_t GetMemorySize() const;
+    // Hash of pass declarations, resource declarations and compiled shaders, see HashSources
+    std::uint64_t GetSourceHash() const;
+
+    std::span<const WorkGraph::ResourceDeclaration> GetResourceDeclarations() const;
+    // Descriptor table with UAVs of declared resources for u3 - u10
+    D3D12_GPU_DESCRIPTOR_HANDLE                     GetResourceDescriptorTable() const;
+
+    // Compiles the baseline of tutorial without creating it and returns the hash that GetSourceHash would return.
+    // Edits to comments or whitespace in the shader code do not change the hash.
+    static std::uint64_t     HashSources(ShaderCompiler& shaderCompiler, std::uint32_t tutorialIndex);
+    // Returns baseline shader file of tutorial. Throws if the tutorial has no baseline.
+    static std::string       GetShaderFileName(std::uint32_t tutorialIndex);
+    // Reads pass declarations from baseline shader file. Throws if a declaration is invalid.
+    static std::vector<Pass> ReadPasses(const ShaderCompiler& shaderCompiler, const std::string& shaderFileName);
+
+private:
+    std::uint32_t tutorialIndex_;
+
+    std::vector<Pass>                        passes_;
+    std::vector<ComPtr<ID3D12PipelineState>> pipelineStates_;
+    std::uint64_t                            sourceHash_ = 0;
+
+    // Indirect arguments are copied from ScratchBuffer, as the pass may write ScratchBuffer while reading them
+    ComPtr<ID3D12Resource>         argumentBuffer_;
+    ComPtr<ID3D12CommandSignature> commandSignature_;
+
+    std::vector<WorkGraph::ResourceDeclaration> resourceDeclarations_;
+    std::vector<ComPtr<ID3D12Resource>>         resources_;
+    std::uint64_t                               memorySize_ = 0;
+    DescriptorHeap&                             descriptorHeap_;
+    std::uint32_t                               resourceDescriptorIndex_ = DescriptorHeap::InvalidIndex;
+};
@@ -0,0 +1,58 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <map>
+
+#include "Device.h"
+
+// Shader visible CBV/SRV/UAV descriptor heap shared by the user interface, the built-in shader resources and the
+// resources declared by tutorials. All descriptors live in a single heap, such that it only needs to be bound once per
+// command list. Ranges of consecutive descriptors are allocated with a first-fit free list.
+class DescriptorHeap {
+public:
+    DescriptorHeap(Device* device, std::uint32_t descriptorCount);
+
+    // Allocates "count" consecutive descriptors and returns the index of the first one. Throws if the heap is full.
+    std::uint32_t Allocate(std::uint32_t count);
+    // Returns descriptors to the free list once the GPU finished all work submitted so far
+    void          Free(std::uint32_t index, std::uint32_t count);
+
+    ID3D12DescriptorHeap*       GetHeap() const;
+    D3D12_CPU_DESCRIPTOR_HANDLE GetCPUHandle(std::uint32_t index) const;
+    D3D12_GPU_DESCRIPTOR_HANDLE GetGPUHandle(std::uint32_t index) const;
+
+    static constexpr std::uint32_t InvalidIndex = 0xFFFFFFFFU;
+
+private:
+    // Inserts range into the free list, merging it with adjacent free ranges
+    void Release(std::uint32_t index, std::uint32_t count);
+
+    Device*                      device_;
+    ComPtr<ID3D12DescriptorHeap> heap_;
+    std::uint32_t                descriptorSize_;
+
+    // Free ranges: index of first descriptor -> descriptor count
+    std::map<std::uint32_t, std::uint32_t> freeRanges_;
+};
@@ -24,7 +24,13 @@
 #pragma once
 
 #include <array>
+#include <chrono>
+#include <deque>
+#include <filesystem>
+#include <functional>
 #include <memory>
+#include <stdexcept>
+#include <vector>
 
 // Device.h is also the common header for all D3D12 & WRL headers
 #include <d3dx12/d3dx12.h>
@@ -47,16 +53,53 @@ using Microsoft::WRL::ComPtr;
 // Helpers for D3D12 methods
 void ThrowIfFailed(HRESULT hr);
 
+// Thrown if the GPU did not finish submitted work within the GPU timeout, or if the device was removed (e.g., after the
+// OS reset the GPU). The device cannot be used anymore.
+class DeviceLostError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
 class Device {
 public:
     static constexpr std::uint32_t BufferedFramesCount = 3;
 
-    Device(bool forceWarpAdapter, bool enableDebugLayer, bool enableGpuValidationLayer);
-
+    // Adapters are tried in order of GPU preference (high performance first). The selected adapter is stored in
+    // "adapterCacheFile", such that later launches use it without probing all adapters. Empty path disables the cache.
+    // "benchmarkAdapters" ignores the cache, benchmarks every adapter with work graphs support and selects the fastest.
+    // Waiting for the GPU throws DeviceLostError after "gpuTimeout". Zero waits indefinitely.
+    Device(bool                         forceWarpAdapter,
+           bool                         enableDebugLayer,
+           bool                         enableGpuValidationLayer,
+           const std::filesystem::path& adapterCacheFile,
+           bool                         benchmarkAdapters,
+           std::chrono::milliseconds    gpuTimeout = {});
+
+    // Throws DeviceLostError if the GPU does not finish within the GPU timeout. Returns immediately after the device
+    // was lost, such that shutdown does not hang.
     void WaitForDevice();
+    // Invokes "callback" once the GPU finished all work submitted so far, including the frame currently being recorded.
+    // Callbacks run on the render thread when a frame context is reused or in WaitForDevice. Callbacks must handle
+    // their own errors; exceptions that escape a callback are only logged.
+    void OnCompleted(std::function<void()> callback);
+
+    // Releases "object" (ComPtr or std::unique_ptr) once the GPU finished all work submitted so far.
+    // Allows replacing resources without waiting for the device.
+    template <typename T>
+    void DeferRelease(T object)
+    {
+        if (!object) {
+            return;
+        }
+
+        // Object is released with the task. Shared pointer keeps the task copyable for move-only objects.
+        OnCompleted([object = std::make_shared<T>(std::move(object))]() {});
+    }
 
     ID3D12GraphicsCommandList10* GetNextFrameCommandList();
     void                         ExecuteCurrentFrameCommandList();
+    // Index of the current frame context in [0, BufferedFramesCount)
+    std::uint32_t                GetFrameIndex() const;
 
     IDXGIFactory4*      GetDXGIFactory() const;
     ID3D12Device9*      GetDevice() const;
@@ -66,12 +109,24 @@ public:
 
 private:
     void                  CreateDXGIFactory(bool enableDebugLayer, bool enableGpuValidationLayer);
+    // Returns all adapters, ordered by GPU preference if supported by the DXGI factory
+    std::vector<ComPtr<IDXGIAdapter1>> EnumerateAdapters() const;
+    // Creates device on adapter stored in adapter cache. Returns null if cache is missing or adapter is unavailable.
+    ComPtr<ID3D12Device9> CreateCachedDevice(const std::filesystem::path& adapterCacheFile) const;
+    // Creates device on first (or fastest, if "benchmarkAdapters" is set) adapter with work graphs support
+    ComPtr<ID3D12Device9> SelectDevice(const std::filesystem::path& adapterCacheFile, bool benchmarkAdapters) const;
     ComPtr<ID3D12Device9> CreateDevice(IDXGIAdapter1* adapter) const;
     bool                  CheckDeviceFeatures(ID3D12Device9* device) const;
     void                  CreateDeviceResources();
 
     void RegisterDebugMessageCallback();
 
+    // Waits until "fenceValue" was signaled. Throws DeviceLostError on timeout or device removal.
+    void WaitForFence(std::uint64_t fenceValue);
+
+    // Runs and releases completion tasks whose fence value was reached
+    void ProcessCompletionTasks();
+
     ComPtr<IDXGIFactory4> dxgiFactory_;
 
     std::string adapterDescription_ = "Unknown Adapter";
@@ -88,7 +143,16 @@ private:
     std::array<FrameContext, BufferedFramesCount> frameContexts_;
     std::uint32_t                                 frameIndex_;
 
-    ComPtr<ID3D12Fence> fence_;
-    HANDLE              fenceEvent_;
-    std::uint64_t       signaledFenceValue_ = 0;
+    ComPtr<ID3D12Fence>       fence_;
+    HANDLE                    fenceEvent_;
+    std::uint64_t             signaledFenceValue_ = 0;
+    std::chrono::milliseconds gpuTimeout_;
+    bool                      lost_ = false;
+
+    // Completion tasks, ordered by the fence value that needs to be reached
+    struct CompletionTask {
+        std::uint64_t         fenceValue;
+        std::function<void()> callback;
+    };
+    std::deque<CompletionTask> completionTasks_;
 };
\ No newline at end of file
@@ -0,0 +1,62 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <vector>
+
+#include "Device.h"
+
+// Measures GPU time between pairs of timestamp queries.
+// Timestamps are resolved into a readback buffer with one slot per buffered frame. Results of a slot can be
+// read once the GPU has finished the command list that resolved the slot.
+class GpuTimer {
+public:
+    GpuTimer(ID3D12Device* device, ID3D12CommandQueue* commandQueue, std::uint32_t timerCount, std::uint32_t slotCount);
+
+    // Reads the results of "slot" (if they were resolved before) and starts recording timestamps to "slot".
+    void BeginFrame(std::uint32_t slot);
+    // Resolves all timestamps of current slot.
+    void EndFrame(ID3D12GraphicsCommandList* commandList);
+
+    void Begin(ID3D12GraphicsCommandList* commandList, std::uint32_t timerIndex);
+    void End(ID3D12GraphicsCommandList* commandList, std::uint32_t timerIndex);
+
+    // Reads the results of "slot" without starting a new frame.
+    void CollectResults(std::uint32_t slot);
+
+    // Returns the most recently collected time of "timerIndex" in milliseconds.
+    double GetMilliseconds(std::uint32_t timerIndex) const;
+
+private:
+    std::uint32_t timerCount_;
+    std::uint32_t slotCount_;
+    std::uint32_t currentSlot_ = 0;
+    double        ticksPerMillisecond_;
+
+    ComPtr<ID3D12QueryHeap> queryHeap_;
+    ComPtr<ID3D12Resource>  readbackBuffer_;
+
+    std::vector<bool>   slotResolved_;
+    std::vector<double> milliseconds_;
+};
@@ -0,0 +1,45 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+// 64-bit FNV-1a hashes for content-addressing shader sources and compiled shaders.
+// These hashes are not suitable for any security purposes.
+constexpr std::uint64_t HashSeed = 0xcbf29ce484222325ULL;
+
+std::uint64_t HashBytes(const void* data, std::size_t size, std::uint64_t seed = HashSeed);
+
+template <typename T>
+std::uint64_t HashString(std::basic_string_view<T> string, const std::uint64_t seed = HashSeed)
+{
+    // Include length to distinguish e.g. {"ab", "c"} from {"a", "bc"} when hashing string sequences
+    const auto length = static_cast<std::uint64_t>(string.size());
+    return HashBytes(string.data(), string.size() * sizeof(T), HashBytes(&length, sizeof(length), seed));
+}
+
+// Hashes the contents of "path". Throws if the file cannot be read.
+std::uint64_t HashFile(const std::filesystem::path& path, std::uint64_t seed = HashSeed);
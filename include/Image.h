@@ -0,0 +1,62 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+// 8-bit RGB image used for golden-image comparisons.
+// Images are stored as binary PPM (P6) files, which can be viewed with most image viewers.
+class Image {
+public:
+    struct Difference {
+        // Number of pixels where at least one channel differs by more than the tolerance
+        std::uint64_t differentPixels      = 0;
+        // Largest absolute difference of any channel
+        std::uint32_t maxChannelDifference = 0;
+    };
+
+    Image() = default;
+    Image(std::uint32_t width, std::uint32_t height);
+
+    static Image Load(const std::filesystem::path& path);
+    void         Save(const std::filesystem::path& path) const;
+
+    // Compares two images of the same size. Channel differences up to "channelTolerance" are ignored.
+    static Difference Compare(const Image& a, const Image& b, std::uint32_t channelTolerance);
+
+    std::uint32_t GetWidth() const;
+    std::uint32_t GetHeight() const;
+    std::uint64_t GetPixelCount() const;
+
+    // Tightly packed RGB pixel data, row by row.
+    std::vector<std::uint8_t>&       GetData();
+    const std::vector<std::uint8_t>& GetData() const;
+
+private:
+    std::uint32_t             width_  = 0;
+    std::uint32_t             height_ = 0;
+    std::vector<std::uint8_t> data_;
+};
@@ -0,0 +1,70 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+
+// Per-frame input to work graphs. This is everything that is passed to the tutorials as root constants,
+// plus the selected tutorial, such that a recording fully determines the workload of every frame.
+struct InputFrame {
+    std::uint32_t width;
+    std::uint32_t height;
+    float         mouseX;
+    float         mouseY;
+    std::uint32_t inputState;
+    float         time;
+    std::uint32_t tutorialIndex;
+    std::uint32_t sampleSolution;
+};
+
+// Writes input frames to a binary file.
+// File layout: 8 byte header (magic & version), followed by tightly packed InputFrame structs.
+class InputRecorder {
+public:
+    InputRecorder(const std::filesystem::path& path);
+
+    void RecordFrame(const InputFrame& frame);
+
+private:
+    std::ofstream file_;
+};
+
+// Reads input frames from a file written by InputRecorder.
+class InputReplay {
+public:
+    InputReplay(const std::filesystem::path& path);
+
+    // Reads next frame. Returns false if all frames have been replayed.
+    bool NextFrame(InputFrame& frame);
+    // Reads next frame without advancing. Returns false if all frames have been replayed.
+    bool PeekFrame(InputFrame& frame);
+
+    std::uint64_t GetFrameCount() const;
+
+private:
+    std::ifstream file_;
+    std::uint64_t frameCount_;
+};
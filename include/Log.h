@@ -0,0 +1,88 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <sstream>
+#include <string_view>
+
+// Asynchronous log for messages of the render thread, the D3D12 debug layer and the shader compiler.
+// Messages are pushed into a fixed-size lock-free ring buffer and written to std::cout (std::cerr for warnings and
+// errors) by a background thread, so logging never blocks the calling thread. If the ring buffer is full, messages
+// are dropped and counted instead.
+// Repeated messages are only written once per second, followed by the number of repetitions.
+class Log {
+public:
+    enum class Level : std::uint8_t {
+        Debug,
+        Info,
+        Warning,
+        Error,
+    };
+
+    // Number of messages the ring buffer can hold before messages are dropped.
+    static constexpr std::uint32_t MessageCapacity = 1024;
+    // Longer messages are truncated.
+    static constexpr std::uint32_t MaxMessageLength = 1024;
+
+    // Collects a message with stream operators and pushes it to the log on destruction.
+    class Message {
+    public:
+        explicit Message(Level level);
+        ~Message();
+
+        Message(const Message&)            = delete;
+        Message& operator=(const Message&) = delete;
+
+        template <typename T>
+        Message& operator<<(const T& value)
+        {
+            if (enabled_) {
+                stream_ << value;
+            }
+            return *this;
+        }
+
+    private:
+        Level              level_;
+        bool               enabled_;
+        std::ostringstream stream_;
+    };
+
+    static Message Debug();
+    static Message Info();
+    static Message Warning();
+    static Message Error();
+
+    static void Write(Level level, std::string_view message);
+
+    // Messages below "level" are discarded. Default is Level::Info.
+    static void SetLevel(Level level);
+    static bool IsEnabled(Level level);
+    // Parses "debug", "info", "warning" or "error". Throws std::runtime_error for unknown levels.
+    static Level ParseLevel(std::string_view name);
+
+    // Blocks until all messages pushed so far are written.
+    static void Flush();
+};
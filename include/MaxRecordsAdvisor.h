@@ -0,0 +1,84 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// [MaxRecords(...)] declaration of a node output that is profiled with the maxrecords helpers in tutorials/Common.h.
+// Probes are declared with an annotation comment in front of the attribute:
+//   // @MaxRecordsProbe(<id>)
+//   [MaxRecords(<bound>)]
+struct MaxRecordsProbe {
+    std::uint32_t id;
+    // Node function and output parameter of the declaration
+    std::string   function;
+    std::string   output;
+    // Declared bound, zero if the expression could not be evaluated (e.g., uses a macro)
+    std::uint32_t declaredMaxRecords;
+    // Position of the bound expression in the shader source, see ApplyBounds
+    std::size_t   boundOffset;
+    std::size_t   boundLength;
+};
+
+// Recommendation for a single probe, see MaxRecordsAdvisor::WriteReport
+struct MaxRecordsAdvice {
+    MaxRecordsProbe probe;
+    // Peak number of records requested per thread group during profiling
+    std::uint32_t   peakRecords;
+    // Tightest bound that was sufficient for all profiled frames
+    std::uint32_t   suggestedMaxRecords;
+    // Backing memory saved if only this declaration uses its suggested bound, in bytes
+    std::int64_t    backingMemorySaving;
+};
+
+// Right-sizes [MaxRecords(...)] declarations from observed peaks. Backing memory of work graphs grows with the
+// declared bounds, which are often more conservative than required. Suggested bounds are only safe for inputs
+// similar to the profiled session (e.g., render size).
+class MaxRecordsAdvisor {
+public:
+    // Probe ids must be below this limit. Must be in sync with the MaxRecordsBuffer size in Application.h.
+    static constexpr std::uint32_t MaxProbeCount = 64;
+
+    // Reads "@MaxRecordsProbe(<id>)" annotations of shader source. Throws if a probe is invalid.
+    static std::vector<MaxRecordsProbe> ReadProbes(const std::string& source);
+
+    // Replaces the bound of every probe with "maxRecords" (indexed like "probes")
+    static std::string ApplyBounds(const std::string&                  source,
+                                   const std::vector<MaxRecordsProbe>& probes,
+                                   const std::vector<std::uint32_t>&   maxRecords);
+
+    // Tightest safe bound for the peak record count. MaxRecords must be at least one.
+    static std::uint32_t GetSuggestedMaxRecords(std::uint32_t peakRecords);
+
+    // Writes CSV table header for WriteReport
+    static void WriteReportHeader(std::ostream& stream);
+    // Writes one CSV row per probe
+    static void WriteReport(std::ostream&                        stream,
+                            const std::string&                   shaderFile,
+                            const std::vector<MaxRecordsAdvice>& advice);
+};
@@ -0,0 +1,78 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <span>
+#include <string>
+
+#include "Device.h"
+#include "ShaderCompiler.h"
+#include "WorkGraph.h"
+
+// Micro-benchmark of a single work graph node. The node is promoted to an entry point of its tutorial work graph
+// (see WorkGraph::EntryNode) and dispatched with synthetic input records from GPU memory.
+// Work launched through the outputs of the node is included in its timings, thus only leaf nodes (e.g.,
+// "MandelbrotFill" or "ShadePixel_Sphere") are measured in isolation.
+class NodeBenchmark {
+public:
+    // Writes input record "recordIndex" to "record"
+    using RecordGenerator = std::function<void(std::uint32_t recordIndex, std::span<std::byte> record)>;
+
+    // Parses comma separated list of 32-bit record fields, e.g. "8,8,index%64,0.5f". Each field is either
+    // - an integer constant (decimal or hexadecimal)
+    // - a float constant with a "f" suffix
+    // - "index" for the record index, or "index%N" for the record index modulo N
+    // - "random%N" for a random integer below N, which is the same for every run
+    // Fields beyond the record size are ignored. Missing fields are zero.
+    static RecordGenerator ParseRecordFields(const std::string& fields);
+    // Reads captured records from a binary file without padding between records.
+    // Records are repeated if the file contains fewer records than requested.
+    static RecordGenerator LoadRecordFile(const std::filesystem::path& path);
+
+    // Finds node in library by node ID (e.g., "MandelbrotFill" or "ShadePixel[1]") or by the name of its function
+    // (e.g., "ShadePixel_Sphere"). Throws if the library does not contain the node.
+    static WorkGraph::EntryNode FindNode(ShaderCompiler& shaderCompiler, IDxcBlob* library, const std::string& node);
+
+    // Creates GPU input (D3D12_NODE_GPU_INPUT followed by the records) for "recordCount" records of the entry node of
+    // "workGraph". Records are copied to GPU memory by "commandList".
+    // Records are split into batches of at most "maxBatchRecordCount" records (zero means a single batch), which are
+    // dispatched with separate DispatchGraph calls.
+    NodeBenchmark(const Device*              device,
+                  ID3D12GraphicsCommandList* commandList,
+                  const WorkGraph&           workGraph,
+                  std::uint32_t              recordCount,
+                  const RecordGenerator&     generator,
+                  std::uint32_t              maxBatchRecordCount = 0);
+
+    // Address and batch count for WorkGraph::SetGpuInput
+    D3D12_GPU_VIRTUAL_ADDRESS GetGpuInput() const;
+    std::uint32_t             GetBatchCount() const;
+
+private:
+    ComPtr<ID3D12Resource> uploadBuffer_;
+    ComPtr<ID3D12Resource> inputBuffer_;
+    std::uint32_t          batchCount_ = 1;
+};
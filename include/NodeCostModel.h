@@ -0,0 +1,76 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Static cost estimate of a single work graph node, derived from the DXIL disassembly of its library.
+struct NodeCost {
+    std::string   name;
+    std::uint32_t arrayIndex = 0;
+    std::string   launchType;
+    // Export name of node shader function, e.g. for node overrides
+    std::string   functionName;
+
+    std::array<std::uint32_t, 3> numThreads = {1, 1, 1};
+
+    // Worst-case number of thread groups (or threads for thread launch nodes) per graph dispatch,
+    // derived from dispatch grids, MaxRecords of all producers and recursion depth.
+    double invocations = 0;
+
+    // Instruction statistics of node function, including inlined helper functions
+    std::uint32_t instructions = 0;
+    std::uint32_t loops        = 0;
+    std::uint32_t uavWrites    = 0;
+    std::uint32_t typedWrites  = 0;
+    std::uint32_t atomics      = 0;
+    std::uint32_t barriers     = 0;
+    std::uint32_t outputCalls  = 0;
+
+    // Estimated cost of a single thread, with instructions in loops weighted by their trip count
+    double threadCost    = 0;
+    // Estimated cost of all invocations of this node per graph dispatch
+    double estimatedCost = 0;
+};
+
+// Estimates per-node cost without GPU timing. Costs are in relative units and are only meant to spot hotspots,
+// e.g. nodes with long loops or many memory operations, or nodes that are launched very often.
+class NodeCostModel {
+public:
+    // Trip count for loops without a constant bound
+    static constexpr double DefaultLoopTripCount = 8;
+
+    // Analyzes DXIL disassembly (see ShaderCompiler::Disassemble) of a work graph library.
+    // Nodes are sorted by descending estimated cost.
+    static std::vector<NodeCost> Analyze(const std::string& disassembly);
+
+    // Writes CSV table header for WriteReport
+    static void WriteReportHeader(std::ostream& stream);
+    // Writes one CSV row per node
+    static void WriteReport(std::ostream& stream, const std::string& shaderFile, const std::vector<NodeCost>& nodes);
+};
@@ -0,0 +1,55 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "ShaderCompiler.h"
+
+// Compiles every tutorial and sample solution under a matrix of compiler flags and reports compile time,
+// DXIL size, static per-node instruction counts (see NodeCostModel.h) and optionally GPU time of each variant.
+class OptimizationReport {
+public:
+    struct Variant {
+        std::string          name;
+        ShaderCompileOptions options;
+    };
+
+    // -O0 to -O3, with and without 16-bit types, each with default, flush-to-zero, preserved denormals and
+    // IEEE-strict floating point.
+    static std::vector<Variant> GetVariants();
+
+    // Returns GPU time in milliseconds of the work graph created from "library", or a negative value if the
+    // variant could not be measured.
+    using MeasureGpuTimeFunction =
+        std::function<double(std::uint32_t tutorialIndex, bool sampleSolution, ComPtr<IDxcBlob> library)>;
+
+    // Writes CSV report with one row per node and variant. GPU time is left empty if "measureGpuTime" is empty.
+    static void Write(const std::filesystem::path&  file,
+                      ShaderCompiler&               shaderCompiler,
+                      const MeasureGpuTimeFunction& measureGpuTime = {});
+};
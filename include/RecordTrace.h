@@ -0,0 +1,114 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Dynamic record trace of a single frame (see recordtrace namespace in tutorials/Common.h).
+// Instrumented nodes append one event per launched thread group (or thread) and one event per output request to a GPU
+// buffer, from which the dynamic execution tree of the frame is rebuilt.
+// This file does not depend on D3D12, such that captures can be analyzed offline (see tools/RecordTraceAnalyzer.cpp).
+
+// Event as written by recordtrace::BeginGroup and recordtrace::Output
+struct RecordTraceEvent {
+    // Node id (see @TraceNode annotations). RecordTrace::OutputFlag is set for output events.
+    std::uint32_t node;
+    // Group events: id of the group that emitted the input record. Output events: id of the emitting group.
+    // Group ids are the indices of group events.
+    std::uint32_t parentGroup;
+    std::uint32_t recordCount;
+    std::uint32_t recordBytes;
+};
+
+// Events of one frame as read back from the GPU
+struct RecordTraceCapture {
+    std::string   shaderFileName;
+    std::uint64_t frame = 0;
+    // Number of events appended by the GPU. Events beyond the capacity of the trace buffer are dropped.
+    std::uint64_t appendedEventCount = 0;
+
+    std::vector<RecordTraceEvent>        events;
+    std::map<std::uint32_t, std::string> nodeNames;
+};
+
+// Dynamic execution tree rebuilt from a capture
+struct RecordTraceTree {
+    // Records emitted by a group to one node
+    struct Output {
+        std::uint32_t node;
+        std::uint64_t recordCount;
+        std::uint64_t recordBytes;
+    };
+
+    struct Group {
+        std::uint32_t node;
+        // Index of parent group, RecordTrace::NoGroup for root groups
+        std::uint32_t parent;
+        // Root groups have depth zero
+        std::uint32_t depth;
+        // Input records
+        std::uint32_t recordCount;
+        std::uint32_t recordBytes;
+
+        std::vector<std::uint32_t> children;
+        std::vector<Output>        outputs;
+    };
+
+    std::vector<Group>         groups;
+    std::vector<std::uint32_t> roots;
+    // Output events of groups that were dropped, as the trace buffer was full
+    std::uint64_t              orphanedOutputCount = 0;
+};
+
+class RecordTrace {
+public:
+    // Layout of the trace buffer. Must be in sync with the recordtrace namespace in tutorials/Common.h
+    static constexpr std::uint32_t HeaderSize = 16;
+    static constexpr std::uint32_t OutputFlag = 0x80000000;
+    static constexpr std::uint32_t NoGroup    = 0xFFFFFFFF;
+
+    // Reads "@TraceNode(<id>, <name>)" annotations of a shader file. Included files are not searched.
+    static std::map<std::uint32_t, std::string> ReadNodeNames(const std::filesystem::path& shaderFile);
+
+    static RecordTraceTree BuildTree(const RecordTraceCapture& capture);
+
+    // Compact binary capture. File layout: header (magic, version, frame, event counts, node name count and shader file
+    // name size), followed by the shader file name, the node names (id, size, characters) and the events.
+    static void               WriteCapture(const std::filesystem::path& path, const RecordTraceCapture& capture);
+    static RecordTraceCapture ReadCapture(const std::filesystem::path& path);
+
+    // Writes execution tree as nested slices in Chrome trace JSON format, which can be opened with
+    // https://ui.perfetto.dev. Slices have no GPU timing, their width is the number of records in their subtree.
+    static void WritePerfettoJson(const std::filesystem::path& path,
+                                  const RecordTraceCapture&    capture,
+                                  const RecordTraceTree&       tree);
+    // Writes recursion depth and fan-out per node
+    static void WriteSummary(std::ostream& stream, const RecordTraceCapture& capture, const RecordTraceTree& tree);
+};
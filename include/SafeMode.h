@@ -0,0 +1,48 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+#include "Blob.h"
+
+// Last work graph that completed a dispatch on the GPU. It is stored after every work graph change, such that a
+// safe-mode restart after a GPU hang (see DeviceLostError) starts with this work graph instead of the shader that caused
+// the hang.
+// File layout: header (magic, version, tutorial index, sample solution, shader file name and library size), followed by
+// the shader file name and the DXIL library.
+struct LastGoodWorkGraph {
+    std::uint32_t    tutorialIndex;
+    bool             sampleSolution;
+    // Shader file of the library, to detect tutorials that were added or removed since the file was written
+    std::string      shaderFileName;
+    ComPtr<IDxcBlob> library;
+
+    void Save(const std::filesystem::path& path) const;
+    // Returns std::nullopt if the file does not exist or is not a valid last good work graph file.
+    static std::optional<LastGoodWorkGraph> Load(const std::filesystem::path& path);
+};
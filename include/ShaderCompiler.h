@@ -29,28 +29,129 @@
 #include <dxcapi.h>
 
 #include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
+
+class CompileClient;
+class ShaderPack;
+
+// Compiler flags that may be varied per compilation, e.g. to compare optimization levels.
+// Default values match the flags used for all tutorials.
+struct ShaderCompileOptions {
+    // -O0 to -O3. Negative value uses default optimization level of the compiler.
+    int          optimizationLevel = -1;
+    bool         enable16BitTypes  = true;
+    // -denorm value: "any", "preserve" or "ftz". Empty string uses default denormal mode.
+    std::wstring denormMode;
+    // -Gis: force IEEE strictness
+    bool         ieeeStrictness    = false;
+    // -Od: skip all optimizations. Used for fast preview builds.
+    bool         skipOptimizations = false;
+};
+
+struct ShaderCompileRequest {
+    // Absolute path of shader source file
+    std::filesystem::path sourceFile;
+    // Absolute path used to resolve #include directives
+    std::filesystem::path includeDirectory;
+
+    std::wstring              target;
+    std::wstring              entryPoint;
+    // Compiler arguments, except for the include path
+    std::vector<std::wstring> arguments;
+};
+
+struct ShaderSourceFile {
+    std::filesystem::path path;
+    // Hash of the file contents as seen by the compiler
+    std::uint64_t         contentHash;
+};
+
+struct ShaderCompileResult {
+    bool success = false;
+    // Errors & warnings reported by the compiler
+    std::string      messages;
+    ComPtr<IDxcBlob> blob;
+    // Source file and all included files
+    std::vector<ShaderSourceFile> sourceFiles;
+};
 
 class ShaderCompiler {
 public:
-    ShaderCompiler();
+    // If "useCompileServer" is set, shaders are compiled by a shared compile server process (see CompileServer.h),
+    // which is launched on demand. Falls back to compiling in-process if the server is not available.
+    // If "shaderPackFile" is set, compiled shaders are loaded from and appended to the given shader pack.
+    ShaderCompiler(bool useCompileServer = false, const std::filesystem::path& shaderPackFile = {});
+    ~ShaderCompiler();
+
+    ComPtr<IDxcBlob> CompileShader(const std::string&          shaderFile,
+                                   const wchar_t*              target,
+                                   const wchar_t*              entryPoint,
+                                   const ShaderCompileOptions& options = {});
+
+    // Returns shader from the shader pack if all its source files are unchanged, nullptr otherwise.
+    // Source files of found shaders are tracked for hot-reloading.
+    ComPtr<IDxcBlob> FindCompiledShader(const std::string&          shaderFile,
+                                        const wchar_t*              target,
+                                        const wchar_t*              entryPoint,
+                                        const ShaderCompileOptions& options = {});
 
-    ComPtr<IDxcBlob> CompileShader(const std::string& shaderFile, const wchar_t* target, const wchar_t* entryPoint);
+    // Compiles shader in this process. Unlike CompileShader, compile errors are returned in the result
+    // and source files are not tracked for hot-reloading.
+    ShaderCompileResult Compile(const ShaderCompileRequest& request);
+    // Compiles "source" instead of the contents of request.sourceFile, e.g. a modified copy of a shader file.
+    // request.sourceFile is still used as source name, such that includes are resolved as for the shader file.
+    ShaderCompileResult Compile(const ShaderCompileRequest& request, std::string_view source);
+
+    ShaderCompileRequest CreateCompileRequest(const std::string&          shaderFile,
+                                              const wchar_t*              target,
+                                              const wchar_t*              entryPoint,
+                                              const ShaderCompileOptions& options = {}) const;
+
+    // Returns absolute path of a shader file in the tutorials folder
+    std::filesystem::path GetShaderSourceFilePath(const std::string& shaderFile) const;
+
+    // Returns textual DXIL disassembly of a compiled shader
+    std::string Disassemble(IDxcBlob* blob);
+
+    // Hashes the parts of a DXIL container that affect execution. Debug info, debug names, source info and the
+    // shader hash are ignored, such that edits to comments or whitespace do not change the hash.
+    static std::uint64_t HashShaderCode(IDxcBlob* blob);
+
+    // Compiles all given shader files as libraries and replaces the shader pack with the results.
+    // Returns false if any shader failed to compile.
+    bool RebuildShaderPack(const std::vector<std::string>& shaderFiles);
+    // Removes replaced and outdated shaders from the shader pack
+    void CompactShaderPack();
 
     // Checks shader source files for updates/changes
     bool CheckShaderSourceFiles();
+    // Tracks shader file for hot-reloading without compiling it, e.g. for libraries that were not compiled from the
+    // current source file. Included files are not tracked.
+    void TrackShaderFile(const std::string& shaderFile);
 
 private:
-    friend class FileTrackingIncludeHandler;
+    // dxcompiler.dll is only loaded on the first in-process compilation
+    void LoadCompiler();
+
+    // Compiles "source" in-process, see Compile
+    ShaderCompileResult CompileSource(const ShaderCompileRequest& request, IDxcBlobEncoding* source);
+
+    // Compiles using the compile server, if available, or in-process
+    ShaderCompileResult CompileUncached(const ShaderCompileRequest& request);
+
+    void TrackSourceFiles(const std::vector<ShaderSourceFile>& sourceFiles);
 
-    std::filesystem::path GetShaderSourceFilePath(const std::string& shaderFile);
-    std::filesystem::path GetShaderSourceFilePath(const std::wstring& shaderFile);
+    ComPtr<IDxcUtils>    utils_;
+    ComPtr<IDxcCompiler> compiler_;
 
-    ComPtr<IDxcUtils>          utils_;
-    ComPtr<IDxcCompiler>       compiler_;
-    ComPtr<IDxcIncludeHandler> includeHandler_;
+    std::unique_ptr<CompileClient> compileClient_;
+    std::unique_ptr<ShaderPack>    shaderPack_;
 
     std::filesystem::path shaderFolderPath_;
 
     std::unordered_map<std::filesystem::path, std::filesystem::file_time_type> trackedFiles_;
-};
\ No newline at end of file
+};
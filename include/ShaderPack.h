@@ -0,0 +1,97 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include "ShaderCompiler.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Single-file pack of compiled shaders, which is memory-mapped to skip shader compilation on startup.
+//
+// File layout:
+//   Header
+//   Entry data: 64-byte aligned DXIL container, followed by the source files (paths & content hashes) it was built from
+//   Index:      one IndexEntry per shader, referenced by the header
+//
+// New entries are appended together with a new index, after which the header is updated to point to the new index.
+// Replaced entries and old indices remain in the file until it is compacted.
+// DXIL containers for libraries already include the runtime reflection data (RDAT) required by the D3D12 runtime.
+class ShaderPack {
+public:
+    // Maps pack file, if it exists
+    ShaderPack(const std::filesystem::path& path);
+    ~ShaderPack();
+
+    // Returns the packed compile result for "request", if all of its source files are unchanged.
+    // The returned blob references the mapped file and does not copy the DXIL.
+    bool Find(const ShaderCompileRequest& request, ShaderCompileResult& result) const;
+
+    // Appends successful compile result to the pack file.
+    void Append(const ShaderCompileRequest& request, const ShaderCompileResult& result);
+
+    // Replaces pack file with a new pack, that only contains the given results.
+    // Fails if the pack file is mapped by another process.
+    void Write(const std::vector<std::pair<ShaderCompileRequest, ShaderCompileResult>>& entries);
+
+    // Rewrites pack file without replaced entries, old indices and entries with changed source files.
+    // Fails if the pack file is mapped by another process.
+    void Compact(const std::filesystem::path& includeDirectory);
+
+private:
+    struct MappedFile;
+
+    // Entry to be written to a new pack file
+    struct PackEntry {
+        std::uint64_t             key;
+        const void*               data;
+        std::size_t               dataSize;
+        std::vector<std::uint8_t> sourceFiles;
+    };
+
+    struct IndexEntry {
+        std::uint64_t key;
+        std::uint64_t dataOffset;
+        std::uint64_t dataSize;
+        std::uint64_t sourceFilesOffset;
+        std::uint64_t sourceFilesSize;
+    };
+
+    // Maps current version of the pack file & reads its index
+    void Map();
+
+    // Writes new pack file and replaces the current pack file with it
+    void WritePackFile(const std::vector<PackEntry>& entries);
+
+    ShaderCompileResult ReadEntry(const IndexEntry& entry, const std::filesystem::path& includeDirectory) const;
+
+    std::filesystem::path path_;
+
+    // Shared with all blobs returned by Find, which keep the mapping alive after the pack was remapped
+    std::shared_ptr<const MappedFile>             mappedFile_;
+    std::unordered_map<std::uint64_t, IndexEntry> index_;
+};
@@ -0,0 +1,62 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+
+// Low-overhead CPU trace zones.
+// Every thread records its zones into its own fixed-size ring buffer, so recording a zone never takes a lock.
+// The recorded zones can be written to a Chrome trace JSON file, which can be opened with
+// chrome://tracing or https://ui.perfetto.dev.
+class Trace {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Number of zones each thread can hold before the oldest zones are overwritten.
+    static constexpr std::uint32_t ZonesPerThread = 64 * 1024;
+
+    // Records a zone from construction to destruction of the scope object.
+    // "name" must be a string literal (or otherwise outlive the trace), as only the pointer is stored.
+    class Scope {
+    public:
+        explicit Scope(const char* name);
+        ~Scope();
+
+        Scope(const Scope&)            = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char*       name_;
+        Clock::time_point start_;
+    };
+
+    // Sets a display name for the calling thread. "name" must outlive the trace.
+    static void SetThreadName(const char* name);
+
+    // Writes all recorded zones to "path" in Chrome trace JSON format.
+    // If "lastSeconds" is greater than zero, only zones which ended within the last "lastSeconds" seconds are written.
+    static void WriteChromeTrace(const std::filesystem::path& path, double lastSeconds = 0.0);
+};
@@ -39,11 +39,16 @@ public:
     std::uint32_t GetWidth() const;
     std::uint32_t GetHeight() const;
 
+    // Returns true while the user drags the window border or title bar.
+    bool IsResizing() const;
+
 private:
     HWND hwnd_ = NULL;
 
     std::uint32_t width_;
     std::uint32_t height_;
 
+    bool resizing_ = false;
+
     static LRESULT WINAPI MessageProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
 };
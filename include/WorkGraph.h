@@ -25,6 +25,7 @@
 
 #include <span>
 
+#include "DescriptorHeap.h"
 #include "Device.h"
 #include "ShaderCompiler.h"
 
@@ -35,25 +36,148 @@ public:
         std::string shaderFileName;
         // Filename for sample solution. Empty string means no solution is available.
         std::string solutionShaderFileName = "";
+        // Filename for classic compute baseline (see ComputeBaseline.h). Empty string means no baseline is available.
+        std::string baselineShaderFileName = "";
+    };
+
+    // Additional buffer or texture declared by a tutorial with an annotation comment in its shader file:
+    //   // @Buffer(u3, <size in bytes>)
+    //   // @Texture(u4, <width>, <height>)
+    // See tutorials/Common.h
+    struct ResourceDeclaration {
+        enum class Type {
+            Buffer,
+            Texture,
+        };
+
+        Type          type;
+        std::uint32_t registerIndex;
+        // Size in bytes for buffers, width in pixels for textures
+        std::uint64_t width;
+        std::uint32_t height;
+
+        bool operator==(const ResourceDeclaration&) const = default;
+    };
+
+    // Declared resources are bound to u3 - u10
+    static constexpr std::uint32_t FirstResourceRegister = 3;
+    static constexpr std::uint32_t MaxResourceCount      = 8;
+
+    // Stride between D3D12_NODE_GPU_INPUT of record batches, see SetGpuInput
+    static constexpr std::uint32_t GpuInputStride = 32;
+
+    // Node that is promoted to an entry point, e.g. for benchmarking a single node (see NodeBenchmark.h)
+    struct EntryNode {
+        std::string   name;
+        std::uint32_t arrayIndex = 0;
+        // Export name of node shader function
+        std::string   functionName;
     };
 
     WorkGraph(const Device*        device,
               ShaderCompiler&      shaderCompiler,
+              DescriptorHeap&      descriptorHeap,
               ID3D12RootSignature* rootSignature,
               std::uint32_t        tutorialIndex,
               bool                 sampleSolution);
+    // Creates work graph from an already compiled library of the given tutorial.
+    // "shaderCompiler" is only used to locate the shader file for resource declarations.
+    // If "entryNode" is set, it is dispatched instead of the "Entry" node.
+    WorkGraph(const Device*         device,
+              const ShaderCompiler& shaderCompiler,
+              DescriptorHeap&       descriptorHeap,
+              ComPtr<IDxcBlob>      library,
+              ID3D12RootSignature*  rootSignature,
+              std::uint32_t         tutorialIndex,
+              bool                  sampleSolution,
+              const EntryNode*      entryNode = nullptr);
+    ~WorkGraph();
 
     void Dispatch(ID3D12GraphicsCommandList10* commandList);
+    // Dispatches records described by D3D12_NODE_GPU_INPUT at "gpuInput" instead of a single empty record.
+    // Large record batches can be split into "batchCount" consecutive inputs with GpuInputStride bytes stride, which
+    // are dispatched with one DispatchGraph call each to bound the duration of a single call.
+    // Zero restores dispatching a single empty record.
+    void SetGpuInput(D3D12_GPU_VIRTUAL_ADDRESS gpuInput, std::uint32_t batchCount = 1);
+
+    std::uint32_t GetEntryPointIndex() const;
+    // Input record size of the dispatched entry node
+    std::uint32_t GetEntryRecordSize() const;
 
     std::uint32_t GetTutorialIndex() const;
     bool          IsSampleSolution() const;
+    // Size of backing memory in bytes
+    std::uint64_t GetBackingMemorySize() const;
+    // Valid backing memory sizes reported by the driver. MaxSizeInBytes is allocated by default.
+    const D3D12_WORK_GRAPH_MEMORY_REQUIREMENTS& GetMemoryRequirements() const;
+    // Replaces backing memory with a buffer of "size" bytes, rounded up to the next valid size and clamped to
+    // MinSizeInBytes and MaxSizeInBytes. The GPU must have finished all dispatches using the previous backing memory.
+    void          SetBackingMemorySize(const Device* device, std::uint64_t size);
+    // Sets D3D12_SET_WORK_GRAPH_FLAG_INITIALIZE for the next dispatch, e.g. to measure its cost
+    void          InitializeBackingMemory();
+    // Allocated size of declared resources in bytes
+    std::uint64_t GetResourceMemorySize() const;
+
+    // Compiled shader libraries of this work graph, e.g. for static analysis
+    std::span<const ComPtr<IDxcBlob>> GetLibraries() const;
+
+    std::span<const ResourceDeclaration> GetResourceDeclarations() const;
+    // Descriptor table with UAVs of declared resources for u3 - u10. Unused registers hold null descriptors.
+    D3D12_GPU_DESCRIPTOR_HANDLE          GetResourceDescriptorTable() const;
+
+    // Returns shader file of tutorial or its sample solution. Throws if the tutorial has no sample solution.
+    static std::string GetShaderFileName(std::uint32_t tutorialIndex, bool sampleSolution);
+    // Compiles shader file of tutorial as work graph library
+    static ComPtr<IDxcBlob> CompileLibrary(ShaderCompiler&             shaderCompiler,
+                                           std::uint32_t               tutorialIndex,
+                                           bool                        sampleSolution,
+                                           const ShaderCompileOptions& options = {});
+    // Returns up-to-date library from the shader pack, or nullptr if the library needs to be compiled
+    static ComPtr<IDxcBlob> FindCompiledLibrary(ShaderCompiler& shaderCompiler,
+                                                std::uint32_t   tutorialIndex,
+                                                bool            sampleSolution);
+    // Reads resource declarations from the shader file of tutorial. Throws if a declaration is invalid.
+    static std::vector<ResourceDeclaration> ReadResourceDeclarations(const ShaderCompiler& shaderCompiler,
+                                                                     std::uint32_t         tutorialIndex,
+                                                                     bool                  sampleSolution);
+    static std::vector<ResourceDeclaration> ReadResourceDeclarations(const ShaderCompiler& shaderCompiler,
+                                                                     const std::string&    shaderFileName);
+
+    // Creates zero-initialized resources for "declarations" and writes their UAVs to a descriptor table for u3 - u10.
+    // Returns the index of the first of MaxResourceCount descriptors allocated from "descriptorHeap".
+    static std::uint32_t CreateResources(const Device*                        device,
+                                         DescriptorHeap&                      descriptorHeap,
+                                         std::span<const ResourceDeclaration> declarations,
+                                         std::vector<ComPtr<ID3D12Resource>>& resources);
+    // Returns allocated size of "resources" in bytes
+    static std::uint64_t GetAllocationSize(const Device* device, std::span<const ComPtr<ID3D12Resource>> resources);
+    // Returns backing memory requirements of a work graph with all nodes of "library" without creating the work graph,
+    // i.e., without allocating backing memory or declared resources
+    static D3D12_WORK_GRAPH_MEMORY_REQUIREMENTS QueryMemoryRequirements(const Device*        device,
+                                                                        IDxcBlob*            library,
+                                                                        ID3D12RootSignature* rootSignature);
 
 private:
+    void CreateBackingMemory(const Device* device, std::uint64_t size);
+
     std::uint32_t tutorialIndex_;
     bool          sampleSolution_;
 
-    ComPtr<ID3D12StateObject> stateObject_;
-    ComPtr<ID3D12Resource>    backingMemory_;
-    D3D12_SET_PROGRAM_DESC    programDesc_ = {};
-    std::uint32_t             entryPointIndex_;
+    ComPtr<ID3D12StateObject>            stateObject_;
+    D3D12_WORK_GRAPH_MEMORY_REQUIREMENTS memoryRequirements_ = {};
+    ComPtr<ID3D12Resource>               backingMemory_;
+    D3D12_SET_PROGRAM_DESC               programDesc_ = {};
+    std::uint32_t                        entryPointIndex_;
+    std::uint32_t                        entryRecordSize_;
+    D3D12_GPU_VIRTUAL_ADDRESS            gpuInput_           = 0;
+    std::uint32_t                        gpuInputBatchCount_ = 1;
+
+    std::vector<ComPtr<IDxcBlob>> libraries_;
+
+    // Declared resources are zero-initialized on creation and persist for the lifetime of the work graph
+    std::vector<ResourceDeclaration>    resourceDeclarations_;
+    std::vector<ComPtr<ID3D12Resource>> resources_;
+    std::uint64_t                       resourceMemorySize_ = 0;
+    DescriptorHeap&                     descriptorHeap_;
+    std::uint32_t                       resourceDescriptorIndex_ = DescriptorHeap::InvalidIndex;
 };
\ No newline at end of file
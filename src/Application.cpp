@@ -27,11 +27,85 @@
 #include <backends/imgui_impl_win32.h>
 #include <imgui.h>
 
-#include <iostream>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
 #include <sstream>
 
+#include "GpuTimer.h"
+#include "Image.h"
+#include "Log.h"
+#include "NodeBenchmark.h"
+#include "OptimizationReport.h"
+#include "Trace.h"
+
+namespace {
+    // Render sizes for the "Render Size" menu and resolution sweeps
+    struct Resolution {
+        std::uint32_t width;
+        std::uint32_t height;
+        const char*   name;
+    };
+    constexpr std::array<Resolution, 6> Resolutions = {{
+        {640, 360, "640x360"},
+        {1280, 720, "1280x720 (720p)"},
+        {1920, 1080, "1920x1080 (1080p)"},
+        {2560, 1440, "2560x1440 (1440p)"},
+        {3840, 2160, "3840x2160 (4K)"},
+        {7680, 4320, "7680x4320 (8K)"},
+    }};
+
+    // Render targets are over-allocated to multiples of this size, such that they can be reused while resizing
+    constexpr std::uint32_t RenderTargetBucketSize = 256;
+
+    std::uint32_t GetRenderTargetBucketSize(std::uint32_t size)
+    {
+        return ((size + RenderTargetBucketSize - 1) / RenderTargetBucketSize) * RenderTargetBucketSize;
+    }
+
+    // Returns true if "resource" can hold width x height pixels and is at most one bucket larger than required
+    bool FitsRenderTargetBucket(ID3D12Resource* resource, std::uint32_t width, std::uint32_t height)
+    {
+        if (!resource) {
+            return false;
+        }
+
+        const auto desc = resource->GetDesc();
+
+        return (desc.Width >= width) && (desc.Height >= height) &&
+               (desc.Width <= GetRenderTargetBucketSize(width) + RenderTargetBucketSize) &&
+               (desc.Height <= GetRenderTargetBucketSize(height) + RenderTargetBucketSize);
+    }
+}  // namespace
+
 Application::Application(const Options& options)
+    : traceFile_(options.traceFile),
+      writeTraceOnExit_(options.writeTraceOnExit),
+      regressionTestOptions_(options.regressionTest),
+      optimizationReportFile_(options.optimizationReportFile),
+      resolutionSweepFile_(options.resolutionSweepFile),
+      nodeBenchmarkOptions_(options.nodeBenchmark),
+      baselineBenchmarkFile_(options.baselineBenchmarkFile),
+      backingMemorySweepOptions_(options.backingMemorySweep),
+      renderWidth_(options.renderWidth),
+      renderHeight_(options.renderHeight),
+      dispatchBudget_(options.dispatchBudget),
+      recordTraceOptions_(options.recordTrace),
+      maxRecordsReportFile_(options.maxRecords.reportFile),
+      maxRecordsProfiling_(options.maxRecords.profile),
+      lastGoodWorkGraphFile_(options.lastGoodWorkGraphFile),
+      shaderCompiler_(options.useCompileServer, options.shaderPackFile),
+      tieredCompilation_(options.tieredCompilation && !options.regressionTest.enabled &&
+                         options.optimizationReportFile.empty() && options.resolutionSweepFile.empty() &&
+                         options.nodeBenchmark.outputFile.empty() && options.baselineBenchmarkFile.empty() &&
+                         options.backingMemorySweep.outputFile.empty()),
+      optimizingShaderCompiler_(options.useCompileServer, options.shaderPackFile),
+      workGraphCacheSize_(options.workGraphCacheSize),
+      workGraphCacheMemoryLimit_(options.workGraphCacheMemoryLimit)
 {
+    Trace::SetThreadName("Main Thread");
+    const Trace::Scope traceScope("Application::Application");
+
     // Check if tutorials are available
     {
         const auto tutorials = GetTutorials();
@@ -41,15 +115,92 @@ Application::Application(const Options& options)
         }
     }
 
+    if (!options.recordInputFile.empty()) {
+        inputRecorder_ = std::make_unique<InputRecorder>(options.recordInputFile);
+    }
+    if (!options.replayInputFile.empty()) {
+        inputReplay_ = std::make_unique<InputReplay>(options.replayInputFile);
+
+        // Start with first recorded tutorial
+        if (inputReplay_->PeekFrame(replayFrame_) && (replayFrame_.tutorialIndex < GetTutorials().size())) {
+            workGraphTutorialIndex_     = replayFrame_.tutorialIndex;
+            workGraphUseSampleSolution_ = replayFrame_.sampleSolution != 0;
+        }
+    }
+
+    // Safe mode starts with the last work graph that completed on the GPU, e.g. after the current shader hung the GPU
+    ComPtr<IDxcBlob> lastGoodLibrary;
+    if (options.safeMode) {
+        const auto lastGood = LastGoodWorkGraph::Load(lastGoodWorkGraphFile_);
+
+        // Tutorials may have been added or removed since the last good work graph was stored
+        const auto isValid = [&]() {
+            if (!lastGood || (lastGood->tutorialIndex >= GetTutorials().size())) {
+                return false;
+            }
+
+            const auto& tutorial       = GetTutorials()[lastGood->tutorialIndex];
+            const auto& shaderFileName = lastGood->sampleSolution ? tutorial.solutionShaderFileName
+                                                                  : tutorial.shaderFileName;
+
+            return shaderFileName == lastGood->shaderFileName;
+        };
+
+        if (isValid()) {
+            workGraphTutorialIndex_     = lastGood->tutorialIndex;
+            workGraphUseSampleSolution_ = lastGood->sampleSolution;
+            lastGoodLibrary             = lastGood->library;
+
+            Log::Warning() << "Safe mode: starting with last good work graph of \"" << lastGood->shaderFileName
+                           << "\". Saving the shader file recompiles it.";
+        } else {
+            Log::Warning() << "Safe mode: no valid last good work graph in " << lastGoodWorkGraphFile_.string()
+                           << ", compiling tutorial.";
+        }
+    }
+
+    // Compile first work graph on a worker thread while the window and device are created.
+    // shaderCompiler_ is not used by this thread until the compilation is done.
+    const auto tutorialIndex  = workGraphTutorialIndex_;
+    const auto sampleSolution = workGraphUseSampleSolution_;
+
+    initialLibrary_ = std::async(std::launch::async, [this, tutorialIndex, sampleSolution, lastGoodLibrary]() {
+        Trace::SetThreadName("Initial Compiler");
+
+        if (lastGoodLibrary) {
+            // Library was not compiled from the current shader file, which is still watched for changes
+            shaderCompiler_.TrackShaderFile(WorkGraph::GetShaderFileName(tutorialIndex, sampleSolution));
+
+            // Optimized tier skips the background compilation, which would compile the current shader file
+            CompiledLibrary compiled = {
+                .library     = lastGoodLibrary,
+                .tier        = CompileTier::Optimized,
+                .libraryHash = ShaderCompiler::HashShaderCode(lastGoodLibrary.Get()),
+            };
+            compiled.resourceDeclarations =
+                WorkGraph::ReadResourceDeclarations(shaderCompiler_, tutorialIndex, sampleSolution);
+
+            return compiled;
+        }
+
+        return CompileWorkGraphLibrary(tutorialIndex, sampleSolution);
+    });
+
     window_ = std::make_unique<Window>(options.title, options.windowWidth, options.windowHeight);
     device_ =
-        std::make_unique<Device>(options.forceWarpAdapter, options.enableDebugLayer, options.enableGpuValidationLayer);
+        std::make_unique<Device>(options.forceWarpAdapter,
+                                 options.enableDebugLayer,
+                                 options.enableGpuValidationLayer,
+                                 options.adapterCacheFile,
+                                 options.benchmarkAdapters,
+                                 std::chrono::milliseconds(options.gpuTimeout));
     swapchain_ = std::make_unique<Swapchain>(device_.get(), window_.get());
 
     CreateResourceDescriptorHeaps();
-    CreateWritableBackbuffer(window_->GetWidth(), window_->GetHeight());
+    CreateWritableBackbuffer(GetRenderWidth(), GetRenderHeight());
     CreateScratchBuffer();
     CreatePersistentScratchBuffer();
+    CreateDispatchBudgetBuffer();
 
     CreateFontBuffer();
 
@@ -61,23 +212,114 @@ Application::Application(const Options& options)
 
 Application::~Application()
 {
+    // Background compilation uses optimizingShaderCompiler_
+    if (optimizedLibrary_.valid()) {
+        optimizedLibrary_.wait();
+    }
+
+    if (recordTraceWriter_.valid()) {
+        recordTraceWriter_.wait();
+    }
+
     DestroyImGuiContext();
+
+    if (writeTraceOnExit_) {
+        WriteTrace(0.0);
+    }
 }
 
 void Application::Run()
 {
+    if (regressionTestOptions_.enabled) {
+        RunRegressionTests();
+        return;
+    }
+    if (!optimizationReportFile_.empty()) {
+        RunOptimizationReport();
+        return;
+    }
+    if (!resolutionSweepFile_.empty()) {
+        RunResolutionSweep();
+        return;
+    }
+    if (!nodeBenchmarkOptions_.outputFile.empty()) {
+        RunNodeBenchmark();
+        return;
+    }
+    if (!baselineBenchmarkFile_.empty()) {
+        RunBaselineBenchmark();
+        return;
+    }
+    if (!backingMemorySweepOptions_.outputFile.empty()) {
+        RunBackingMemorySweep();
+        return;
+    }
+
     do {
-        // Check if resize is needed
-        if ((window_->GetWidth() != swapchain_->GetWidth()) ||  //
-            (window_->GetHeight() != swapchain_->GetHeight()))
+        const Trace::Scope frameTraceScope("Frame");
+
+        // Fetch next frame of input recording
+        if (inputReplay_) {
+            if (!inputReplay_->NextFrame(replayFrame_)) {
+                Log::Info() << "Input replay finished after " << inputReplay_->GetFrameCount() << " frames.";
+                break;
+            }
+
+            if (replayFrame_.tutorialIndex >= GetTutorials().size()) {
+                throw std::runtime_error("Input recording references unknown tutorial " +
+                                         std::to_string(replayFrame_.tutorialIndex) + ".");
+            }
+
+            // Switch to recorded tutorial
+            workGraphTutorialIndex_     = replayFrame_.tutorialIndex;
+            workGraphUseSampleSolution_ = replayFrame_.sampleSolution != 0;
+
+            if ((replayFrame_.width == 0) || (replayFrame_.height == 0) ||
+                (replayFrame_.width > D3D12_REQ_TEXTURE2D_U_OR_V_DIMENSION) ||
+                (replayFrame_.height > D3D12_REQ_TEXTURE2D_U_OR_V_DIMENSION))
+            {
+                throw std::runtime_error("Input recording uses invalid render size " +
+                                         std::to_string(replayFrame_.width) + "x" +
+                                         std::to_string(replayFrame_.height) + ".");
+            }
+
+            // Render offscreen at the recorded render size. Resizing the window is asynchronous and may be clamped by
+            // the OS, thus the first frames would render with a backbuffer of another size.
+            renderWidth_  = replayFrame_.width;
+            renderHeight_ = replayFrame_.height;
+        }
+
+        // Check if resize is needed. Resizing the swapchain waits for all frames in flight,
+        // thus it is deferred until the user stops dragging the window border.
+        if (!window_->IsResizing() &&
+            ((window_->GetWidth() != swapchain_->GetWidth()) || (window_->GetHeight() != swapchain_->GetHeight())))
         {
             // Resize swapchain
             OnResize(window_->GetWidth(), window_->GetHeight());
         }
 
+        // Check if render size changed, either by resizing the window or selecting another render size
+        if ((writableBackbufferWidth_ != GetRenderWidth()) || (writableBackbufferHeight_ != GetRenderHeight())) {
+            OnRenderSizeChanged(GetRenderWidth(), GetRenderHeight());
+        }
+
+        // Replayed frames must run the recorded workload
+        if (inputReplay_ &&
+            ((writableBackbufferWidth_ != replayFrame_.width) || (writableBackbufferHeight_ != replayFrame_.height)))
+        {
+            throw std::runtime_error("Failed to match render size to recorded render size " +
+                                     std::to_string(replayFrame_.width) + "x" + std::to_string(replayFrame_.height) +
+                                     ".");
+        }
+
         // Check if re-creation of work graph is required
         if (shaderCompiler_.CheckShaderSourceFiles()) {
-            std::cout << "Changes to shader source files detected. Recompiling work graph..." << std::endl;
+            Log::Info() << "Changes to shader source files detected. Recompiling work graph...";
+
+            // Cached work graphs, split screen and compute baseline may use any of the changed files. They are
+            // re-validated once they are used again, see shaderSourceGeneration_.
+            ++shaderSourceGeneration_;
+
             // Recompile shaders & re-create work graph
             const bool success = CreateWorkGraph();
 
@@ -95,11 +337,8 @@ void Application::Run()
         if ((workGraph_->GetTutorialIndex() != workGraphTutorialIndex_) ||
             (workGraph_->IsSampleSolution() != workGraphUseSampleSolution_))
         {
-            std::cout << "Compiling ";
-            if (workGraphUseSampleSolution_) {
-                std::cout << "sample solution ";
-            }
-            std::cout << "work graph for tutorial " << workGraphTutorialIndex_ << "... " << std::endl;
+            Log::Info() << "Compiling " << (workGraphUseSampleSolution_ ? "sample solution " : "")
+                        << "work graph for tutorial " << workGraphTutorialIndex_ << "... ";
 
             // Try to compile work graph for new tutorial
             const auto success = CreateWorkGraph();
@@ -122,14 +361,22 @@ void Application::Run()
             }
         }
 
+        SwapOptimizedWorkGraph();
+        UpdateSplitScreenWorkGraph();
+        UpdateComputeBaseline();
+
         // Advance to next command buffer
         auto*      commandList  = device_->GetNextFrameCommandList();
         const auto renderTarget = swapchain_->GetNextRenderTarget();
 
         // Advance ImGui to next frame
-        ImGui_ImplDX12_NewFrame();
-        ImGui_ImplWin32_NewFrame();
-        ImGui::NewFrame();
+        {
+            const Trace::Scope traceScope("ImGui::NewFrame");
+
+            ImGui_ImplDX12_NewFrame();
+            ImGui_ImplWin32_NewFrame();
+            ImGui::NewFrame();
+        }
 
         // Transition render target to RENDER_TARGET state
         {
@@ -153,9 +400,274 @@ void Application::Run()
         device_->ExecuteCurrentFrameCommandList();
         // Present frame
         swapchain_->Present(vsync_);
-    } while (window_->HandleEvents());
 
+        if (!firstFramePresented_) {
+            firstFramePresented_ = true;
+
+            const auto timeToFirstFrame = std::chrono::high_resolution_clock::now() - launchTime_;
+
+            Log::Info() << "Time to first frame: " << std::fixed << std::setprecision(1)
+                        << std::chrono::duration<double, std::milli>(timeToFirstFrame).count()
+                        << "ms (initial compile: "
+                        << std::chrono::duration<double, std::milli>(initialCompileTime_).count()
+                        << "ms, overlapped with device creation)";
+        }
+    } while (HandleWindowEvents());
+
+    // Wait for all frames in flight, which also releases all deferred resources before shutdown
     device_->WaitForDevice();
+
+    if (maxRecordsProfiling_) {
+        // All frames completed, thus every readback slot holds its final peaks
+        for (std::uint32_t frameIndex = 0; frameIndex < Device::BufferedFramesCount; ++frameIndex) {
+            MergeMaxRecordsPeaks(frameIndex);
+        }
+
+        WriteMaxRecordsReport();
+    }
+}
+
+void Application::RunRegressionTests()
+{
+    // Fixed render sizes and times at which every tutorial and sample solution is rendered
+    struct RegressionCase {
+        std::uint32_t width;
+        std::uint32_t height;
+        float         time;
+    };
+    static constexpr std::array<RegressionCase, 3> RegressionCases = {{
+        {1280, 720, 0.0f},
+        {1280, 720, 2.5f},
+        {1920, 1080, 2.5f},
+    }};
+    // Each case is rendered multiple times. The median GPU time is reported and the last frame is compared.
+    static constexpr std::uint32_t FramesPerCase = 9;
+    // Per-channel difference (0..255) below which pixels are considered equal
+    static constexpr std::uint32_t ChannelTolerance = 2;
+    // Ratio of different pixels below which an image still matches the golden image
+    static constexpr double MaxDifferentPixelRatio = 0.001;
+
+    const auto& goldenDirectory = regressionTestOptions_.goldenImageDirectory;
+    std::filesystem::create_directories(goldenDirectory);
+
+    std::ofstream report(goldenDirectory / "report.csv", std::ios::trunc);
+    report << "shader,width,height,time,gpu_ms,different_pixels,max_channel_difference,result\n";
+
+    GpuTimer gpuTimer(device_->GetDevice(), device_->GetCommandQueue(), 1, 1);
+
+    // Readback buffer for writable backbuffer, sized for the largest case
+    ComPtr<ID3D12Resource> readbackBuffer;
+    {
+        std::uint64_t bufferSize = 0;
+        for (const auto& regressionCase : RegressionCases) {
+            // Rows are padded to D3D12_TEXTURE_DATA_PITCH_ALIGNMENT, which adds at most one alignment per row
+            const auto rowPitch = regressionCase.width * 4 + D3D12_TEXTURE_DATA_PITCH_ALIGNMENT;
+            bufferSize          = std::max(bufferSize, std::uint64_t(rowPitch) * regressionCase.height);
+        }
+
+        CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_READBACK);
+        CD3DX12_RESOURCE_DESC   resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(bufferSize);
+        ThrowIfFailed(device_->GetDevice()->CreateCommittedResource(&heapProperties,
+                                                                    D3D12_HEAP_FLAG_NONE,
+                                                                    &resourceDesc,
+                                                                    D3D12_RESOURCE_STATE_COPY_DEST,
+                                                                    nullptr,
+                                                                    IID_PPV_ARGS(&readbackBuffer)));
+    }
+
+    std::uint32_t failedCount = 0;
+    std::uint32_t passedCount = 0;
+
+    const auto tutorials = GetTutorials();
+
+    for (std::uint32_t tutorialIndex = 0; tutorialIndex < tutorials.size(); ++tutorialIndex) {
+        const auto& tutorial = tutorials[tutorialIndex];
+
+        // Images of the tutorial, to compare against the sample solution
+        std::array<Image, RegressionCases.size()> tutorialImages;
+
+        for (const bool sampleSolution : {false, true}) {
+            const auto& shaderFileName = sampleSolution ? tutorial.solutionShaderFileName : tutorial.shaderFileName;
+
+            if (shaderFileName.empty()) {
+                continue;
+            }
+
+            std::unique_ptr<WorkGraph> workGraph;
+
+            try {
+                workGraph = std::make_unique<WorkGraph>(device_.get(),
+                                                        shaderCompiler_,
+                                                        *descriptorHeap_,
+                                                        workGraphRootSignature_.Get(),
+                                                        tutorialIndex,
+                                                        sampleSolution);
+            } catch (const std::exception& e) {
+                Log::Error() << "[FAIL] " << shaderFileName << ": " << e.what();
+                report << shaderFileName << ",,,,,,,compile error\n";
+                failedCount++;
+                continue;
+            }
+
+            for (std::size_t caseIndex = 0; caseIndex < RegressionCases.size(); ++caseIndex) {
+                const auto& regressionCase = RegressionCases[caseIndex];
+
+                // Resize offscreen target if required
+                if ((writableBackbufferWidth_ != regressionCase.width) ||
+                    (writableBackbufferHeight_ != regressionCase.height))
+                {
+                    CreateWritableBackbuffer(regressionCase.width, regressionCase.height);
+                }
+
+                const InputFrame input = {
+                    .width          = regressionCase.width,
+                    .height         = regressionCase.height,
+                    .mouseX         = regressionCase.width / 2.f,
+                    .mouseY         = regressionCase.height / 2.f,
+                    .inputState     = 0,
+                    .time           = regressionCase.time,
+                    .tutorialIndex  = tutorialIndex,
+                    .sampleSolution = sampleSolution,
+                };
+
+                // Writable backbuffer may be over-allocated, only read back the rendered region
+                D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint = {};
+                {
+                    auto desc   = writableBackbuffer_->GetDesc();
+                    desc.Width  = regressionCase.width;
+                    desc.Height = regressionCase.height;
+                    device_->GetDevice()->GetCopyableFootprints(&desc, 0, 1, 0, &footprint, nullptr, nullptr, nullptr);
+                }
+
+                // Every case starts with cleared persistent state
+                clearPersistentScratchBuffer_ = true;
+
+                std::vector<double> gpuTimes;
+
+                for (std::uint32_t frame = 0; frame < FramesPerCase; ++frame) {
+                    auto* commandList = device_->GetNextFrameCommandList();
+                    gpuTimer.BeginFrame(0);
+
+                    ClearShaderResources(commandList);
+                    BindShaderResources(commandList, input, *workGraph);
+
+                    gpuTimer.Begin(commandList, 0);
+                    workGraph->Dispatch(commandList);
+                    gpuTimer.End(commandList, 0);
+                    gpuTimer.EndFrame(commandList);
+
+                    // Copy last frame to readback buffer
+                    if (frame == FramesPerCase - 1) {
+                        const auto preBarrier =
+                            CD3DX12_RESOURCE_BARRIER::Transition(writableBackbuffer_.Get(),
+                                                                 D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+                                                                 D3D12_RESOURCE_STATE_COPY_SOURCE);
+                        commandList->ResourceBarrier(1, &preBarrier);
+
+                        const CD3DX12_TEXTURE_COPY_LOCATION sourceLocation(writableBackbuffer_.Get(), 0);
+                        const CD3DX12_TEXTURE_COPY_LOCATION destLocation(readbackBuffer.Get(), footprint);
+                        const CD3DX12_BOX                   sourceBox(
+                            0, 0, regressionCase.width, regressionCase.height);
+                        commandList->CopyTextureRegion(&destLocation, 0, 0, 0, &sourceLocation, &sourceBox);
+
+                        const auto postBarrier =
+                            CD3DX12_RESOURCE_BARRIER::Transition(writableBackbuffer_.Get(),
+                                                                 D3D12_RESOURCE_STATE_COPY_SOURCE,
+                                                                 D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+                        commandList->ResourceBarrier(1, &postBarrier);
+                    }
+
+                    device_->ExecuteCurrentFrameCommandList();
+                    device_->WaitForDevice();
+
+                    gpuTimer.CollectResults(0);
+                    gpuTimes.push_back(gpuTimer.GetMilliseconds(0));
+                }
+
+                std::ranges::sort(gpuTimes);
+                const auto gpuTime = gpuTimes[gpuTimes.size() / 2];
+
+                // Convert RGBA readback data to RGB image
+                Image image(regressionCase.width, regressionCase.height);
+                {
+                    void* mappedData;
+                    ThrowIfFailed(readbackBuffer->Map(0, nullptr, &mappedData));
+
+                    for (std::uint32_t y = 0; y < image.GetHeight(); ++y) {
+                        const auto* row = static_cast<const std::uint8_t*>(mappedData) + footprint.Offset +
+                                          std::uint64_t(y) * footprint.Footprint.RowPitch;
+
+                        for (std::uint32_t x = 0; x < image.GetWidth(); ++x) {
+                            for (std::uint32_t channel = 0; channel < 3; ++channel) {
+                                image.GetData()[(std::uint64_t(y) * image.GetWidth() + x) * 3 + channel] =
+                                    row[x * 4 + channel];
+                            }
+                        }
+                    }
+
+                    const D3D12_RANGE writeRange = {0, 0};
+                    readbackBuffer->Unmap(0, &writeRange);
+                }
+
+                std::stringstream goldenFileName;
+                goldenFileName << std::filesystem::path(shaderFileName).replace_extension("").generic_string() << "_"
+                               << regressionCase.width << "x" << regressionCase.height << "_t" << std::fixed
+                               << std::setprecision(2) << regressionCase.time << ".ppm";
+                const auto goldenFile = goldenDirectory / goldenFileName.str();
+
+                Image::Difference difference = {};
+                std::string       result;
+
+                if (regressionTestOptions_.updateGoldenImages) {
+                    image.Save(goldenFile);
+                    result = "updated";
+                } else if (!std::filesystem::exists(goldenFile)) {
+                    result = "missing golden";
+                } else {
+                    const auto golden = Image::Load(goldenFile);
+
+                    if ((golden.GetWidth() != image.GetWidth()) || (golden.GetHeight() != image.GetHeight())) {
+                        result = "size mismatch";
+                    } else {
+                        difference = Image::Compare(image, golden, ChannelTolerance);
+                        result     = (difference.differentPixels <= MaxDifferentPixelRatio * image.GetPixelCount())
+                                         ? "pass"
+                                         : "fail";
+                    }
+                }
+
+                const bool passed = (result == "pass") || (result == "updated");
+                (passed ? passedCount : failedCount)++;
+
+                {
+                    auto message = Log::Info();
+                    message << (passed ? "[PASS] " : "[FAIL] ") << goldenFileName.str() << ": " << result << ", "
+                            << difference.differentPixels << " different pixels, GPU time " << std::fixed
+                            << std::setprecision(3) << gpuTime << "ms";
+
+                    // Compare solution against tutorial for reference
+                    if (sampleSolution && (tutorialImages[caseIndex].GetPixelCount() == image.GetPixelCount())) {
+                        const auto solutionDifference =
+                            Image::Compare(image, tutorialImages[caseIndex], ChannelTolerance);
+                        message << ", " << solutionDifference.differentPixels << " pixels differ from tutorial";
+                    } else if (!sampleSolution) {
+                        tutorialImages[caseIndex] = image;
+                    }
+                }
+
+                report << shaderFileName << "," << regressionCase.width << "," << regressionCase.height << ","
+                       << regressionCase.time << "," << gpuTime << "," << difference.differentPixels << ","
+                       << difference.maxChannelDifference << "," << result << "\n";
+            }
+        }
+    }
+
+    Log::Info() << passedCount << " regression tests passed, " << failedCount << " failed.";
+
+    if (failedCount > 0) {
+        throw std::runtime_error(std::to_string(failedCount) + " regression tests failed. See " +
+                                 (goldenDirectory / "report.csv").string() + " for details.");
+    }
 }
 
 std::span<const WorkGraph::WorkGraphTutorial> Application::GetTutorials()
@@ -172,8 +684,8 @@ std::span<const WorkGraph::WorkGraphTutorial> Application::GetTutorials()
             if (path.extension() != ".hlsl") {
                 continue;
             }
-            // Ignore solution
-            if (path.stem().string().ends_with("Solution")) {
+            // Ignore solution and compute baseline
+            if (path.stem().string().ends_with("Solution") || path.stem().string().ends_with("Baseline")) {
                 continue;
             }
 
@@ -215,6 +727,13 @@ std::span<const WorkGraph::WorkGraphTutorial> Application::GetTutorials()
                     std::filesystem::relative(solutionFilename, shaderFolder).generic_string();
             }
 
+            const auto baselineFilename = path.parent_path() / (stem + "Baseline.hlsl");
+
+            if (std::filesystem::exists(baselineFilename)) {
+                tutorial.baselineShaderFileName =
+                    std::filesystem::relative(baselineFilename, shaderFolder).generic_string();
+            }
+
             result.emplace_back(tutorial);
         }
 
@@ -226,326 +745,2098 @@ std::span<const WorkGraph::WorkGraphTutorial> Application::GetTutorials()
     return tutorials;
 }
 
-void Application::OnRender(ID3D12GraphicsCommandList10* commandList, const Swapchain::RenderTarget& renderTarget)
+bool Application::HandleWindowEvents()
 {
-    // Clear shader resources (writable backbuffer & scratch buffer)
-    ClearShaderResources(commandList);
+    const Trace::Scope traceScope("Window::HandleEvents");
 
-    // Set root signature for parameters
-    commandList->SetComputeRootSignature(workGraphRootSignature_.Get());
+    return window_->HandleEvents();
+}
 
-    struct RootConstants {
-        unsigned width, height;
-        float    mouseX, mouseY;
-        unsigned inputState;
-        float    time;
+void Application::RunOptimizationReport()
+{
+    const auto MeasureGpuTime = [&](std::uint32_t tutorialIndex, bool sampleSolution, ComPtr<IDxcBlob> library) {
+        WorkGraph workGraph(device_.get(),
+                            shaderCompiler_,
+                            *descriptorHeap_,
+                            library,
+                            workGraphRootSignature_.Get(),
+                            tutorialIndex,
+                            sampleSolution);
+
+        const InputFrame input = MakeBenchmarkInput(tutorialIndex, sampleSolution);
+
+        return MeasureDispatchTime(workGraph, input, BenchmarkFrameCount);
     };
 
-    const auto& mousePos = ImGui::GetMousePos();
+    OptimizationReport::Write(optimizationReportFile_, shaderCompiler_, MeasureGpuTime);
+}
 
-    RootConstants constants = {
-        .width      = window_->GetWidth(),
-        .height     = window_->GetHeight(),
-        .mouseX     = mousePos.x,
-        .mouseY     = mousePos.y,
-        .inputState = 0,
-        .time = std::chrono::duration_cast<std::chrono::duration<float>>(std::chrono::high_resolution_clock::now() -
-                                                                         startTime_)
-                    .count(),
-    };
+void Application::RunResolutionSweep()
+{
+    std::ofstream report(resolutionSweepFile_, std::ios::trunc);
 
-    // Compute input state
-    constants.inputState |= ImGui::IsMouseDown(ImGuiMouseButton_Left) << 0U;
-    constants.inputState |= ImGui::IsMouseDown(ImGuiMouseButton_Middle) << 1U;
-    constants.inputState |= ImGui::IsMouseDown(ImGuiMouseButton_Right) << 2U;
-    constants.inputState |= ImGui::IsKeyDown(ImGuiKey_Space) << 3U;
-    constants.inputState |= ImGui::IsKeyDown(ImGuiKey_UpArrow) << 4U;
-    constants.inputState |= ImGui::IsKeyDown(ImGuiKey_LeftArrow) << 5U;
-    constants.inputState |= ImGui::IsKeyDown(ImGuiKey_DownArrow) << 6U;
-    constants.inputState |= ImGui::IsKeyDown(ImGuiKey_RightArrow) << 7U;
-    constants.inputState |= ImGui::IsKeyDown(ImGuiKey_W) << 8U;
-    constants.inputState |= ImGui::IsKeyDown(ImGuiKey_A) << 9U;
-    constants.inputState |= ImGui::IsKeyDown(ImGuiKey_S) << 10U;
-    constants.inputState |= ImGui::IsKeyDown(ImGuiKey_D) << 11U;
+    if (!report) {
+        throw std::runtime_error("Failed to open resolution sweep file \"" + resolutionSweepFile_.string() + "\"");
+    }
 
-    // Set root constants
-    commandList->SetComputeRoot32BitConstants(0, 6, &constants, 0);
+    report << "shader,width,height,pixels,gpu_ms,ns_per_pixel\n";
 
-    // Set font buffer
-    commandList->SetComputeRootShaderResourceView(1, fontBuffer_->GetGPUVirtualAddress());
+    const auto tutorials = GetTutorials();
 
-    // Set descriptor heap & table
-    commandList->SetDescriptorHeaps(1, resourceDescriptorHeap_.GetAddressOf());
-    commandList->SetComputeRootDescriptorTable(2, resourceDescriptorHeap_->GetGPUDescriptorHandleForHeapStart());
+    for (std::uint32_t tutorialIndex = 0; tutorialIndex < tutorials.size(); ++tutorialIndex) {
+        const auto& tutorial = tutorials[tutorialIndex];
 
-    workGraph_->Dispatch(commandList);
+        for (const bool sampleSolution : {false, true}) {
+            const auto& shaderFileName = sampleSolution ? tutorial.solutionShaderFileName : tutorial.shaderFileName;
 
-    // Copy writable backbuffer to render target
-    {
-        std::array<D3D12_RESOURCE_BARRIER, 2> preBarriers = {
-            CD3DX12_RESOURCE_BARRIER::Transition(
-                writableBackbuffer_.Get(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE),
-            CD3DX12_RESOURCE_BARRIER::Transition(
-                renderTarget.colorResource.Get(), D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_COPY_DEST),
-        };
-        commandList->ResourceBarrier(preBarriers.size(), preBarriers.data());
+            if (shaderFileName.empty()) {
+                continue;
+            }
 
-        const D3D12_TEXTURE_COPY_LOCATION sourceLocation = {
-            .pResource        = writableBackbuffer_.Get(),
-            .Type             = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX,
-            .SubresourceIndex = 0,
-        };
-        const D3D12_TEXTURE_COPY_LOCATION destLocation = {
-            .pResource        = renderTarget.colorResource.Get(),
-            .Type             = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX,
-            .SubresourceIndex = 0,
-        };
+            std::unique_ptr<WorkGraph> workGraph;
+            try {
+                workGraph = std::make_unique<WorkGraph>(device_.get(),
+                                                        shaderCompiler_,
+                                                        *descriptorHeap_,
+                                                        workGraphRootSignature_.Get(),
+                                                        tutorialIndex,
+                                                        sampleSolution);
+            } catch (const std::exception& e) {
+                Log::Error() << e.what();
+                continue;
+            }
 
-        commandList->CopyTextureRegion(&destLocation, 0, 0, 0, &sourceLocation, nullptr);
+            for (const auto& resolution : Resolutions) {
+                CreateWritableBackbuffer(resolution.width, resolution.height);
 
-        std::array<D3D12_RESOURCE_BARRIER, 2> postBarriers = {
-            CD3DX12_RESOURCE_BARRIER::Transition(
-                writableBackbuffer_.Get(), D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_UNORDERED_ACCESS),
-            CD3DX12_RESOURCE_BARRIER::Transition(
-                renderTarget.colorResource.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_RENDER_TARGET),
-        };
-        commandList->ResourceBarrier(postBarriers.size(), postBarriers.data());
+                const InputFrame input = MakeBenchmarkInput(tutorialIndex, sampleSolution);
+
+                const auto gpuTime    = MeasureDispatchTime(*workGraph, input, BenchmarkFrameCount);
+                const auto pixelCount = std::uint64_t(resolution.width) * resolution.height;
+
+                report << shaderFileName << ',' << resolution.width << ',' << resolution.height << ',' << pixelCount
+                       << ',' << gpuTime << ',' << gpuTime * 1e6 / pixelCount << '\n';
+
+                Log::Info() << shaderFileName << " [" << resolution.width << "x" << resolution.height
+                            << "]: " << std::fixed << std::setprecision(3) << gpuTime << "ms";
+            }
+        }
     }
+
+    Log::Info() << "Resolution sweep written to " << resolutionSweepFile_.string();
 }
 
-void Application::OnRenderUserInterface(ID3D12GraphicsCommandList10*   commandList,
-                                        const Swapchain::RenderTarget& renderTarget)
+void Application::RunNodeBenchmark()
 {
-    const auto tutorials = GetTutorials();
+    const auto& options = nodeBenchmarkOptions_;
 
-    ImGui::PushStyleColor(ImGuiCol_MenuBarBg, ImVec4(0.0f, 0.0f, 0.0f, 0.4f));
-    ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0.0f, 0.0f, 0.0f, 0.4f));
-    ImGui::BeginMainMenuBar();
+    if (options.tutorialIndex >= GetTutorials().size()) {
+        throw std::runtime_error("Node benchmark references unknown tutorial " +
+                                 std::to_string(options.tutorialIndex) + ".");
+    }
 
-    if (ImGui::BeginMenu("Tutorials")) {
-        for (std::uint32_t tutorialIndex = 0; tutorialIndex < tutorials.size(); ++tutorialIndex) {
-            const auto& tutorial = tutorials[tutorialIndex];
+    const auto shaderFileName = WorkGraph::GetShaderFileName(options.tutorialIndex, options.sampleSolution);
 
-            if (ImGui::MenuItem(tutorial.name.c_str(), nullptr, tutorialIndex == workGraphTutorialIndex_)) {
-                workGraphTutorialIndex_     = tutorialIndex;
-                // Reset sample solution
-                workGraphUseSampleSolution_ = false;
-            }
-        }
+    const auto library   = WorkGraph::CompileLibrary(shaderCompiler_, options.tutorialIndex, options.sampleSolution);
+    const auto entryNode = NodeBenchmark::FindNode(shaderCompiler_, library.Get(), options.node);
 
-        ImGui::EndMenu();
-    }
+    WorkGraph workGraph(device_.get(),
+                        shaderCompiler_,
+                        *descriptorHeap_,
+                        library,
+                        workGraphRootSignature_.Get(),
+                        options.tutorialIndex,
+                        options.sampleSolution,
+                        &entryNode);
 
-    if (!tutorials[workGraphTutorialIndex_].solutionShaderFileName.empty()) {
-        ImGui::Text("|");
-        ImGui::Checkbox("Sample Solution", &workGraphUseSampleSolution_);
+    const auto generator = options.recordFile.empty() ? NodeBenchmark::ParseRecordFields(options.recordFields)
+                                                      : NodeBenchmark::LoadRecordFile(options.recordFile);
+
+    std::ofstream report(options.outputFile, std::ios::trunc);
+
+    if (!report) {
+        throw std::runtime_error("Failed to open node benchmark file \"" + options.outputFile.string() + "\"");
     }
 
-    ImGui::Text("|");
-    ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1, 0.5, 0, 1));
-    ImGui::Text("Open tutorials/%s to start this tutorial.", tutorials[workGraphTutorialIndex_].shaderFileName.c_str());
-    ImGui::PopStyleColor();
+    report << "shader,node,record_count,batch_count,gpu_ms,records_per_ms\n";
 
-    // Print current FPS to menu bar
-    {
-        const auto& io                = ImGui::GetIO();
-        const auto  frametimeTextSize = ImGui::CalcTextSize("Frametime: XXXXXms (XXXX FPS)");
-        const auto  vsyncTextSize     = ImGui::CalcTextSize("V-Sync");
-        const auto  checkboxWidth     = ImGui::GetFrameHeight();
-        const auto  padding           = 20;
+    const InputFrame input = MakeBenchmarkInput(options.tutorialIndex, options.sampleSolution);
 
-        ImGui::SetCursorPosX(ImGui::GetCursorPosX() + ImGui::GetContentRegionAvail().x -
-                             (frametimeTextSize.x + vsyncTextSize.x + checkboxWidth + padding));
-        ImGui::Checkbox("V-Sync", &vsync_);
+    const auto nodeId = entryNode.name + "[" + std::to_string(entryNode.arrayIndex) + "]";
 
-        ImGui::SetCursorPosX(ImGui::GetCursorPosX() + ImGui::GetContentRegionAvail().x - frametimeTextSize.x);
-        ImGui::Text("Frametime: %5.1fms (%4.0f FPS)", io.DeltaTime * 1000.f, io.Framerate);
-    }
+    for (const auto recordCount : options.recordCounts) {
+        // Upload records once, all frames dispatch the same input
+        auto* commandList = device_->GetNextFrameCommandList();
+        const NodeBenchmark benchmark(
+            device_.get(), commandList, workGraph, recordCount, generator, options.maxBatchRecordCount);
+        device_->ExecuteCurrentFrameCommandList();
+        device_->WaitForDevice();
 
-    ImGui::EndMainMenuBar();
-    ImGui::PopStyleColor(2);
+        workGraph.SetGpuInput(benchmark.GetGpuInput(), benchmark.GetBatchCount());
 
-    // Compilation error message window
-    if (errorMessageEndTime_ >= std::chrono::high_resolution_clock::now()) {
-        ImGui::SetNextWindowPos(
-            ImVec2(window_->GetWidth() / 2, window_->GetHeight() - 20), ImGuiCond_Always, ImVec2(0.5, 1));
+        const auto gpuTime = MeasureDispatchTime(workGraph, input, BenchmarkFrameCount);
 
-        if (ImGui::Begin("error",
-                         nullptr,
-                         ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoInputs))
-        {
-            ImGui::Text("Work Graph compilation failed. Check output for more details.");
-        }
+        report << shaderFileName << ',' << nodeId << ',' << recordCount << ',' << benchmark.GetBatchCount() << ','
+               << gpuTime << ',' << recordCount / gpuTime << '\n';
 
-        ImGui::End();
+        Log::Info() << shaderFileName << " " << nodeId << " [" << recordCount << " records]: " << std::fixed
+                    << std::setprecision(3) << gpuTime << "ms";
     }
 
-    // Info window
-    {
-        ImGui::SetNextWindowPos(ImVec2(0, window_->GetHeight()), ImGuiCond_Always, ImVec2(0, 1));
+    Log::Info() << "Node benchmark written to " << options.outputFile.string();
+}
 
-        if (ImGui::Begin("info",
-                         nullptr,
-                         ImGuiWindowFlags_NoBackground | ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoDecoration |
-                             ImGuiWindowFlags_NoInputs))
-        {
-            ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0, 0, 0, 1));
-            ImGui::Text("Adapter: %s", device_->GetAdapterDescription().c_str());
+void Application::RunBaselineBenchmark()
+{
+    std::ofstream report(baselineBenchmarkFile_, std::ios::trunc);
+
+    if (!report) {
+        throw std::runtime_error("Failed to open baseline benchmark file \"" + baselineBenchmarkFile_.string() + "\"");
+    }
+
+    report << "tutorial,shader,implementation,width,height,gpu_ms,memory_bytes\n";
+
+    const auto tutorials = GetTutorials();
+
+    for (std::uint32_t tutorialIndex = 0; tutorialIndex < tutorials.size(); ++tutorialIndex) {
+        const auto& tutorial = tutorials[tutorialIndex];
+
+        // Baselines implement the sample solution, if there is one
+        const bool sampleSolution = !tutorial.solutionShaderFileName.empty();
+
+        // Only tutorials with a baseline are benchmarked. Skipped tutorials are listed, such that the scope of the
+        // comparison is visible in the report.
+        if (tutorial.baselineShaderFileName.empty()) {
+            const auto shaderFileName = WorkGraph::GetShaderFileName(tutorialIndex, sampleSolution);
+
+            report << tutorialIndex << ',' << shaderFileName << ",no compute baseline,,,,\n";
+
+            Log::Info() << shaderFileName << ": skipped, tutorial has no compute baseline";
+            continue;
+        }
+
+        const InputFrame input = MakeBenchmarkInput(tutorialIndex, sampleSolution);
+
+        const auto WriteResult = [&](const std::string&  shaderFileName,
+                                     const char*         implementation,
+                                     const double        gpuTime,
+                                     const std::uint64_t memorySize) {
+            report << tutorialIndex << ',' << shaderFileName << ',' << implementation << ',' << input.width << ','
+                   << input.height << ',' << gpuTime << ',' << memorySize << '\n';
+
+            Log::Info() << shaderFileName << " [" << implementation << "]: " << std::fixed << std::setprecision(3)
+                        << gpuTime << "ms, " << std::setprecision(1) << memorySize / (1024.0 * 1024.0) << " MiB";
+        };
+
+        try {
+            WorkGraph workGraph(device_.get(),
+                                shaderCompiler_,
+                                *descriptorHeap_,
+                                workGraphRootSignature_.Get(),
+                                tutorialIndex,
+                                sampleSolution);
+
+            WriteResult(WorkGraph::GetShaderFileName(tutorialIndex, sampleSolution),
+                        "work graph",
+                        MeasureDispatchTime(workGraph, input, BenchmarkFrameCount),
+                        workGraph.GetBackingMemorySize() + workGraph.GetResourceMemorySize());
+        } catch (const std::exception& e) {
+            Log::Error() << e.what();
+        }
+
+        try {
+            ComputeBaseline baseline(
+                device_.get(), shaderCompiler_, *descriptorHeap_, workGraphRootSignature_.Get(), tutorialIndex);
+
+            WriteResult(tutorial.baselineShaderFileName,
+                        "compute baseline",
+                        MeasureDispatchTime(baseline, input, BenchmarkFrameCount),
+                        baseline.GetMemorySize());
+        } catch (const std::exception& e) {
+            Log::Error() << e.what();
+        }
+    }
+
+    Log::Info() << "Baseline benchmark written to " << baselineBenchmarkFile_.string();
+}
+
+void Application::RunBackingMemorySweep()
+{
+    const auto& options = backingMemorySweepOptions_;
+
+    std::ofstream report(options.outputFile, std::ios::trunc);
+
+    if (!report) {
+        throw std::runtime_error("Failed to open backing memory sweep file \"" + options.outputFile.string() + "\"");
+    }
+
+    report << "shader,backing_memory_bytes,gpu_ms,gpu_ms_with_initialize,initialize_ms,recommended\n";
+
+    const auto tutorials = GetTutorials();
+
+    for (std::uint32_t tutorialIndex = 0; tutorialIndex < tutorials.size(); ++tutorialIndex) {
+        const auto& tutorial = tutorials[tutorialIndex];
+
+        for (const bool sampleSolution : {false, true}) {
+            const auto& shaderFileName = sampleSolution ? tutorial.solutionShaderFileName : tutorial.shaderFileName;
+
+            if (shaderFileName.empty()) {
+                continue;
+            }
+
+            std::unique_ptr<WorkGraph> workGraph;
+            try {
+                workGraph = std::make_unique<WorkGraph>(device_.get(),
+                                                        shaderCompiler_,
+                                                        *descriptorHeap_,
+                                                        workGraphRootSignature_.Get(),
+                                                        tutorialIndex,
+                                                        sampleSolution);
+            } catch (const std::exception& e) {
+                Log::Error() << e.what();
+                continue;
+            }
+
+            const auto& requirements = workGraph->GetMemoryRequirements();
+
+            if (requirements.MaxSizeInBytes == 0) {
+                Log::Info() << shaderFileName << " does not require backing memory.";
+                continue;
+            }
+
+            const InputFrame input = MakeBenchmarkInput(tutorialIndex, sampleSolution);
+
+            struct Step {
+                std::uint64_t size;
+                double        gpuTime;
+                double        gpuTimeWithInitialize;
+            };
+
+            std::vector<Step> steps;
+
+            // Sizes are evenly spaced from MinSizeInBytes to MaxSizeInBytes and rounded to valid sizes
+            const auto stepCount = std::max(options.stepCount, 2u);
+
+            for (std::uint32_t step = 0; step < stepCount; ++step) {
+                const auto size = requirements.MinSizeInBytes +
+                                  (requirements.MaxSizeInBytes - requirements.MinSizeInBytes) * step / (stepCount - 1);
+
+                // Previous backing memory must no longer be in use
+                device_->WaitForDevice();
+                workGraph->SetBackingMemorySize(device_.get(), size);
+
+                if (!steps.empty() && (steps.back().size == workGraph->GetBackingMemorySize())) {
+                    continue;
+                }
+
+                const auto gpuTime = MeasureDispatchTime(*workGraph, input, BenchmarkFrameCount);
+
+                // Initialization is part of every dispatch
+                const auto gpuTimeWithInitialize = MeasureGpuTime(
+                    BenchmarkFrameCount,
+                    [&](ID3D12GraphicsCommandList10* commandList) {
+                        BindShaderResources(commandList, input, *workGraph);
+                    },
+                    [&](ID3D12GraphicsCommandList10* commandList) {
+                        workGraph->InitializeBackingMemory();
+                        workGraph->Dispatch(commandList);
+                    });
+
+                steps.push_back({
+                    .size                  = workGraph->GetBackingMemorySize(),
+                    .gpuTime               = gpuTime,
+                    .gpuTimeWithInitialize = gpuTimeWithInitialize,
+                });
+            }
+
+            // Smallest size within tolerance of the fastest size
+            const auto fastest     = std::ranges::min(steps, {}, &Step::gpuTime).gpuTime;
+            const auto recommended = std::ranges::find_if(steps, [&](const Step& step) {
+                return step.gpuTime <= fastest * (1.0 + options.tolerance / 100.0);
+            });
+
+            for (const auto& step : steps) {
+                report << shaderFileName << ',' << step.size << ',' << step.gpuTime << ','
+                       << step.gpuTimeWithInitialize << ',' << step.gpuTimeWithInitialize - step.gpuTime << ','
+                       << ((&step == &*recommended) ? 1 : 0) << '\n';
+
+                Log::Info() << shaderFileName << " [" << std::fixed << std::setprecision(1)
+                            << step.size / (1024.0 * 1024.0) << " MiB]: " << std::setprecision(3) << step.gpuTime
+                            << "ms, initialize " << step.gpuTimeWithInitialize - step.gpuTime << "ms";
+            }
+
+            Log::Info() << shaderFileName << ": recommended backing memory size is " << recommended->size
+                        << " bytes (" << std::fixed << std::setprecision(1)
+                        << 100.0 * recommended->size / requirements.MaxSizeInBytes << "% of MaxSizeInBytes, "
+                        << 100.0 * (recommended->gpuTime / fastest - 1.0) << "% slower than fastest size)";
+        }
+    }
+
+    Log::Info() << "Backing memory sweep written to " << options.outputFile.string();
+}
+
+InputFrame Application::MakeBenchmarkInput(std::uint32_t tutorialIndex, bool sampleSolution) const
+{
+    return {
+        .width          = writableBackbufferWidth_,
+        .height         = writableBackbufferHeight_,
+        .mouseX         = writableBackbufferWidth_ / 2.f,
+        .mouseY         = writableBackbufferHeight_ / 2.f,
+        .inputState     = 0,
+        .time           = 2.5f,
+        .tutorialIndex  = tutorialIndex,
+        .sampleSolution = sampleSolution,
+    };
+}
+
+double Application::MeasureDispatchTime(WorkGraph& workGraph, const InputFrame& input, const std::uint32_t frameCount)
+{
+    return MeasureGpuTime(
+        frameCount,
+        [&](ID3D12GraphicsCommandList10* commandList) { BindShaderResources(commandList, input, workGraph); },
+        [&](ID3D12GraphicsCommandList10* commandList) { workGraph.Dispatch(commandList); });
+}
+
+double Application::MeasureDispatchTime(ComputeBaseline&    baseline,
+                                        const InputFrame&   input,
+                                        const std::uint32_t frameCount)
+{
+    return MeasureGpuTime(
+        frameCount,
+        [&](ID3D12GraphicsCommandList10* commandList) {
+            BindShaderResources(commandList, input, baseline.GetResourceDescriptorTable());
+        },
+        [&](ID3D12GraphicsCommandList10* commandList) {
+            baseline.Dispatch(commandList, input.width, input.height, scratchBuffer_.Get());
+        });
+}
+
+double Application::MeasureGpuTime(const std::uint32_t                                      frameCount,
+                                   const std::function<void(ID3D12GraphicsCommandList10*)>& bind,
+                                   const std::function<void(ID3D12GraphicsCommandList10*)>& dispatch)
+{
+    GpuTimer gpuTimer(device_->GetDevice(), device_->GetCommandQueue(), 1, 1);
+
+    // Every measurement starts with cleared persistent state
+    clearPersistentScratchBuffer_ = true;
+
+    std::vector<double> gpuTimes;
+
+    for (std::uint32_t frame = 0; frame < frameCount; ++frame) {
+        auto* commandList = device_->GetNextFrameCommandList();
+        gpuTimer.BeginFrame(0);
+
+        ClearShaderResources(commandList);
+        bind(commandList);
+
+        gpuTimer.Begin(commandList, 0);
+        dispatch(commandList);
+        gpuTimer.End(commandList, 0);
+        gpuTimer.EndFrame(commandList);
+
+        device_->ExecuteCurrentFrameCommandList();
+        device_->WaitForDevice();
+
+        gpuTimer.CollectResults(0);
+        gpuTimes.push_back(gpuTimer.GetMilliseconds(0));
+    }
+
+    std::ranges::sort(gpuTimes);
+    return gpuTimes[gpuTimes.size() / 2];
+}
+
+void Application::OnRender(ID3D12GraphicsCommandList10* commandList, const Swapchain::RenderTarget& renderTarget)
+{
+    const Trace::Scope traceScope("Application::OnRender");
+
+    // Use recorded input when replaying, live input otherwise
+    const auto input = inputReplay_ ? replayFrame_ : GetLiveInputFrame();
+
+    if (inputRecorder_) {
+        inputRecorder_->RecordFrame(input);
+    }
+
+    CheckDispatchBudget();
+
+    ++frameCount_;
+    if (frameCount_ == recordTraceOptions_.captureFrame) {
+        recordTraceRequested_ = true;
+    }
+
+    // Clear shader resources (writable backbuffer & scratch buffer)
+    ClearShaderResources(commandList);
+
+    if (recordTraceRequested_ && ((splitScreen_ && splitWorkGraph_) || computeBaseline_)) {
+        Log::Warning() << "Record traces can only be captured without split screen and compute baseline.";
+        recordTraceRequested_ = false;
+    }
+
+    if (splitScreen_ && splitWorkGraph_) {
+        DispatchSplitScreen(commandList, input);
+        SaveLastGoodWorkGraph();
+    } else if (computeBaseline_) {
+        BindShaderResources(commandList, input, computeBaseline_->GetResourceDescriptorTable());
+
+        computeBaseline_->Dispatch(commandList, input.width, input.height, scratchBuffer_.Get());
+    } else {
+        const bool recordTrace       = BeginRecordTrace(commandList);
+        const bool profileMaxRecords = BeginMaxRecordsProfiling(commandList);
+
+        BindShaderResources(commandList, input, *workGraph_);
+
+        workGraph_->Dispatch(commandList);
+        SaveLastGoodWorkGraph();
+
+        if (recordTrace) {
+            EndRecordTrace(commandList);
+        }
+        if (profileMaxRecords) {
+            EndMaxRecordsProfiling(commandList);
+        }
+    }
+
+    ReadbackDispatchBudget(commandList);
+
+    if (IsScaledPreview()) {
+        // Writable backbuffer is drawn as scaled image by the user interface
+        const auto barrier = CD3DX12_RESOURCE_BARRIER::Transition(writableBackbuffer_.Get(),
+                                                                  D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+                                                                  D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+        commandList->ResourceBarrier(1, &barrier);
+
+        const float clearColor[4] = {0.f, 0.f, 0.f, 1.f};
+        commandList->ClearRenderTargetView(renderTarget.colorDescriptorHandle, clearColor, 0, nullptr);
+
+        return;
+    }
+
+    // Copy writable backbuffer to render target
+    {
+        std::array<D3D12_RESOURCE_BARRIER, 2> preBarriers = {
+            CD3DX12_RESOURCE_BARRIER::Transition(
+                writableBackbuffer_.Get(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE),
+            CD3DX12_RESOURCE_BARRIER::Transition(
+                renderTarget.colorResource.Get(), D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_COPY_DEST),
+        };
+        commandList->ResourceBarrier(preBarriers.size(), preBarriers.data());
+
+        const D3D12_TEXTURE_COPY_LOCATION sourceLocation = {
+            .pResource        = writableBackbuffer_.Get(),
+            .Type             = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX,
+            .SubresourceIndex = 0,
+        };
+        const D3D12_TEXTURE_COPY_LOCATION destLocation = {
+            .pResource        = renderTarget.colorResource.Get(),
+            .Type             = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX,
+            .SubresourceIndex = 0,
+        };
+        // Writable backbuffer may be over-allocated, only copy the rendered region
+        const CD3DX12_BOX sourceBox(0, 0, writableBackbufferWidth_, writableBackbufferHeight_);
+
+        commandList->CopyTextureRegion(&destLocation, 0, 0, 0, &sourceLocation, &sourceBox);
+
+        std::array<D3D12_RESOURCE_BARRIER, 2> postBarriers = {
+            CD3DX12_RESOURCE_BARRIER::Transition(
+                writableBackbuffer_.Get(), D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_UNORDERED_ACCESS),
+            CD3DX12_RESOURCE_BARRIER::Transition(
+                renderTarget.colorResource.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_RENDER_TARGET),
+        };
+        commandList->ResourceBarrier(postBarriers.size(), postBarriers.data());
+    }
+}
+
+void Application::DispatchSplitScreen(ID3D12GraphicsCommandList10* commandList, const InputFrame& input)
+{
+    const Trace::Scope traceScope("Application::DispatchSplitScreen");
+
+    ClearSplitScreenResources(commandList);
+
+    // Tutorial is shown in the left half, sample solution in the right half
+    auto* tutorialWorkGraph = workGraph_->IsSampleSolution() ? splitWorkGraph_.get() : workGraph_.get();
+    auto* solutionWorkGraph = workGraph_->IsSampleSolution() ? workGraph_.get() : splitWorkGraph_.get();
+
+    const auto width     = writableBackbufferWidth_;
+    const auto leftWidth = width / 2;
+
+    // Each half gets its own render size and mouse position relative to its origin
+    auto leftInput  = input;
+    leftInput.width = leftWidth;
+
+    auto rightInput   = input;
+    rightInput.width  = width - leftWidth;
+    rightInput.mouseX = input.mouseX - leftWidth;
+
+    // Results of the frame that previously used this slot are available, as the device waited for it
+    splitGpuTimer_->BeginFrame(device_->GetFrameIndex());
+
+    for (std::uint32_t half = 0; half < 2; ++half) {
+        // Smooth timings for display
+        splitGpuTimes_[half] += (splitGpuTimer_->GetMilliseconds(half) - splitGpuTimes_[half]) * 0.1;
+    }
+
+    BindShaderResources(commandList, leftInput, *tutorialWorkGraph, 0);
+
+    splitGpuTimer_->Begin(commandList, 0);
+    tutorialWorkGraph->Dispatch(commandList);
+    splitGpuTimer_->End(commandList, 0);
+
+    // Prevent both dispatches from overlapping, such that each one is timed individually
+    const auto uavBarrier = CD3DX12_RESOURCE_BARRIER::UAV(nullptr);
+    commandList->ResourceBarrier(1, &uavBarrier);
+
+    BindShaderResources(commandList, rightInput, *solutionWorkGraph, 3);
+
+    splitGpuTimer_->Begin(commandList, 1);
+    solutionWorkGraph->Dispatch(commandList);
+    splitGpuTimer_->End(commandList, 1);
+
+    splitGpuTimer_->EndFrame(commandList);
+
+    // Copy right half to writable backbuffer
+    {
+        std::array<D3D12_RESOURCE_BARRIER, 2> preBarriers = {
+            CD3DX12_RESOURCE_BARRIER::Transition(
+                splitBackbuffer_.Get(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE),
+            CD3DX12_RESOURCE_BARRIER::Transition(
+                writableBackbuffer_.Get(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_DEST),
+        };
+        commandList->ResourceBarrier(preBarriers.size(), preBarriers.data());
+
+        const CD3DX12_TEXTURE_COPY_LOCATION sourceLocation(splitBackbuffer_.Get(), 0);
+        const CD3DX12_TEXTURE_COPY_LOCATION destLocation(writableBackbuffer_.Get(), 0);
+        const CD3DX12_BOX                   sourceBox(0, 0, rightInput.width, rightInput.height);
+        commandList->CopyTextureRegion(&destLocation, leftWidth, 0, 0, &sourceLocation, &sourceBox);
+
+        std::array<D3D12_RESOURCE_BARRIER, 2> postBarriers = {
+            CD3DX12_RESOURCE_BARRIER::Transition(
+                splitBackbuffer_.Get(), D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_UNORDERED_ACCESS),
+            CD3DX12_RESOURCE_BARRIER::Transition(
+                writableBackbuffer_.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_UNORDERED_ACCESS),
+        };
+        commandList->ResourceBarrier(postBarriers.size(), postBarriers.data());
+    }
+}
+
+void Application::BindShaderResources(ID3D12GraphicsCommandList10* commandList,
+                                      const InputFrame&            input,
+                                      const WorkGraph&             workGraph,
+                                      const std::uint32_t          descriptorIndex)
+{
+    BindShaderResources(commandList, input, workGraph.GetResourceDescriptorTable(), descriptorIndex);
+}
+
+void Application::BindShaderResources(ID3D12GraphicsCommandList10*      commandList,
+                                      const InputFrame&                 input,
+                                      const D3D12_GPU_DESCRIPTOR_HANDLE declaredResourceTable,
+                                      const std::uint32_t               descriptorIndex)
+{
+    // Set root signature for parameters
+    commandList->SetComputeRootSignature(workGraphRootSignature_.Get());
+
+    struct RootConstants {
+        unsigned width, height;
+        float    mouseX, mouseY;
+        unsigned inputState;
+        float    time;
+        // Set per pass by compute baselines, see ComputeBaseline::PassIterationConstant
+        unsigned passIteration;
+        unsigned dispatchBudget;
+        // Only non-zero while a record trace is captured, see BeginRecordTrace
+        unsigned recordTraceCapacity;
+        // Only non-zero while MaxRecords are profiled, see BeginMaxRecordsProfiling
+        unsigned maxRecordsProbeCount;
+    };
+
+    const RootConstants constants = {
+        .width                = input.width,
+        .height               = input.height,
+        .mouseX               = input.mouseX,
+        .mouseY               = input.mouseY,
+        .inputState           = input.inputState,
+        .time                 = input.time,
+        .passIteration        = 0,
+        .dispatchBudget       = dispatchBudget_,
+        .recordTraceCapacity  = recordTraceCapacity_,
+        .maxRecordsProbeCount = maxRecordsProbeCount_,
+    };
+
+    // Set root constants
+    commandList->SetComputeRoot32BitConstants(0, sizeof(RootConstants) / sizeof(std::uint32_t), &constants, 0);
+
+    // Set font buffer
+    commandList->SetComputeRootShaderResourceView(1, fontBuffer_->GetGPUVirtualAddress());
+
+    // Set descriptor tables. Descriptor heap was bound by ClearShaderResources.
+    UpdateResourceDescriptors();
+    commandList->SetComputeRootDescriptorTable(2, GetResourceDescriptorHandle(descriptorIndex));
+    commandList->SetComputeRootDescriptorTable(3, declaredResourceTable);
+
+    // Right half of split screen uses the second dispatch budget counter
+    const auto dispatchBudgetOffset = (descriptorIndex == 0) ? 0 : DispatchBudgetBufferSize / 2;
+    commandList->SetComputeRootUnorderedAccessView(
+        4, dispatchBudgetBuffer_->GetGPUVirtualAddress() + dispatchBudgetOffset);
+
+    // Record trace buffer is not accessed if recordTraceCapacity is zero
+    commandList->SetComputeRootUnorderedAccessView(
+        5, recordTraceBuffer_ ? recordTraceBuffer_->GetGPUVirtualAddress() : 0);
+    // MaxRecords buffer is not accessed if maxRecordsProbeCount is zero
+    commandList->SetComputeRootUnorderedAccessView(
+        6, maxRecordsBuffer_ ? maxRecordsBuffer_->GetGPUVirtualAddress() : 0);
+}
+
+InputFrame Application::GetLiveInputFrame() const
+{
+    const auto& mousePos = ImGui::GetMousePos();
+    // Mouse position in render target pixels
+    const auto  preview  = GetPreviewRect();
+
+    InputFrame input = {
+        .width      = writableBackbufferWidth_,
+        .height     = writableBackbufferHeight_,
+        .mouseX     = (mousePos.x - preview.x) / preview.scale,
+        .mouseY     = (mousePos.y - preview.y) / preview.scale,
+        .inputState = 0,
+        .time = std::chrono::duration_cast<std::chrono::duration<float>>(std::chrono::high_resolution_clock::now() -
+                                                                         startTime_)
+                    .count(),
+        .tutorialIndex  = workGraph_->GetTutorialIndex(),
+        .sampleSolution = workGraph_->IsSampleSolution(),
+    };
+
+    // Compute input state
+    input.inputState |= ImGui::IsMouseDown(ImGuiMouseButton_Left) << 0U;
+    input.inputState |= ImGui::IsMouseDown(ImGuiMouseButton_Middle) << 1U;
+    input.inputState |= ImGui::IsMouseDown(ImGuiMouseButton_Right) << 2U;
+    input.inputState |= ImGui::IsKeyDown(ImGuiKey_Space) << 3U;
+    input.inputState |= ImGui::IsKeyDown(ImGuiKey_UpArrow) << 4U;
+    input.inputState |= ImGui::IsKeyDown(ImGuiKey_LeftArrow) << 5U;
+    input.inputState |= ImGui::IsKeyDown(ImGuiKey_DownArrow) << 6U;
+    input.inputState |= ImGui::IsKeyDown(ImGuiKey_RightArrow) << 7U;
+    input.inputState |= ImGui::IsKeyDown(ImGuiKey_W) << 8U;
+    input.inputState |= ImGui::IsKeyDown(ImGuiKey_A) << 9U;
+    input.inputState |= ImGui::IsKeyDown(ImGuiKey_S) << 10U;
+    input.inputState |= ImGui::IsKeyDown(ImGuiKey_D) << 11U;
+
+    return input;
+}
+
+void Application::OnRenderUserInterface(ID3D12GraphicsCommandList10*   commandList,
+                                        const Swapchain::RenderTarget& renderTarget)
+{
+    const Trace::Scope traceScope("Application::OnRenderUserInterface");
+
+    const auto tutorials = GetTutorials();
+
+    const bool scaledPreview = IsScaledPreview();
+
+    if (scaledPreview) {
+        const auto desc    = writableBackbuffer_->GetDesc();
+        const auto preview = GetPreviewRect();
+
+        const auto previewDescriptor = descriptorHeap_->GetGPUHandle(previewDescriptorIndex_);
+
+        // Only show the rendered region of the over-allocated writable backbuffer
+        ImGui::GetBackgroundDrawList()->AddImage(
+            ImTextureID(previewDescriptor.ptr),
+            ImVec2(preview.x, preview.y),
+            ImVec2(preview.x + writableBackbufferWidth_ * preview.scale,
+                   preview.y + writableBackbufferHeight_ * preview.scale),
+            ImVec2(0.f, 0.f),
+            ImVec2(static_cast<float>(writableBackbufferWidth_) / desc.Width,
+                   static_cast<float>(writableBackbufferHeight_) / desc.Height));
+    }
+
+    ImGui::PushStyleColor(ImGuiCol_MenuBarBg, ImVec4(0.0f, 0.0f, 0.0f, 0.4f));
+    ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0.0f, 0.0f, 0.0f, 0.4f));
+    ImGui::BeginMainMenuBar();
+
+    if (ImGui::BeginMenu("Tutorials")) {
+        for (std::uint32_t tutorialIndex = 0; tutorialIndex < tutorials.size(); ++tutorialIndex) {
+            const auto& tutorial = tutorials[tutorialIndex];
+
+            if (ImGui::MenuItem(tutorial.name.c_str(), nullptr, tutorialIndex == workGraphTutorialIndex_)) {
+                workGraphTutorialIndex_     = tutorialIndex;
+                // Reset sample solution
+                workGraphUseSampleSolution_ = false;
+            }
+        }
+
+        ImGui::EndMenu();
+    }
+
+    if (ImGui::BeginMenu("Trace")) {
+        if (ImGui::MenuItem("Save last 10 seconds")) {
+            WriteTrace(10.0);
+        }
+        if (ImGui::MenuItem("Save entire trace")) {
+            WriteTrace(0.0);
+        }
+
+        ImGui::Separator();
+
+        if (ImGui::MenuItem("Capture record trace", nullptr, false, !recordTracePending_)) {
+            recordTraceRequested_ = true;
+        }
+
+        ImGui::Separator();
+
+        ImGui::MenuItem("Profile MaxRecords", nullptr, &maxRecordsProfiling_);
+        if (ImGui::MenuItem("Write MaxRecords report", nullptr, false, maxRecordsBuffer_ != nullptr)) {
+            WriteMaxRecordsReport();
+        }
+
+        ImGui::EndMenu();
+    }
+
+    if (ImGui::BeginMenu("Render Size")) {
+        if (ImGui::MenuItem("Window", nullptr, renderWidth_ == 0)) {
+            renderWidth_  = 0;
+            renderHeight_ = 0;
+        }
+        for (const auto& resolution : Resolutions) {
+            const bool selected = (renderWidth_ == resolution.width) && (renderHeight_ == resolution.height);
+            if (ImGui::MenuItem(resolution.name, nullptr, selected)) {
+                renderWidth_  = resolution.width;
+                renderHeight_ = resolution.height;
+            }
+        }
+
+        ImGui::EndMenu();
+    }
+
+    if (ImGui::BeginMenu("Analysis")) {
+        ImGui::MenuItem("Node Cost Model", nullptr, &showNodeCostWindow_);
+
+        ImGui::EndMenu();
+    }
+
+    if (!tutorials[workGraphTutorialIndex_].solutionShaderFileName.empty()) {
+        ImGui::Text("|");
+        // Split screen always shows both
+        ImGui::BeginDisabled(splitScreen_);
+        ImGui::Checkbox("Sample Solution", &workGraphUseSampleSolution_);
+        ImGui::EndDisabled();
+        ImGui::Checkbox("Split Screen", &splitScreen_);
+    }
+
+    if (!tutorials[workGraphTutorialIndex_].baselineShaderFileName.empty()) {
+        ImGui::Text("|");
+        // Split screen always compares work graphs
+        ImGui::BeginDisabled(splitScreen_);
+        ImGui::Checkbox("Compute Baseline", &useComputeBaseline_);
+        ImGui::EndDisabled();
+    }
+
+    ImGui::Text("|");
+    ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1, 0.5, 0, 1));
+    ImGui::Text("Open tutorials/%s to start this tutorial.", tutorials[workGraphTutorialIndex_].shaderFileName.c_str());
+    ImGui::PopStyleColor();
+
+    // Watchdog stopped record emission of nodes, see CheckDispatchBudget
+    if (dispatchBudgetExceeded_) {
+        ImGui::Text("|");
+        ImGui::TextColored(ImVec4(1, 0, 0, 1), "Dispatch budget exceeded!");
+    }
+
+    // Print current FPS to menu bar
+    {
+        const auto& io                = ImGui::GetIO();
+        const auto  frametimeTextSize = ImGui::CalcTextSize("Frametime: XXXXXms (XXXX FPS)");
+        const auto  vsyncTextSize     = ImGui::CalcTextSize("V-Sync");
+        const auto  tierTextSize      = ImGui::CalcTextSize("Preview (-Od)");
+        const auto  checkboxWidth     = ImGui::GetFrameHeight();
+        const auto  padding           = 20;
+
+        ImGui::SetCursorPosX(ImGui::GetCursorPosX() + ImGui::GetContentRegionAvail().x -
+                             (frametimeTextSize.x + vsyncTextSize.x + tierTextSize.x + checkboxWidth + 2 * padding));
+
+        // Label compile tier, as preview builds are significantly slower
+        if (workGraphTier_ == CompileTier::Preview) {
+            ImGui::TextColored(ImVec4(1, 0.5, 0, 1), "Preview (-Od)");
+        } else {
+            ImGui::Text("Optimized");
+        }
+
+        ImGui::SetCursorPosX(ImGui::GetCursorPosX() + ImGui::GetContentRegionAvail().x -
+                             (frametimeTextSize.x + vsyncTextSize.x + checkboxWidth + padding));
+        ImGui::Checkbox("V-Sync", &vsync_);
+
+        ImGui::SetCursorPosX(ImGui::GetCursorPosX() + ImGui::GetContentRegionAvail().x - frametimeTextSize.x);
+        ImGui::Text("Frametime: %5.1fms (%4.0f FPS)", io.DeltaTime * 1000.f, io.Framerate);
+    }
+
+    ImGui::EndMainMenuBar();
+    ImGui::PopStyleColor(2);
+
+    // Split screen timings
+    if (splitScreen_ && splitWorkGraph_) {
+        ImGui::SetNextWindowPos(
+            ImVec2(window_->GetWidth() / 2, ImGui::GetFrameHeight() + 10), ImGuiCond_Always, ImVec2(0.5, 0));
+
+        if (ImGui::Begin("split",
+                         nullptr,
+                         ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoInputs))
+        {
+            const auto tutorialTime = splitGpuTimes_[0];
+            const auto solutionTime = splitGpuTimes_[1];
+
+            ImGui::Text("Tutorial (left): %6.3fms | Sample Solution (right): %6.3fms | Difference: %+6.3fms (%+.0f%%)",
+                        tutorialTime,
+                        solutionTime,
+                        tutorialTime - solutionTime,
+                        (solutionTime > 0.0) ? (tutorialTime / solutionTime - 1.0) * 100.0 : 0.0);
+
+            if (workGraphTier_ == CompileTier::Preview) {
+                ImGui::TextColored(ImVec4(1, 0.5, 0, 1),
+                                   "%s is a preview build (-Od). Waiting for optimized build...",
+                                   workGraph_->IsSampleSolution() ? "Sample solution" : "Tutorial");
+            }
+        }
+
+        ImGui::End();
+    }
+
+    // Compilation error message window
+    if (errorMessageEndTime_ >= std::chrono::high_resolution_clock::now()) {
+        ImGui::SetNextWindowPos(
+            ImVec2(window_->GetWidth() / 2, window_->GetHeight() - 20), ImGuiCond_Always, ImVec2(0.5, 1));
+
+        if (ImGui::Begin("error",
+                         nullptr,
+                         ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoInputs))
+        {
+            ImGui::Text("Work Graph compilation failed. Check output for more details.");
+        }
+
+        ImGui::End();
+    }
+
+    if (showNodeCostWindow_) {
+        OnRenderNodeCostWindow();
+    }
+
+    // Info window
+    {
+        ImGui::SetNextWindowPos(ImVec2(0, window_->GetHeight()), ImGuiCond_Always, ImVec2(0, 1));
+
+        if (ImGui::Begin("info",
+                         nullptr,
+                         ImGuiWindowFlags_NoBackground | ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoDecoration |
+                             ImGuiWindowFlags_NoInputs))
+        {
+            ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0, 0, 0, 1));
+            ImGui::Text("Adapter: %s", device_->GetAdapterDescription().c_str());
+            ImGui::PopStyleColor();
+        }
+
+        ImGui::End();
+    }
+
+    // Message window at bottom
+    {
+        ImGui::SetNextWindowPos(ImVec2(window_->GetWidth(), window_->GetHeight()), ImGuiCond_Always, ImVec2(1, 1));
+
+        if (ImGui::Begin("bottom",
+                         nullptr,
+                         ImGuiWindowFlags_NoBackground | ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoDecoration |
+                             ImGuiWindowFlags_NoInputs))
+        {
+            ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0, 0, 0, 1));
+            ImGui::Text("Work Graph Playground by AMD & HS Coburg");
             ImGui::PopStyleColor();
         }
 
-        ImGui::End();
+        ImGui::End();
+    }
+
+    // Render to render target
+    {
+        // Set swapchain render target
+        commandList->OMSetRenderTargets(
+            1, &renderTarget.colorDescriptorHandle, false, &renderTarget.depthDescriptorHandle);
+
+        // UI descriptors are in the descriptor heap bound by ClearShaderResources
+        const Trace::Scope renderTraceScope("ImGui::Render");
+
+        ImGui::Render();
+        ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), commandList);
+    }
+
+    if (scaledPreview) {
+        const auto barrier = CD3DX12_RESOURCE_BARRIER::Transition(writableBackbuffer_.Get(),
+                                                                  D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,
+                                                                  D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+        commandList->ResourceBarrier(1, &barrier);
+    }
+}
+
+void Application::OnResize(std::uint32_t width, std::uint32_t height)
+{
+    const Trace::Scope traceScope("Application::OnResize");
+
+    // Swapchain buffers can only be resized once no frame in flight references them
+    device_->WaitForDevice();
+
+    swapchain_->Resize(width, height);
+}
+
+void Application::OnRenderSizeChanged(std::uint32_t width, std::uint32_t height)
+{
+    const Trace::Scope traceScope("Application::OnRenderSizeChanged");
+
+    // Previous resources are released once frames in flight are done, no need to wait for the device
+    CreateWritableBackbuffer(width, height);
+
+    if (splitBackbuffer_) {
+        CreateSplitScreenResources(width - width / 2, height);
+    }
+}
+
+std::uint32_t Application::GetRenderWidth() const
+{
+    return (renderWidth_ != 0) ? renderWidth_ : window_->GetWidth();
+}
+
+std::uint32_t Application::GetRenderHeight() const
+{
+    return (renderHeight_ != 0) ? renderHeight_ : window_->GetHeight();
+}
+
+Application::PreviewRect Application::GetPreviewRect() const
+{
+    const auto renderWidth  = static_cast<float>(writableBackbufferWidth_);
+    const auto renderHeight = static_cast<float>(writableBackbufferHeight_);
+    const auto windowWidth  = static_cast<float>(swapchain_->GetWidth());
+    const auto windowHeight = static_cast<float>(swapchain_->GetHeight());
+
+    // Fit render target into window, keeping its aspect ratio
+    const auto scale = std::min(windowWidth / renderWidth, windowHeight / renderHeight);
+
+    return {
+        .x     = (windowWidth - renderWidth * scale) / 2.f,
+        .y     = (windowHeight - renderHeight * scale) / 2.f,
+        .scale = scale,
+    };
+}
+
+bool Application::IsScaledPreview() const
+{
+    return (writableBackbufferWidth_ != swapchain_->GetWidth()) ||  //
+           (writableBackbufferHeight_ != swapchain_->GetHeight());
+}
+
+void Application::CreatePreviewDescriptor()
+{
+    D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format                          = Swapchain::ColorTargetFormat;
+    srvDesc.ViewDimension                   = D3D12_SRV_DIMENSION_TEXTURE2D;
+    srvDesc.Shader4ComponentMapping         = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+    srvDesc.Texture2D.MipLevels             = 1;
+
+    // Frames in flight may still use the previous descriptor, thus a new one is allocated
+    if (previewDescriptorIndex_ != DescriptorHeap::InvalidIndex) {
+        descriptorHeap_->Free(previewDescriptorIndex_, 1);
+    }
+    previewDescriptorIndex_ = descriptorHeap_->Allocate(1);
+
+    device_->GetDevice()->CreateShaderResourceView(
+        writableBackbuffer_.Get(), &srvDesc, descriptorHeap_->GetCPUHandle(previewDescriptorIndex_));
+}
+
+void Application::CreateImGuiContext()
+{
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
+    io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;
+
+    // Disbale ini and log files
+    io.IniFilename = nullptr;
+    io.LogFilename = nullptr;
+
+    // Descriptor for ImGui font texture
+    const auto fontDescriptorIndex = descriptorHeap_->Allocate(1);
+
+    // Setup Platform/Renderer backends
+    ImGui_ImplWin32_Init(window_->GetHandle());
+    ImGui_ImplDX12_Init(device_->GetDevice(),
+                        Device::BufferedFramesCount,
+                        Swapchain::ColorTargetFormat,
+                        descriptorHeap_->GetHeap(),
+                        descriptorHeap_->GetCPUHandle(fontDescriptorIndex),
+                        descriptorHeap_->GetGPUHandle(fontDescriptorIndex));
+}
+
+void Application::DestroyImGuiContext()
+{
+    ImGui_ImplDX12_Shutdown();
+    ImGui_ImplWin32_Shutdown();
+    ImGui::DestroyContext();
+}
+
+void Application::CreateWorkGraphRootSignature()
+{
+    const auto descriptorRange = CD3DX12_DESCRIPTOR_RANGE(D3D12_DESCRIPTOR_RANGE_TYPE_UAV, 3, 0);
+    // Resources declared by tutorials, see WorkGraph::ResourceDeclaration
+    const auto declaredResourceRange = CD3DX12_DESCRIPTOR_RANGE(
+        D3D12_DESCRIPTOR_RANGE_TYPE_UAV, WorkGraph::MaxResourceCount, WorkGraph::FirstResourceRegister);
+
+    std::array<CD3DX12_ROOT_PARAMETER, 7> rootParameters;
+    // Render size, mouse position, input state, time, pass iteration of compute baselines, dispatch budget, record
+    // trace capacity and MaxRecords probe count
+    rootParameters[0].InitAsConstants(10, 0);
+    rootParameters[1].InitAsShaderResourceView(0);
+    rootParameters[2].InitAsDescriptorTable(1, &descriptorRange);
+    rootParameters[3].InitAsDescriptorTable(1, &declaredResourceRange);
+    // Dispatch budget counter of the watchdog, see tutorials/Common.h
+    rootParameters[4].InitAsUnorderedAccessView(WorkGraph::FirstResourceRegister + WorkGraph::MaxResourceCount);
+    // Record trace buffer, see tutorials/Common.h
+    rootParameters[5].InitAsUnorderedAccessView(WorkGraph::FirstResourceRegister + WorkGraph::MaxResourceCount + 1);
+    // MaxRecords peaks, see tutorials/Common.h
+    rootParameters[6].InitAsUnorderedAccessView(WorkGraph::FirstResourceRegister + WorkGraph::MaxResourceCount + 2);
+
+    CD3DX12_ROOT_SIGNATURE_DESC rootSignatureDesc;
+    rootSignatureDesc.Init(rootParameters.size(), rootParameters.data(), 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+
+    ComPtr<ID3DBlob> signature;
+    ComPtr<ID3DBlob> error;
+    ThrowIfFailed(D3D12SerializeRootSignature(&rootSignatureDesc, D3D_ROOT_SIGNATURE_VERSION_1, &signature, &error));
+    ThrowIfFailed(device_->GetDevice()->CreateRootSignature(
+        0, signature->GetBufferPointer(), signature->GetBufferSize(), IID_PPV_ARGS(&workGraphRootSignature_)));
+}
+
+bool Application::CreateWorkGraph()
+{
+    const Trace::Scope traceScope("Application::CreateWorkGraph");
+
+    if (ActivateCachedWorkGraph()) {
+        return true;
+    }
+
+    CompiledLibrary compiled;
+
+    try {
+        // First work graph is compiled in parallel to the device initialization
+        if (initialLibrary_.valid()) {
+            const Trace::Scope waitTraceScope("Application::WaitForInitialCompile");
+
+            compiled            = initialLibrary_.get();
+            initialCompileTime_ = compiled.compileTime;
+        } else {
+            compiled = CompileWorkGraphLibrary(workGraphTutorialIndex_, workGraphUseSampleSolution_);
+        }
+    } catch (const std::exception& e) {
+        // Re-throw exception if no fallback work graph exists
+        if (!workGraph_) {
+            throw e;
+        }
+
+        Log::Error() << "Failed to re-create work graph:\n" << e.what();
+
+        return false;
+    }
+
+    // Work graph cached before shader sources changed is re-used if its library is unchanged
+    if (ActivateCachedWorkGraph(&compiled)) {
+        return true;
+    }
+
+    // Skip re-creation if only comments, whitespace or unused code were changed.
+    // Resource declarations are comments, thus they are compared separately.
+    if (workGraph_ && (workGraph_->GetTutorialIndex() == workGraphTutorialIndex_) &&
+        (workGraph_->IsSampleSolution() == workGraphUseSampleSolution_) &&
+        (workGraphLibraryHash_ == compiled.libraryHash) &&
+        std::ranges::equal(workGraph_->GetResourceDeclarations(), compiled.resourceDeclarations))
+    {
+        workGraphSourceGeneration_ = shaderSourceGeneration_;
+
+        Log::Info() << "Compiled work graph is unchanged.";
+        return true;
+    }
+
+    std::unique_ptr<WorkGraph> workGraph;
+
+    try {
+        workGraph = std::make_unique<WorkGraph>(device_.get(),
+                                                shaderCompiler_,
+                                                *descriptorHeap_,
+                                                compiled.library,
+                                                workGraphRootSignature_.Get(),
+                                                workGraphTutorialIndex_,
+                                                workGraphUseSampleSolution_);
+    } catch (const std::exception& e) {
+        if (!workGraph_) {
+            throw e;
+        }
+
+        Log::Error() << "Failed to re-create work graph:\n" << e.what();
+
+        return false;
+    }
+
+    // Keep previous work graph for switching back, unless it was replaced by a newer version of itself
+    if (workGraph_ && ((workGraph_->GetTutorialIndex() != workGraphTutorialIndex_) ||
+                       (workGraph_->IsSampleSolution() != workGraphUseSampleSolution_)))
+    {
+        workGraphCache_.push_front({
+            .workGraph        = std::move(workGraph_),
+            .tier             = workGraphTier_,
+            .libraryHash      = workGraphLibraryHash_,
+            .sourceGeneration = workGraphSourceGeneration_,
+        });
+    }
+
+    // Frames in flight may still use the previous work graph
+    device_->DeferRelease(std::move(workGraph_));
+    workGraph_ = std::move(workGraph);
+
+    EvictCachedWorkGraphs();
+
+    // Discard optimized library of previous work graph, if it is still being compiled
+    ++workGraphGeneration_;
+
+    workGraphTier_             = compiled.tier;
+    workGraphLibraryHash_      = compiled.libraryHash;
+    workGraphSourceGeneration_ = shaderSourceGeneration_;
+    nodeCostsValid_            = false;
+
+    if (workGraphTier_ == CompileTier::Preview) {
+        CompileOptimizedWorkGraph();
+    }
+
+    return true;
+}
+
+Application::CompiledLibrary Application::CompileWorkGraphLibrary(const std::uint32_t tutorialIndex,
+                                                                  const bool          sampleSolution)
+{
+    const Trace::Scope traceScope("Application::CompileWorkGraphLibrary");
+
+    const auto startTime = std::chrono::high_resolution_clock::now();
+
+    CompiledLibrary compiled = {.tier = CompileTier::Optimized};
+
+    if (tieredCompilation_) {
+        // Skip preview build if optimized library is already in the shader pack
+        compiled.library = WorkGraph::FindCompiledLibrary(shaderCompiler_, tutorialIndex, sampleSolution);
+    }
+
+    if (!compiled.library) {
+        ShaderCompileOptions options;
+        if (tieredCompilation_) {
+            options.skipOptimizations = true;
+            compiled.tier             = CompileTier::Preview;
+        }
+
+        compiled.library = WorkGraph::CompileLibrary(shaderCompiler_, tutorialIndex, sampleSolution, options);
+    }
+
+    compiled.libraryHash          = ShaderCompiler::HashShaderCode(compiled.library.Get());
+    compiled.resourceDeclarations = WorkGraph::ReadResourceDeclarations(shaderCompiler_, tutorialIndex, sampleSolution);
+    compiled.compileTime          = std::chrono::high_resolution_clock::now() - startTime;
+
+    return compiled;
+}
+
+bool Application::ActivateCachedWorkGraph(const CompiledLibrary* compiled)
+{
+    const auto it = std::ranges::find_if(workGraphCache_, [&](const CachedWorkGraph& cached) {
+        return (cached.workGraph->GetTutorialIndex() == workGraphTutorialIndex_) &&
+               (cached.workGraph->IsSampleSolution() == workGraphUseSampleSolution_);
+    });
+
+    if (it == workGraphCache_.end()) {
+        return false;
+    }
+
+    // Shader sources changed since the work graph was cached
+    if (it->sourceGeneration != shaderSourceGeneration_) {
+        if (!compiled) {
+            return false;
+        }
+
+        if ((it->libraryHash != compiled->libraryHash) ||
+            !std::ranges::equal(it->workGraph->GetResourceDeclarations(), compiled->resourceDeclarations))
+        {
+            // Frames in flight may still use the outdated work graph
+            device_->DeferRelease(std::move(it->workGraph));
+            workGraphCache_.erase(it);
+            return false;
+        }
+
+        it->sourceGeneration = shaderSourceGeneration_;
+    }
+
+    const Trace::Scope traceScope("Application::ActivateCachedWorkGraph");
+
+    // Swap active and cached work graph. Active work graph becomes the most recently used cache entry.
+    std::swap(workGraph_, it->workGraph);
+    std::swap(workGraphTier_, it->tier);
+    std::swap(workGraphLibraryHash_, it->libraryHash);
+    std::swap(workGraphSourceGeneration_, it->sourceGeneration);
+    workGraphCache_.splice(workGraphCache_.begin(), workGraphCache_, it);
+
+    // Discard optimized library of previous work graph, if it is still being compiled
+    ++workGraphGeneration_;
+
+    nodeCostsValid_ = false;
+
+    if (workGraphTier_ == CompileTier::Preview) {
+        CompileOptimizedWorkGraph();
+    }
+
+    Log::Info() << "Switched to cached work graph.";
+
+    return true;
+}
+
+void Application::EvictCachedWorkGraphs()
+{
+    std::uint64_t backingMemorySize = 0;
+    for (const auto& cached : workGraphCache_) {
+        backingMemorySize += cached.workGraph->GetBackingMemorySize();
+    }
+
+    while (!workGraphCache_.empty() &&
+           ((workGraphCache_.size() > workGraphCacheSize_) || (backingMemorySize > workGraphCacheMemoryLimit_)))
+    {
+        auto& leastRecentlyUsed = workGraphCache_.back();
+
+        backingMemorySize -= leastRecentlyUsed.workGraph->GetBackingMemorySize();
+
+        // Evicted work graph may have been used by frames in flight
+        device_->DeferRelease(std::move(leastRecentlyUsed.workGraph));
+        workGraphCache_.pop_back();
+    }
+}
+
+void Application::UpdateSplitScreenWorkGraph()
+{
+    const auto tutorialIndex  = workGraph_->GetTutorialIndex();
+    const auto sampleSolution = !workGraph_->IsSampleSolution();
+
+    // Split screen requires a sample solution
+    if (GetTutorials()[tutorialIndex].solutionShaderFileName.empty()) {
+        splitScreen_ = false;
+    }
+
+    if (splitWorkGraph_ && (!splitScreen_ || (splitWorkGraph_->GetTutorialIndex() != tutorialIndex) ||
+                            (splitWorkGraph_->IsSampleSolution() != sampleSolution)))
+    {
+        // Keep previous work graph for switching back
+        workGraphCache_.push_front({
+            .workGraph        = std::move(splitWorkGraph_),
+            .tier             = CompileTier::Optimized,
+            .libraryHash      = splitLibraryHash_,
+            .sourceGeneration = splitSourceGeneration_,
+        });
+
+        EvictCachedWorkGraphs();
+    }
+
+    if (!splitScreen_ || (splitWorkGraph_ && (splitSourceGeneration_ == shaderSourceGeneration_))) {
+        return;
+    }
+
+    const Trace::Scope traceScope("Application::UpdateSplitScreenWorkGraph");
+
+    if (!splitWorkGraph_) {
+        const auto cached = std::ranges::find_if(workGraphCache_, [&](const CachedWorkGraph& entry) {
+            return (entry.workGraph->GetTutorialIndex() == tutorialIndex) &&
+                   (entry.workGraph->IsSampleSolution() == sampleSolution);
+        });
+
+        if (cached != workGraphCache_.end()) {
+            splitWorkGraph_        = std::move(cached->workGraph);
+            splitLibraryHash_      = cached->libraryHash;
+            splitSourceGeneration_ = cached->sourceGeneration;
+            workGraphCache_.erase(cached);
+        }
+    }
+
+    // Work graph is missing or was created before shader sources changed
+    if (!splitWorkGraph_ || (splitSourceGeneration_ != shaderSourceGeneration_)) {
+        try {
+            // Library hash is computed like for the main view, such that work graphs can be moved between both
+            const auto compiled = CompileWorkGraphLibrary(tutorialIndex, sampleSolution);
+
+            const bool unchanged =
+                splitWorkGraph_ && (splitLibraryHash_ == compiled.libraryHash) &&
+                std::ranges::equal(splitWorkGraph_->GetResourceDeclarations(), compiled.resourceDeclarations);
+
+            splitSourceGeneration_ = shaderSourceGeneration_;
+
+            if (unchanged) {
+                return;
+            }
+
+            // Always use optimized build, as split screen is used to compare timings
+            const auto library = (compiled.tier == CompileTier::Optimized)
+                                     ? compiled.library
+                                     : WorkGraph::CompileLibrary(shaderCompiler_, tutorialIndex, sampleSolution);
+
+            auto workGraph = std::make_unique<WorkGraph>(device_.get(),
+                                                         shaderCompiler_,
+                                                         *descriptorHeap_,
+                                                         library,
+                                                         workGraphRootSignature_.Get(),
+                                                         tutorialIndex,
+                                                         sampleSolution);
+
+            // Frames in flight may still use the outdated work graph
+            device_->DeferRelease(std::move(splitWorkGraph_));
+            splitWorkGraph_   = std::move(workGraph);
+            splitLibraryHash_ = compiled.libraryHash;
+        } catch (const std::exception& e) {
+            Log::Error() << "Failed to create work graph for split screen:\n" << e.what();
+
+            device_->DeferRelease(std::move(splitWorkGraph_));
+            splitScreen_ = false;
+
+            using namespace std::chrono_literals;
+            // Show error message pop-up for 5s
+            errorMessageEndTime_ = std::chrono::high_resolution_clock::now() + 5s;
+            return;
+        }
+    }
+
+    if (!splitBackbuffer_) {
+        const auto width = writableBackbufferWidth_;
+
+        CreateSplitScreenResources(width - width / 2, writableBackbufferHeight_);
+    }
+    if (!splitGpuTimer_) {
+        splitGpuTimer_ = std::make_unique<GpuTimer>(
+            device_->GetDevice(), device_->GetCommandQueue(), 2, Device::BufferedFramesCount);
+    }
+
+    clearPersistentScratchBuffer_      = true;
+    clearSplitPersistentScratchBuffer_ = true;
+    splitGpuTimes_                     = {};
+}
+
+void Application::UpdateComputeBaseline()
+{
+    const auto tutorialIndex = workGraph_->GetTutorialIndex();
+
+    // Compute baseline is only shown instead of the main view
+    if (GetTutorials()[tutorialIndex].baselineShaderFileName.empty() || splitScreen_) {
+        useComputeBaseline_ = false;
+    }
+
+    if (computeBaseline_ && (!useComputeBaseline_ || (computeBaseline_->GetTutorialIndex() != tutorialIndex))) {
+        // Frames in flight may still use the baseline
+        device_->DeferRelease(std::move(computeBaseline_));
+
+        clearPersistentScratchBuffer_ = true;
+    }
+
+    // Baseline created before shader sources changed is only re-created if it changed
+    if (computeBaseline_ && (computeBaselineSourceGeneration_ != shaderSourceGeneration_)) {
+        computeBaselineSourceGeneration_ = shaderSourceGeneration_;
+
+        bool unchanged = false;
+        try {
+            unchanged =
+                (ComputeBaseline::HashSources(shaderCompiler_, tutorialIndex) == computeBaseline_->GetSourceHash());
+        } catch (const std::exception&) {
+            // Errors are reported when the baseline is re-created below
+        }
+
+        if (!unchanged) {
+            // Frames in flight may still use the baseline
+            device_->DeferRelease(std::move(computeBaseline_));
+
+            clearPersistentScratchBuffer_ = true;
+        }
+    }
+
+    if (!useComputeBaseline_ || computeBaseline_) {
+        return;
+    }
+
+    const Trace::Scope traceScope("Application::UpdateComputeBaseline");
+
+    try {
+        computeBaseline_ = std::make_unique<ComputeBaseline>(
+            device_.get(), shaderCompiler_, *descriptorHeap_, workGraphRootSignature_.Get(), tutorialIndex);
+
+        computeBaselineSourceGeneration_ = shaderSourceGeneration_;
+    } catch (const std::exception& e) {
+        Log::Error() << "Failed to create compute baseline:\n" << e.what();
+
+        useComputeBaseline_ = false;
+
+        using namespace std::chrono_literals;
+        // Show error message pop-up for 5s
+        errorMessageEndTime_ = std::chrono::high_resolution_clock::now() + 5s;
+        return;
+    }
+
+    // Baseline may use the persistent scratch buffer differently than the work graph
+    clearPersistentScratchBuffer_ = true;
+}
+
+void Application::CompileOptimizedWorkGraph()
+{
+    const auto generation     = workGraphGeneration_;
+    const auto tutorialIndex  = workGraph_->GetTutorialIndex();
+    const auto sampleSolution = workGraph_->IsSampleSolution();
+
+    // Compilations are chained, such that only one thread uses optimizingShaderCompiler_ at a time
+    const auto previous = optimizedLibrary_;
+
+    optimizedLibrary_ =
+        std::async(std::launch::async, [this, previous, generation, tutorialIndex, sampleSolution]() {
+            Trace::SetThreadName("Optimizing Compiler");
+
+            OptimizedLibrary result = {.generation = generation};
+
+            if (previous.valid()) {
+                previous.wait();
+            }
+
+            try {
+                const Trace::Scope traceScope("Application::CompileOptimizedWorkGraph");
+
+                result.library = WorkGraph::CompileLibrary(optimizingShaderCompiler_, tutorialIndex, sampleSolution);
+            } catch (const std::exception& e) {
+                Log::Error() << "Failed to compile optimized work graph:\n" << e.what();
+            }
+
+            return result;
+        }).share();
+}
+
+void Application::SwapOptimizedWorkGraph()
+{
+    using namespace std::chrono_literals;
+
+    if (!optimizedLibrary_.valid() || (optimizedLibrary_.wait_for(0s) != std::future_status::ready)) {
+        return;
+    }
+
+    const auto optimizedLibrary = optimizedLibrary_.get();
+    optimizedLibrary_           = {};
+
+    // Work graph was re-created or switched since compilation was started
+    if ((optimizedLibrary.generation != workGraphGeneration_) || !optimizedLibrary.library) {
+        return;
+    }
+
+    const Trace::Scope traceScope("Application::SwapOptimizedWorkGraph");
+
+    std::unique_ptr<WorkGraph> workGraph;
+
+    try {
+        workGraph = std::make_unique<WorkGraph>(device_.get(),
+                                                shaderCompiler_,
+                                                *descriptorHeap_,
+                                                optimizedLibrary.library,
+                                                workGraphRootSignature_.Get(),
+                                                workGraph_->GetTutorialIndex(),
+                                                workGraph_->IsSampleSolution());
+    } catch (const std::exception& e) {
+        Log::Error() << "Failed to create optimized work graph:\n" << e.what();
+        return;
+    }
+
+    // Frames in flight may still use the preview work graph
+    device_->DeferRelease(std::move(workGraph_));
+    workGraph_ = std::move(workGraph);
+
+    workGraphTier_  = CompileTier::Optimized;
+    nodeCostsValid_ = false;
+
+    Log::Info() << "Switched to optimized work graph.";
+}
+
+void Application::WriteTrace(const double lastSeconds)
+{
+    try {
+        Trace::WriteChromeTrace(traceFile_, lastSeconds);
+        Log::Info() << "Trace written to " << traceFile_.string();
+    } catch (const std::exception& e) {
+        Log::Error() << "Failed to write trace:\n" << e.what();
+    }
+}
+
+void Application::AnalyzeNodeCosts()
+{
+    const Trace::Scope traceScope("Application::AnalyzeNodeCosts");
+
+    nodeCosts_.clear();
+    nodeCostsValid_ = true;
+
+    try {
+        for (const auto& library : workGraph_->GetLibraries()) {
+            const auto nodeCosts = NodeCostModel::Analyze(shaderCompiler_.Disassemble(library.Get()));
+            nodeCosts_.insert(nodeCosts_.end(), nodeCosts.begin(), nodeCosts.end());
+        }
+    } catch (const std::exception& e) {
+        Log::Error() << "Failed to analyze node costs:\n" << e.what();
+    }
+
+    std::sort(nodeCosts_.begin(), nodeCosts_.end(), [](const NodeCost& a, const NodeCost& b) {
+        return a.estimatedCost > b.estimatedCost;
+    });
+}
+
+void Application::OnRenderNodeCostWindow()
+{
+    if (!nodeCostsValid_) {
+        AnalyzeNodeCosts();
+    }
+
+    ImGui::SetNextWindowSize(ImVec2(900, 300), ImGuiCond_FirstUseEver);
+
+    if (ImGui::Begin("Node Cost Model", &showNodeCostWindow_)) {
+        const auto& tutorial = GetTutorials()[workGraph_->GetTutorialIndex()];
+        const auto& shaderFile =
+            workGraph_->IsSampleSolution() ? tutorial.solutionShaderFileName : tutorial.shaderFileName;
+
+        if (ImGui::Button("Save Report")) {
+            const auto    reportFile = std::filesystem::path(shaderFile).stem().string() + "_node_cost.csv";
+            std::ofstream report(reportFile, std::ios::trunc);
+
+            NodeCostModel::WriteReportHeader(report);
+            NodeCostModel::WriteReport(report, shaderFile, nodeCosts_);
+
+            Log::Info() << "Node cost report written to " << reportFile;
+        }
+        ImGui::SameLine();
+        ImGui::TextDisabled("Static estimate from DXIL, in relative units. Loops without constant bound count %.0fx.",
+                            NodeCostModel::DefaultLoopTripCount);
+
+        if (workGraphTier_ == CompileTier::Preview) {
+            ImGui::TextColored(ImVec4(1, 0.5, 0, 1), "Preview build (-Od). Waiting for optimized build...");
+        }
+
+        double totalCost = 0;
+        for (const auto& node : nodeCosts_) {
+            totalCost += node.estimatedCost;
+        }
+
+        static constexpr ImGuiTableFlags TableFlags =
+            ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_SizingFixedFit;
+
+        if (ImGui::BeginTable("nodes", 12, TableFlags)) {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            for (const auto* column : {"Node",
+                                       "Launch",
+                                       "Threads",
+                                       "Invocations",
+                                       "Instructions",
+                                       "Loops",
+                                       "UAV Writes",
+                                       "Typed Writes",
+                                       "Atomics",
+                                       "Barriers",
+                                       "Outputs",
+                                       "Cost"})
+            {
+                ImGui::TableSetupColumn(column);
+            }
+            ImGui::TableHeadersRow();
+
+            for (const auto& node : nodeCosts_) {
+                ImGui::TableNextRow();
+
+                ImGui::TableNextColumn();
+                ImGui::Text("%s[%u]", node.name.c_str(), node.arrayIndex);
+                ImGui::TableNextColumn();
+                ImGui::Text("%s", node.launchType.c_str());
+                ImGui::TableNextColumn();
+                ImGui::Text("%ux%ux%u", node.numThreads[0], node.numThreads[1], node.numThreads[2]);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3g", node.invocations);
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", node.instructions);
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", node.loops);
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", node.uavWrites);
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", node.typedWrites);
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", node.atomics);
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", node.barriers);
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", node.outputCalls);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3g (%.1f%%)",
+                            node.estimatedCost,
+                            (totalCost > 0) ? 100.0 * node.estimatedCost / totalCost : 0.0);
+            }
+
+            ImGui::EndTable();
+        }
+    }
+
+    ImGui::End();
+}
+
+void Application::CreateResourceDescriptorHeaps()
+{
+    // Descriptors 0-2 are used for the main view, descriptors 3-5 for the right half of the split screen,
+    // descriptor 6 for the dispatch budget counters, descriptor 7 for the record trace buffer and descriptor 8 for the
+    // MaxRecords peaks.
+    // Create descriptor heap to clear shader resources
+    {
+        D3D12_DESCRIPTOR_HEAP_DESC desc = {};
+        desc.Type                       = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+        desc.NumDescriptors             = ResourceDescriptorCount;
+        desc.Flags                      = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+        desc.NodeMask                   = 1;
+        ThrowIfFailed(device_->GetDevice()->CreateDescriptorHeap(&desc, IID_PPV_ARGS(&clearDescriptorHeap_)));
+    }
+    // Shader visible descriptor heap for all descriptors, including the user interface
+    descriptorHeap_ = std::make_unique<DescriptorHeap>(device_.get(), DescriptorHeapSize);
+}
+
+void Application::CreateWritableBackbuffer(std::uint32_t width, std::uint32_t height)
+{
+    writableBackbufferWidth_  = width;
+    writableBackbufferHeight_ = height;
+
+    // Only the width x height region is rendered to, re-use current backbuffer if it is large enough
+    if (FitsRenderTargetBucket(writableBackbuffer_.Get(), width, height)) {
+        return;
+    }
+
+    // Frames in flight may still use the current backbuffer
+    device_->DeferRelease(std::move(writableBackbuffer_));
+    writableBackbuffer_ = CreateUnorderedAccessTexture(
+        GetRenderTargetBucketSize(width), GetRenderTargetBucketSize(height), 0);
+
+    CreatePreviewDescriptor();
+}
+
+void Application::CreateScratchBuffer()
+{
+    scratchBuffer_.Reset();
+    scratchBuffer_ = CreateUnorderedAccessBuffer(ScratchBufferElementCount, 1);
+}
+
+void Application::CreatePersistentScratchBuffer()
+{
+    persistentScratchBuffer_.Reset();
+    persistentScratchBuffer_ = CreateUnorderedAccessBuffer(PersistentScratchBufferElementCount, 2);
+}
+
+void Application::CreateDispatchBudgetBuffer()
+{
+    dispatchBudgetBuffer_ = CreateUnorderedAccessBuffer(DispatchBudgetBufferSize / sizeof(std::uint32_t), 6);
+
+    // One readback slot per frame in flight, persistently mapped
+    CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_READBACK);
+    CD3DX12_RESOURCE_DESC   resourceDesc =
+        CD3DX12_RESOURCE_DESC::Buffer(DispatchBudgetBufferSize * Device::BufferedFramesCount);
+    ThrowIfFailed(device_->GetDevice()->CreateCommittedResource(&heapProperties,
+                                                                D3D12_HEAP_FLAG_NONE,
+                                                                &resourceDesc,
+                                                                D3D12_RESOURCE_STATE_COPY_DEST,
+                                                                nullptr,
+                                                                IID_PPV_ARGS(&dispatchBudgetReadbackBuffer_)));
+
+    void* data = nullptr;
+    ThrowIfFailed(dispatchBudgetReadbackBuffer_->Map(0, nullptr, &data));
+    dispatchBudgetReadback_ = static_cast<const std::uint32_t*>(data);
+}
+
+void Application::ReadbackDispatchBudget(ID3D12GraphicsCommandList10* commandList)
+{
+    auto barrier = CD3DX12_RESOURCE_BARRIER::Transition(
+        dispatchBudgetBuffer_.Get(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE);
+    commandList->ResourceBarrier(1, &barrier);
+
+    commandList->CopyBufferRegion(dispatchBudgetReadbackBuffer_.Get(),
+                                  device_->GetFrameIndex() * DispatchBudgetBufferSize,
+                                  dispatchBudgetBuffer_.Get(),
+                                  0,
+                                  DispatchBudgetBufferSize);
+
+    std::swap(barrier.Transition.StateBefore, barrier.Transition.StateAfter);
+    commandList->ResourceBarrier(1, &barrier);
+}
+
+void Application::CheckDispatchBudget()
+{
+    if (dispatchBudget_ == 0) {
+        return;
     }
 
-    // Message window at bottom
-    {
-        ImGui::SetNextWindowPos(ImVec2(window_->GetWidth(), window_->GetHeight()), ImGuiCond_Always, ImVec2(1, 1));
+    // Device waited for the frame that previously used the current frame context, thus its counters are available.
+    // Consume increments the counter even if the budget is exhausted.
+    const auto* counters =
+        dispatchBudgetReadback_ + device_->GetFrameIndex() * (DispatchBudgetBufferSize / sizeof(std::uint32_t));
+    // Counters of main view (or left half of split screen) and right half of split screen
+    const bool  exceeded = (counters[0] > dispatchBudget_) ||
+                          (counters[DispatchBudgetBufferSize / 2 / sizeof(std::uint32_t)] > dispatchBudget_);
+
+    if (exceeded && !dispatchBudgetExceeded_) {
+        Log::Warning() << "Work graph exceeded its dispatch budget of " << dispatchBudget_
+                       << " watchdog::Consume calls. Check for infinite loops or unbounded recursion.";
+    }
 
-        if (ImGui::Begin("bottom",
-                         nullptr,
-                         ImGuiWindowFlags_NoBackground | ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoDecoration |
-                             ImGuiWindowFlags_NoInputs))
-        {
-            ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0, 0, 0, 1));
-            ImGui::Text("Work Graph Playground by AMD & HS Coburg");
-            ImGui::PopStyleColor();
+    dispatchBudgetExceeded_ = exceeded;
+}
+
+void Application::SaveLastGoodWorkGraph()
+{
+    if (lastGoodWorkGraphFile_.empty() || (lastGoodWorkGraphGeneration_ == workGraphGeneration_)) {
+        return;
+    }
+
+    lastGoodWorkGraphGeneration_ = workGraphGeneration_;
+
+    LastGoodWorkGraph lastGood = {
+        .tutorialIndex  = workGraph_->GetTutorialIndex(),
+        .sampleSolution = workGraph_->IsSampleSolution(),
+        .shaderFileName = WorkGraph::GetShaderFileName(workGraph_->GetTutorialIndex(), workGraph_->IsSampleSolution()),
+        .library        = workGraph_->GetLibraries().front(),
+    };
+
+    // Work graph is only stored once the GPU finished the current frame, i.e. if it did not hang the GPU
+    device_->OnCompleted([lastGood = std::move(lastGood), file = lastGoodWorkGraphFile_]() {
+        try {
+            lastGood.Save(file);
+        } catch (const std::exception& e) {
+            Log::Warning() << "Failed to write last good work graph:\n" << e.what();
         }
+    });
+}
 
-        ImGui::End();
+bool Application::BeginRecordTrace(ID3D12GraphicsCommandList10* commandList)
+{
+    using namespace std::chrono_literals;
+
+    // Previous capture is still read back or written. The request is kept until both have finished, such that the
+    // render thread never waits for the writer of the previous capture.
+    const bool writerBusy =
+        recordTraceWriter_.valid() && (recordTraceWriter_.wait_for(0s) != std::future_status::ready);
+
+    if (!recordTraceRequested_ || recordTracePending_ || writerBusy) {
+        return false;
     }
 
-    // Render to render target
-    {
-        // Set swapchain render target
-        commandList->OMSetRenderTargets(
-            1, &renderTarget.colorDescriptorHandle, false, &renderTarget.depthDescriptorHandle);
+    recordTraceRequested_ = false;
 
-        // Bind UI descriptor heap
-        commandList->SetDescriptorHeaps(1, uiDescriptorHeap_.GetAddressOf());
+    if (recordTraceOptions_.capacity == 0) {
+        Log::Warning() << "Record trace capacity is zero.";
+        return false;
+    }
 
-        ImGui::Render();
-        ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), commandList);
+    const auto bufferSize =
+        RecordTrace::HeaderSize + std::uint64_t(recordTraceOptions_.capacity) * sizeof(RecordTraceEvent);
+
+    if (!recordTraceBuffer_) {
+        recordTraceBuffer_ =
+            CreateUnorderedAccessBuffer(static_cast<std::uint32_t>(bufferSize / sizeof(std::uint32_t)), 7);
+        UpdateResourceDescriptors();
+
+        CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_READBACK);
+        CD3DX12_RESOURCE_DESC   resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(bufferSize);
+        ThrowIfFailed(device_->GetDevice()->CreateCommittedResource(&heapProperties,
+                                                                    D3D12_HEAP_FLAG_NONE,
+                                                                    &resourceDesc,
+                                                                    D3D12_RESOURCE_STATE_COPY_DEST,
+                                                                    nullptr,
+                                                                    IID_PPV_ARGS(&recordTraceReadbackBuffer_)));
     }
+
+    ClearUnorderedAccessBuffer(commandList, recordTraceBuffer_.Get(), 7);
+
+    const auto barrier = CD3DX12_RESOURCE_BARRIER::UAV(recordTraceBuffer_.Get());
+    commandList->ResourceBarrier(1, &barrier);
+
+    recordTraceCapacity_ = recordTraceOptions_.capacity;
+
+    return true;
 }
 
-void Application::OnResize(std::uint32_t width, std::uint32_t height)
+void Application::EndRecordTrace(ID3D12GraphicsCommandList10* commandList)
 {
-    // Wait for all frames in flight
-    device_->WaitForDevice();
+    recordTraceCapacity_ = 0;
+    recordTracePending_  = true;
 
-    swapchain_->Resize(width, height);
+    const auto bufferSize =
+        RecordTrace::HeaderSize + std::uint64_t(recordTraceOptions_.capacity) * sizeof(RecordTraceEvent);
 
-    CreateWritableBackbuffer(width, height);
+    auto barrier = CD3DX12_RESOURCE_BARRIER::Transition(
+        recordTraceBuffer_.Get(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE);
+    commandList->ResourceBarrier(1, &barrier);
+
+    commandList->CopyBufferRegion(recordTraceReadbackBuffer_.Get(), 0, recordTraceBuffer_.Get(), 0, bufferSize);
+
+    std::swap(barrier.Transition.StateBefore, barrier.Transition.StateAfter);
+    commandList->ResourceBarrier(1, &barrier);
+
+    const auto shaderFileName =
+        WorkGraph::GetShaderFileName(workGraph_->GetTutorialIndex(), workGraph_->IsSampleSolution());
+
+    RecordTraceCapture capture = {
+        .shaderFileName     = shaderFileName,
+        .frame              = frameCount_,
+        .appendedEventCount = 0,
+        .events             = {},
+        .nodeNames          = RecordTrace::ReadNodeNames(shaderCompiler_.GetShaderSourceFilePath(shaderFileName)),
+    };
+
+    device_->OnCompleted([this, capture = std::move(capture)]() mutable {
+        const Trace::Scope traceScope("Application::ReadbackRecordTrace");
+
+        // Further captures are refused while a capture is pending, thus it is reset even if the readback fails
+        recordTracePending_ = false;
+
+        try {
+            void* data = nullptr;
+            ThrowIfFailed(recordTraceReadbackBuffer_->Map(0, nullptr, &data));
+
+            std::uint32_t appendedEventCount;
+            std::memcpy(&appendedEventCount, data, sizeof(appendedEventCount));
+
+            capture.appendedEventCount = appendedEventCount;
+            capture.events.resize(std::min(appendedEventCount, recordTraceOptions_.capacity));
+            std::memcpy(capture.events.data(),
+                        static_cast<const std::uint8_t*>(data) + RecordTrace::HeaderSize,
+                        capture.events.size() * sizeof(RecordTraceEvent));
+
+            const D3D12_RANGE writtenRange = {0, 0};
+            recordTraceReadbackBuffer_->Unmap(0, &writtenRange);
+        } catch (const std::exception& e) {
+            Log::Error() << "Failed to read back record trace:\n" << e.what();
+            return;
+        }
+
+        // Execution tree is rebuilt and written on a worker thread, as large captures take a while.
+        // Captures only begin once the previous writer has finished, thus replacing its future does not block.
+        recordTraceWriter_ = std::async(
+            std::launch::async, [capture = std::move(capture), file = recordTraceOptions_.outputFile]() {
+                if (capture.events.empty()) {
+                    Log::Warning() << "Record trace of \"" << capture.shaderFileName
+                                   << "\" is empty. Instrument nodes with the recordtrace helpers of Common.h "
+                                      "and enable their instrumentation (e.g. RECORD_TRACE).";
+                    return;
+                }
+
+                try {
+                    const auto tree = RecordTrace::BuildTree(capture);
+
+                    if (file.extension() == ".json") {
+                        RecordTrace::WritePerfettoJson(file, capture, tree);
+                    } else {
+                        RecordTrace::WriteCapture(file, capture);
+                    }
+
+                    std::stringstream summary;
+                    RecordTrace::WriteSummary(summary, capture, tree);
+
+                    Log::Info() << "Record trace written to " << file.string() << "\n" << summary.str();
+                } catch (const std::exception& e) {
+                    Log::Warning() << "Failed to write record trace:\n" << e.what();
+                }
+            });
+    });
 }
 
-void Application::CreateImGuiContext()
+bool Application::BeginMaxRecordsProfiling(ID3D12GraphicsCommandList10* commandList)
 {
-    IMGUI_CHECKVERSION();
-    ImGui::CreateContext();
-    ImGuiIO& io = ImGui::GetIO();
-    io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
-    io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;
+    if (!maxRecordsProfiling_) {
+        return false;
+    }
 
-    // Disbale ini and log files
-    io.IniFilename = nullptr;
-    io.LogFilename = nullptr;
+    if (!maxRecordsBuffer_) {
+        maxRecordsBuffer_ = CreateUnorderedAccessBuffer(MaxRecordsBufferSize / sizeof(std::uint32_t), 8);
+        UpdateResourceDescriptors();
+
+        CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_READBACK);
+        CD3DX12_RESOURCE_DESC   resourceDesc =
+            CD3DX12_RESOURCE_DESC::Buffer(MaxRecordsBufferSize * Device::BufferedFramesCount);
+        ThrowIfFailed(device_->GetDevice()->CreateCommittedResource(&heapProperties,
+                                                                    D3D12_HEAP_FLAG_NONE,
+                                                                    &resourceDesc,
+                                                                    D3D12_RESOURCE_STATE_COPY_DEST,
+                                                                    nullptr,
+                                                                    IID_PPV_ARGS(&maxRecordsReadbackBuffer_)));
+
+        void* data = nullptr;
+        ThrowIfFailed(maxRecordsReadbackBuffer_->Map(0, nullptr, &data));
+        maxRecordsReadback_ = static_cast<const std::uint32_t*>(data);
+    }
 
-    // Create descriptor heap for ImGui
-    {
-        D3D12_DESCRIPTOR_HEAP_DESC desc = {};
-        desc.Type                       = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-        desc.NumDescriptors             = 1;
-        desc.Flags                      = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-        desc.NodeMask                   = 1;
-        ThrowIfFailed(device_->GetDevice()->CreateDescriptorHeap(&desc, IID_PPV_ARGS(&uiDescriptorHeap_)));
+    // Device waited for the frame that previously used the current frame context, thus its peaks are available
+    MergeMaxRecordsPeaks(device_->GetFrameIndex());
+
+    if (maxRecordsWorkGraphGeneration_ != workGraphGeneration_) {
+        maxRecordsWorkGraphGeneration_ = workGraphGeneration_;
+        resetMaxRecordsPeaks_          = true;
     }
 
-    // Setup Platform/Renderer backends
-    ImGui_ImplWin32_Init(window_->GetHandle());
-    ImGui_ImplDX12_Init(device_->GetDevice(),
-                        Device::BufferedFramesCount,
-                        Swapchain::ColorTargetFormat,
-                        uiDescriptorHeap_.Get(),
-                        uiDescriptorHeap_->GetCPUDescriptorHandleForHeapStart(),
-                        uiDescriptorHeap_->GetGPUDescriptorHandleForHeapStart());
+    if (resetMaxRecordsPeaks_) {
+        resetMaxRecordsPeaks_ = false;
+
+        ++maxRecordsPeakGeneration_;
+        maxRecordsPeaks_.fill(0);
+
+        ClearUnorderedAccessBuffer(commandList, maxRecordsBuffer_.Get(), 8);
+
+        const auto barrier = CD3DX12_RESOURCE_BARRIER::UAV(maxRecordsBuffer_.Get());
+        commandList->ResourceBarrier(1, &barrier);
+    }
+
+    maxRecordsProbeCount_ = MaxRecordsAdvisor::MaxProbeCount;
+
+    return true;
 }
 
-void Application::DestroyImGuiContext()
+void Application::EndMaxRecordsProfiling(ID3D12GraphicsCommandList10* commandList)
 {
-    ImGui_ImplDX12_Shutdown();
-    ImGui_ImplWin32_Shutdown();
-    ImGui::DestroyContext();
+    maxRecordsProbeCount_ = 0;
+
+    const auto frameIndex = device_->GetFrameIndex();
+
+    auto barrier = CD3DX12_RESOURCE_BARRIER::Transition(
+        maxRecordsBuffer_.Get(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE);
+    commandList->ResourceBarrier(1, &barrier);
+
+    commandList->CopyBufferRegion(maxRecordsReadbackBuffer_.Get(),
+                                  frameIndex * MaxRecordsBufferSize,
+                                  maxRecordsBuffer_.Get(),
+                                  0,
+                                  MaxRecordsBufferSize);
+
+    std::swap(barrier.Transition.StateBefore, barrier.Transition.StateAfter);
+    commandList->ResourceBarrier(1, &barrier);
+
+    maxRecordsReadbackGeneration_[frameIndex] = maxRecordsPeakGeneration_;
 }
 
-void Application::CreateWorkGraphRootSignature()
+void Application::MergeMaxRecordsPeaks(const std::uint32_t frameIndex)
 {
-    const auto descriptorRange = CD3DX12_DESCRIPTOR_RANGE(D3D12_DESCRIPTOR_RANGE_TYPE_UAV, 3, 0);
-
-    std::array<CD3DX12_ROOT_PARAMETER, 3> rootParameters;
-    rootParameters[0].InitAsConstants(6, 0);
-    rootParameters[1].InitAsShaderResourceView(0);
-    rootParameters[2].InitAsDescriptorTable(1, &descriptorRange);
+    if (!maxRecordsReadback_ || (maxRecordsReadbackGeneration_[frameIndex] != maxRecordsPeakGeneration_)) {
+        return;
+    }
 
-    CD3DX12_ROOT_SIGNATURE_DESC rootSignatureDesc;
-    rootSignatureDesc.Init(rootParameters.size(), rootParameters.data(), 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+    const auto* peaks = maxRecordsReadback_ + frameIndex * MaxRecordsAdvisor::MaxProbeCount;
 
-    ComPtr<ID3DBlob> signature;
-    ComPtr<ID3DBlob> error;
-    ThrowIfFailed(D3D12SerializeRootSignature(&rootSignatureDesc, D3D_ROOT_SIGNATURE_VERSION_1, &signature, &error));
-    ThrowIfFailed(device_->GetDevice()->CreateRootSignature(
-        0, signature->GetBufferPointer(), signature->GetBufferSize(), IID_PPV_ARGS(&workGraphRootSignature_)));
+    for (std::uint32_t probe = 0; probe < MaxRecordsAdvisor::MaxProbeCount; ++probe) {
+        maxRecordsPeaks_[probe] = std::max(maxRecordsPeaks_[probe], peaks[probe]);
+    }
 }
 
-bool Application::CreateWorkGraph()
+void Application::WriteMaxRecordsReport()
 {
-    // Wait for all frames in fight before deleting old resources
-    device_->WaitForDevice();
+    const Trace::Scope traceScope("Application::WriteMaxRecordsReport");
+
+    const auto shaderFileName =
+        WorkGraph::GetShaderFileName(workGraph_->GetTutorialIndex(), workGraph_->IsSampleSolution());
+
+    // Peaks are only reset while profiling, thus they may belong to a previous work graph
+    if (maxRecordsWorkGraphGeneration_ != workGraphGeneration_) {
+        Log::Warning() << "MaxRecords of \"" << shaderFileName << "\" were not profiled.";
+        return;
+    }
 
     try {
-        workGraph_ = std::make_unique<WorkGraph>(device_.get(),
-                                                 shaderCompiler_,
-                                                 workGraphRootSignature_.Get(),
-                                                 workGraphTutorialIndex_,
-                                                 workGraphUseSampleSolution_);
-    } catch (const std::exception& e) {
-        // Re-throw exception if no fallback work graph exists
-        if (!workGraph_) {
-            throw e;
+        const auto    sourcePath = shaderCompiler_.GetShaderSourceFilePath(shaderFileName);
+        std::ifstream sourceFile(sourcePath, std::ios::binary);
+        if (!sourceFile) {
+            throw std::runtime_error("Failed to open shader file \"" + sourcePath.string() + "\"");
         }
 
-        std::cerr << "Failed to re-create work graph:\n" << e.what() << std::endl;
+        std::stringstream sourceStream;
+        sourceStream << sourceFile.rdbuf();
+        const auto source = sourceStream.str();
 
-        return false;
+        const auto probes = MaxRecordsAdvisor::ReadProbes(source);
+        if (probes.empty()) {
+            Log::Warning() << "\"" << shaderFileName
+                           << "\" has no MaxRecords probes. Annotate [MaxRecords(...)] declarations with "
+                              "@MaxRecordsProbe, see Common.h.";
+            return;
+        }
+
+        // Backing memory is measured with the same compiler options for the declared and the suggested bounds
+        const auto declaredSize = GetBackingMemorySize(shaderFileName, source, {}, {});
+
+        std::vector<MaxRecordsAdvice> advice;
+        std::vector<std::uint32_t>    suggestedBounds;
+
+        for (const auto& probe : probes) {
+            const auto peakRecords         = maxRecordsPeaks_[probe.id];
+            const auto suggestedMaxRecords = MaxRecordsAdvisor::GetSuggestedMaxRecords(peakRecords);
+            const auto size = GetBackingMemorySize(shaderFileName, source, {probe}, {suggestedMaxRecords});
+
+            advice.emplace_back(MaxRecordsAdvice{
+                .probe               = probe,
+                .peakRecords         = peakRecords,
+                .suggestedMaxRecords = suggestedMaxRecords,
+                .backingMemorySaving = static_cast<std::int64_t>(declaredSize) - static_cast<std::int64_t>(size),
+            });
+            suggestedBounds.emplace_back(suggestedMaxRecords);
+        }
+
+        const auto suggestedSize = GetBackingMemorySize(shaderFileName, source, probes, suggestedBounds);
+
+        std::ofstream report(maxRecordsReportFile_, std::ios::trunc);
+        if (!report) {
+            throw std::runtime_error("Failed to open MaxRecords report file \"" + maxRecordsReportFile_.string() +
+                                     "\"");
+        }
+
+        MaxRecordsAdvisor::WriteReportHeader(report);
+        MaxRecordsAdvisor::WriteReport(report, shaderFileName, advice);
+
+        Log::Info() << "MaxRecords report written to " << maxRecordsReportFile_.string()
+                    << ". Backing memory with suggested bounds: " << suggestedSize << " bytes (declared bounds: "
+                    << declaredSize << " bytes).";
+    } catch (const std::exception& e) {
+        Log::Error() << "Failed to write MaxRecords report:\n" << e.what();
     }
+}
 
-    return true;
+std::uint64_t Application::GetBackingMemorySize(const std::string&                  shaderFileName,
+                                                const std::string&                  source,
+                                                const std::vector<MaxRecordsProbe>& probes,
+                                                const std::vector<std::uint32_t>&   maxRecords)
+{
+    // Variant is compiled from memory with the name of the shader file, such that relative includes are resolved
+    const auto request = shaderCompiler_.CreateCompileRequest(shaderFileName, L"lib_6_8", nullptr);
+    const auto result  = shaderCompiler_.Compile(request, MaxRecordsAdvisor::ApplyBounds(source, probes, maxRecords));
+
+    if (!result.success) {
+        throw std::runtime_error("Failed to compile MaxRecords variant of shader \"" + shaderFileName + "\":\n" +
+                                 result.messages);
+    }
+
+    // Only the state object is created, backing memory of the variant is never allocated
+    return WorkGraph::QueryMemoryRequirements(device_.get(), result.blob.Get(), workGraphRootSignature_.Get())
+        .MaxSizeInBytes;
 }
 
-void Application::CreateResourceDescriptorHeaps()
+void Application::CreateSplitScreenResources(std::uint32_t width, std::uint32_t height)
 {
-    // Create descriptor heap to clear shader resources
-    {
-        D3D12_DESCRIPTOR_HEAP_DESC desc = {};
-        desc.Type                       = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-        desc.NumDescriptors             = 3;
-        desc.Flags                      = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
-        desc.NodeMask                   = 1;
-        ThrowIfFailed(device_->GetDevice()->CreateDescriptorHeap(&desc, IID_PPV_ARGS(&clearDescriptorHeap_)));
+    if (!FitsRenderTargetBucket(splitBackbuffer_.Get(), width, height)) {
+        device_->DeferRelease(std::move(splitBackbuffer_));
+        splitBackbuffer_ = CreateUnorderedAccessTexture(
+            GetRenderTargetBucketSize(width), GetRenderTargetBucketSize(height), 3);
     }
-    // Create resource descriptor heap for shader resources
-    {
-        D3D12_DESCRIPTOR_HEAP_DESC desc = {};
-        desc.Type                       = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-        desc.NumDescriptors             = 3;
-        desc.Flags                      = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-        desc.NodeMask                   = 1;
-        ThrowIfFailed(device_->GetDevice()->CreateDescriptorHeap(&desc, IID_PPV_ARGS(&resourceDescriptorHeap_)));
+
+    // Scratch buffers are only created once, as they do not depend on the window size
+    if (!splitScratchBuffer_) {
+        splitScratchBuffer_           = CreateUnorderedAccessBuffer(ScratchBufferElementCount, 4);
+        splitPersistentScratchBuffer_ = CreateUnorderedAccessBuffer(PersistentScratchBufferElementCount, 5);
     }
 }
 
-void Application::CreateWritableBackbuffer(std::uint32_t width, std::uint32_t height)
+ComPtr<ID3D12Resource> Application::CreateUnorderedAccessTexture(const std::uint32_t width,
+                                                                 const std::uint32_t height,
+                                                                 const std::uint32_t descriptorIndex)
 {
-    writableBackbuffer_.Reset();
+    ComPtr<ID3D12Resource> resource;
 
     CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_DEFAULT);
     CD3DX12_RESOURCE_DESC   resourceDescription = CD3DX12_RESOURCE_DESC::Tex2D(
@@ -555,7 +2846,7 @@ void Application::CreateWritableBackbuffer(std::uint32_t width, std::uint32_t he
                                                                 &resourceDescription,
                                                                 D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
                                                                 nullptr,
-                                                                IID_PPV_ARGS(&writableBackbuffer_)));
+                                                                IID_PPV_ARGS(&resource)));
 
     D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
     uavDesc.ViewDimension                    = D3D12_UAV_DIMENSION_TEXTURE2D;
@@ -565,72 +2856,26 @@ void Application::CreateWritableBackbuffer(std::uint32_t width, std::uint32_t he
 
     const auto descriptorSize =
         device_->GetDevice()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-    const auto descriptorIndex = 0;
 
     device_->GetDevice()->CreateUnorderedAccessView(
-        writableBackbuffer_.Get(),
+        resource.Get(),
         nullptr,
         &uavDesc,
         CD3DX12_CPU_DESCRIPTOR_HANDLE(
             clearDescriptorHeap_->GetCPUDescriptorHandleForHeapStart(), descriptorIndex, descriptorSize));
-    device_->GetDevice()->CreateUnorderedAccessView(
-        writableBackbuffer_.Get(),
-        nullptr,
-        &uavDesc,
-        CD3DX12_CPU_DESCRIPTOR_HANDLE(
-            resourceDescriptorHeap_->GetCPUDescriptorHandleForHeapStart(), descriptorIndex, descriptorSize));
-}
-
-void Application::CreateScratchBuffer()
-{
-    scratchBuffer_.Reset();
-
-    const auto elementCount = 100 * 1024;
-    const auto elementSize  = sizeof(std::uint32_t);
-
-    CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_DEFAULT);
-    CD3DX12_RESOURCE_DESC   resourceDescription =
-        CD3DX12_RESOURCE_DESC::Buffer(elementCount * elementSize, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
-    ThrowIfFailed(device_->GetDevice()->CreateCommittedResource(&heapProperties,
-                                                                D3D12_HEAP_FLAG_NONE,
-                                                                &resourceDescription,
-                                                                D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
-                                                                nullptr,
-                                                                IID_PPV_ARGS(&scratchBuffer_)));
-
-    D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
-    uavDesc.ViewDimension                    = D3D12_UAV_DIMENSION_BUFFER;
-    uavDesc.Format                           = DXGI_FORMAT_R32_TYPELESS;
-    uavDesc.Buffer.CounterOffsetInBytes      = 0;
-    uavDesc.Buffer.FirstElement              = 0;
-    uavDesc.Buffer.NumElements               = elementCount;
-    uavDesc.Buffer.StructureByteStride       = 0;
-    uavDesc.Buffer.Flags                     = D3D12_BUFFER_UAV_FLAG_RAW;
 
-    const auto descriptorSize =
-        device_->GetDevice()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-    const auto descriptorIndex = 1;
+    // Shader visible descriptors are updated before their next use
+    resourceDescriptorsChanged_ = true;
 
-    device_->GetDevice()->CreateUnorderedAccessView(
-        scratchBuffer_.Get(),
-        nullptr,
-        &uavDesc,
-        CD3DX12_CPU_DESCRIPTOR_HANDLE(
-            clearDescriptorHeap_->GetCPUDescriptorHandleForHeapStart(), descriptorIndex, descriptorSize));
-    device_->GetDevice()->CreateUnorderedAccessView(
-        scratchBuffer_.Get(),
-        nullptr,
-        &uavDesc,
-        CD3DX12_CPU_DESCRIPTOR_HANDLE(
-            resourceDescriptorHeap_->GetCPUDescriptorHandleForHeapStart(), descriptorIndex, descriptorSize));
+    return resource;
 }
 
-void Application::CreatePersistentScratchBuffer()
+ComPtr<ID3D12Resource> Application::CreateUnorderedAccessBuffer(const std::uint32_t elementCount,
+                                                                const std::uint32_t descriptorIndex)
 {
-    persistentScratchBuffer_.Reset();
+    ComPtr<ID3D12Resource> resource;
 
-    const auto elementCount = 100 * 1024 * 1024;
-    const auto elementSize  = sizeof(std::uint32_t);
+    const auto elementSize = sizeof(std::uint32_t);
 
     CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_DEFAULT);
     CD3DX12_RESOURCE_DESC   resourceDescription =
@@ -640,7 +2885,7 @@ void Application::CreatePersistentScratchBuffer()
                                                                 &resourceDescription,
                                                                 D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
                                                                 nullptr,
-                                                                IID_PPV_ARGS(&persistentScratchBuffer_)));
+                                                                IID_PPV_ARGS(&resource)));
 
     D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
     uavDesc.ViewDimension                    = D3D12_UAV_DIMENSION_BUFFER;
@@ -653,82 +2898,135 @@ void Application::CreatePersistentScratchBuffer()
 
     const auto descriptorSize =
         device_->GetDevice()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-    const auto descriptorIndex = 2;
 
     device_->GetDevice()->CreateUnorderedAccessView(
-        persistentScratchBuffer_.Get(),
+        resource.Get(),
         nullptr,
         &uavDesc,
         CD3DX12_CPU_DESCRIPTOR_HANDLE(
             clearDescriptorHeap_->GetCPUDescriptorHandleForHeapStart(), descriptorIndex, descriptorSize));
-    device_->GetDevice()->CreateUnorderedAccessView(
-        persistentScratchBuffer_.Get(),
-        nullptr,
-        &uavDesc,
-        CD3DX12_CPU_DESCRIPTOR_HANDLE(
-            resourceDescriptorHeap_->GetCPUDescriptorHandleForHeapStart(), descriptorIndex, descriptorSize));
+
+    // Shader visible descriptors are updated before their next use
+    resourceDescriptorsChanged_ = true;
+
+    return resource;
 }
 
 void Application::ClearShaderResources(ID3D12GraphicsCommandList10* commandList)
 {
-    // Set descriptor heap for clear
-    commandList->SetDescriptorHeaps(1, resourceDescriptorHeap_.GetAddressOf());
+    // Clear is the first command of every frame. All descriptors are in a single heap, which is bound once for the
+    // entire command list.
+    ID3D12DescriptorHeap* descriptorHeap = descriptorHeap_->GetHeap();
+    commandList->SetDescriptorHeaps(1, &descriptorHeap);
 
-    const auto descriptorSize =
-        device_->GetDevice()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    UpdateResourceDescriptors();
 
     // Clear writable backbuffer
-    {
-        const auto descriptorIndex     = 0;
-        const auto gpuDescriptorHandle = CD3DX12_GPU_DESCRIPTOR_HANDLE(
-            resourceDescriptorHeap_->GetGPUDescriptorHandleForHeapStart(), descriptorIndex, descriptorSize);
-        const auto cpuDescriptorHandle = CD3DX12_CPU_DESCRIPTOR_HANDLE(
-            clearDescriptorHeap_->GetCPUDescriptorHandleForHeapStart(), descriptorIndex, descriptorSize);
-
-        float clearValue[4] = {1.f, 1.f, 1.f, 1.f};
-        commandList->ClearUnorderedAccessViewFloat(
-            gpuDescriptorHandle, cpuDescriptorHandle, writableBackbuffer_.Get(), clearValue, 0, nullptr);
-    }
-
+    ClearUnorderedAccessTexture(commandList, writableBackbuffer_.Get(), 0);
     // Clear scratch buffer
-    {
-        const auto descriptorIndex     = 1;
-        const auto gpuDescriptorHandle = CD3DX12_GPU_DESCRIPTOR_HANDLE(
-            resourceDescriptorHeap_->GetGPUDescriptorHandleForHeapStart(), descriptorIndex, descriptorSize);
-        const auto cpuDescriptorHandle = CD3DX12_CPU_DESCRIPTOR_HANDLE(
-            clearDescriptorHeap_->GetCPUDescriptorHandleForHeapStart(), descriptorIndex, descriptorSize);
-
-        std::uint32_t clearValue[4] = {0, 0, 0, 0};
-        commandList->ClearUnorderedAccessViewUint(
-            gpuDescriptorHandle, cpuDescriptorHandle, scratchBuffer_.Get(), clearValue, 0, nullptr);
-    }
+    ClearUnorderedAccessBuffer(commandList, scratchBuffer_.Get(), 1);
 
     // Clear persistent scratch buffer
     if (clearPersistentScratchBuffer_) {
-        const auto descriptorIndex     = 2;
-        const auto gpuDescriptorHandle = CD3DX12_GPU_DESCRIPTOR_HANDLE(
-            resourceDescriptorHeap_->GetGPUDescriptorHandleForHeapStart(), descriptorIndex, descriptorSize);
-        const auto cpuDescriptorHandle = CD3DX12_CPU_DESCRIPTOR_HANDLE(
-            clearDescriptorHeap_->GetCPUDescriptorHandleForHeapStart(), descriptorIndex, descriptorSize);
-
-        std::uint32_t clearValue[4] = {0, 0, 0, 0};
-        commandList->ClearUnorderedAccessViewUint(
-            gpuDescriptorHandle, cpuDescriptorHandle, persistentScratchBuffer_.Get(), clearValue, 0, nullptr);
+        ClearUnorderedAccessBuffer(commandList, persistentScratchBuffer_.Get(), 2);
 
         // Reset clear
         clearPersistentScratchBuffer_ = false;
     }
 
-    std::array<D3D12_RESOURCE_BARRIER, 3> uavBarriers = {
+    // Clear dispatch budget counters
+    ClearUnorderedAccessBuffer(commandList, dispatchBudgetBuffer_.Get(), 6);
+
+    std::array<D3D12_RESOURCE_BARRIER, 4> uavBarriers = {
         CD3DX12_RESOURCE_BARRIER::UAV(writableBackbuffer_.Get()),
         CD3DX12_RESOURCE_BARRIER::UAV(scratchBuffer_.Get()),
         CD3DX12_RESOURCE_BARRIER::UAV(persistentScratchBuffer_.Get()),
+        CD3DX12_RESOURCE_BARRIER::UAV(dispatchBudgetBuffer_.Get()),
     };
 
     // Barrier for clear operation
     commandList->ResourceBarrier(uavBarriers.size(), uavBarriers.data());
 }
 
+void Application::ClearSplitScreenResources(ID3D12GraphicsCommandList10* commandList)
+{
+    UpdateResourceDescriptors();
+
+    ClearUnorderedAccessTexture(commandList, splitBackbuffer_.Get(), 3);
+    ClearUnorderedAccessBuffer(commandList, splitScratchBuffer_.Get(), 4);
+
+    if (clearSplitPersistentScratchBuffer_) {
+        ClearUnorderedAccessBuffer(commandList, splitPersistentScratchBuffer_.Get(), 5);
+
+        clearSplitPersistentScratchBuffer_ = false;
+    }
+
+    std::array<D3D12_RESOURCE_BARRIER, 3> uavBarriers = {
+        CD3DX12_RESOURCE_BARRIER::UAV(splitBackbuffer_.Get()),
+        CD3DX12_RESOURCE_BARRIER::UAV(splitScratchBuffer_.Get()),
+        CD3DX12_RESOURCE_BARRIER::UAV(splitPersistentScratchBuffer_.Get()),
+    };
+
+    commandList->ResourceBarrier(uavBarriers.size(), uavBarriers.data());
+}
+
+void Application::ClearUnorderedAccessTexture(ID3D12GraphicsCommandList10* commandList,
+                                              ID3D12Resource*              resource,
+                                              const std::uint32_t          descriptorIndex)
+{
+    const auto descriptorSize =
+        device_->GetDevice()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+    const auto gpuDescriptorHandle = GetResourceDescriptorHandle(descriptorIndex);
+    const auto cpuDescriptorHandle = CD3DX12_CPU_DESCRIPTOR_HANDLE(
+        clearDescriptorHeap_->GetCPUDescriptorHandleForHeapStart(), descriptorIndex, descriptorSize);
+
+    float clearValue[4] = {1.f, 1.f, 1.f, 1.f};
+    commandList->ClearUnorderedAccessViewFloat(
+        gpuDescriptorHandle, cpuDescriptorHandle, resource, clearValue, 0, nullptr);
+}
+
+void Application::ClearUnorderedAccessBuffer(ID3D12GraphicsCommandList10* commandList,
+                                             ID3D12Resource*              resource,
+                                             const std::uint32_t          descriptorIndex)
+{
+    const auto descriptorSize =
+        device_->GetDevice()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+    const auto gpuDescriptorHandle = GetResourceDescriptorHandle(descriptorIndex);
+    const auto cpuDescriptorHandle = CD3DX12_CPU_DESCRIPTOR_HANDLE(
+        clearDescriptorHeap_->GetCPUDescriptorHandleForHeapStart(), descriptorIndex, descriptorSize);
+
+    std::uint32_t clearValue[4] = {0, 0, 0, 0};
+    commandList->ClearUnorderedAccessViewUint(
+        gpuDescriptorHandle, cpuDescriptorHandle, resource, clearValue, 0, nullptr);
+}
+
+void Application::UpdateResourceDescriptors()
+{
+    if (!resourceDescriptorsChanged_) {
+        return;
+    }
+
+    // Frames in flight may still use the current descriptors, thus changed descriptors are copied to a new range.
+    // The current range is returned to the descriptor heap once all frames that could have used it are done.
+    if (resourceDescriptorIndex_ != DescriptorHeap::InvalidIndex) {
+        descriptorHeap_->Free(resourceDescriptorIndex_, ResourceDescriptorCount);
+    }
+    resourceDescriptorIndex_    = descriptorHeap_->Allocate(ResourceDescriptorCount);
+    resourceDescriptorsChanged_ = false;
+
+    device_->GetDevice()->CopyDescriptorsSimple(ResourceDescriptorCount,
+                                                descriptorHeap_->GetCPUHandle(resourceDescriptorIndex_),
+                                                clearDescriptorHeap_->GetCPUDescriptorHandleForHeapStart(),
+                                                D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE Application::GetResourceDescriptorHandle(std::uint32_t descriptorIndex) const
+{
+    return descriptorHeap_->GetGPUHandle(resourceDescriptorIndex_ + descriptorIndex);
+}
+
 void Application::CreateFontBuffer()
 {
     fontBuffer_.Reset();
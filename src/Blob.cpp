@@ -0,0 +1,93 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "Blob.h"
+
+ComPtr<IDxcBlob> Blob::Create(std::vector<std::uint8_t> data)
+{
+    ComPtr<IDxcBlob> blob;
+    // Blob starts with a reference count of one, which is owned by the ComPtr
+    blob.Attach(new Blob(std::move(data)));
+    return blob;
+}
+
+ComPtr<IDxcBlob> Blob::CreateView(const void* data, const std::size_t size, std::shared_ptr<const void> owner)
+{
+    ComPtr<IDxcBlob> blob;
+    blob.Attach(new Blob(data, size, std::move(owner)));
+    return blob;
+}
+
+Blob::Blob(std::vector<std::uint8_t> data) : data_(std::move(data))
+{
+    pointer_ = data_.data();
+    size_    = data_.size();
+}
+
+Blob::Blob(const void* data, const std::size_t size, std::shared_ptr<const void> owner)
+    : pointer_(data), size_(size), owner_(std::move(owner))
+{
+}
+
+LPVOID STDMETHODCALLTYPE Blob::GetBufferPointer(void)
+{
+    // IDxcBlob does not distinguish between read-only and writable blobs
+    return const_cast<void*>(pointer_);
+}
+
+SIZE_T STDMETHODCALLTYPE Blob::GetBufferSize(void)
+{
+    return size_;
+}
+
+HRESULT STDMETHODCALLTYPE Blob::QueryInterface(REFIID riid, _COM_Outptr_ void __RPC_FAR* __RPC_FAR* ppvObject)
+{
+    if (ppvObject == nullptr) {
+        return E_POINTER;
+    }
+
+    if ((riid == __uuidof(IUnknown)) || (riid == __uuidof(IDxcBlob))) {
+        *ppvObject = static_cast<IDxcBlob*>(this);
+        AddRef();
+        return S_OK;
+    }
+
+    *ppvObject = nullptr;
+    return E_NOINTERFACE;
+}
+
+ULONG STDMETHODCALLTYPE Blob::AddRef(void)
+{
+    return ++refCount_;
+}
+
+ULONG STDMETHODCALLTYPE Blob::Release(void)
+{
+    const auto refCount = --refCount_;
+
+    if (refCount == 0) {
+        delete this;
+    }
+
+    return refCount;
+}
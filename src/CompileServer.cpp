@@ -0,0 +1,652 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "CompileServer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Blob.h"
+#include "Hash.h"
+#include "Log.h"
+#include "Trace.h"
+
+namespace {
+    // Increment when changing the message layout
+    constexpr std::uint32_t ProtocolVersion = 1;
+    // Upper limit for a single message, to reject corrupted length prefixes
+    constexpr std::uint32_t MaxMessageSize = 256 * 1024 * 1024;
+    constexpr DWORD         PipeBufferSize = 64 * 1024;
+
+    // Time a client waits for a compile result before giving up on the server
+    constexpr DWORD CompileTimeoutMs = 2 * 60 * 1000;
+    // Time a client waits for a launched server to accept connections
+    constexpr DWORD ServerLaunchTimeoutMs = 5 * 1000;
+
+    // Serializes messages as plain little-endian values. Strings & arrays are prefixed by their element count.
+    class MessageWriter {
+    public:
+        void Write(const void* data, const std::size_t size)
+        {
+            const auto* bytes = static_cast<const std::uint8_t*>(data);
+            data_.insert(data_.end(), bytes, bytes + size);
+        }
+
+        void Write(const std::uint32_t value)
+        {
+            Write(&value, sizeof(value));
+        }
+
+        void Write(const std::uint64_t value)
+        {
+            Write(&value, sizeof(value));
+        }
+
+        void Write(const std::string& value)
+        {
+            Write(static_cast<std::uint32_t>(value.size()));
+            Write(value.data(), value.size());
+        }
+
+        void Write(const std::wstring& value)
+        {
+            Write(static_cast<std::uint32_t>(value.size()));
+            Write(value.data(), value.size() * sizeof(wchar_t));
+        }
+
+        const std::vector<std::uint8_t>& GetData() const
+        {
+            return data_;
+        }
+
+    private:
+        std::vector<std::uint8_t> data_;
+    };
+
+    // Throws if message is truncated
+    class MessageReader {
+    public:
+        MessageReader(const std::vector<std::uint8_t>& data) : data_(data) {}
+
+        void Read(void* data, const std::size_t size)
+        {
+            if (size > (data_.size() - offset_)) {
+                throw std::runtime_error("Compile server message is truncated");
+            }
+
+            std::memcpy(data, data_.data() + offset_, size);
+            offset_ += size;
+        }
+
+        std::uint32_t ReadUint32()
+        {
+            std::uint32_t value;
+            Read(&value, sizeof(value));
+            return value;
+        }
+
+        std::uint64_t ReadUint64()
+        {
+            std::uint64_t value;
+            Read(&value, sizeof(value));
+            return value;
+        }
+
+        std::string ReadString()
+        {
+            std::string value(ReadUint32(), '\0');
+            Read(value.data(), value.size());
+            return value;
+        }
+
+        std::wstring ReadWideString()
+        {
+            // Check size before allocating
+            const auto length = ReadUint32();
+            if (length > (data_.size() - offset_) / sizeof(wchar_t)) {
+                throw std::runtime_error("Compile server message is truncated");
+            }
+
+            std::wstring value(length, L'\0');
+            Read(value.data(), value.size() * sizeof(wchar_t));
+            return value;
+        }
+
+        std::vector<std::uint8_t> ReadBytes()
+        {
+            const auto size = ReadUint32();
+            if (size > (data_.size() - offset_)) {
+                throw std::runtime_error("Compile server message is truncated");
+            }
+
+            std::vector<std::uint8_t> value(size);
+            Read(value.data(), value.size());
+            return value;
+        }
+
+    private:
+        const std::vector<std::uint8_t>& data_;
+        std::size_t                      offset_ = 0;
+    };
+
+    std::vector<std::uint8_t> SerializeRequest(const ShaderCompileRequest& request)
+    {
+        MessageWriter writer;
+
+        writer.Write(ProtocolVersion);
+        writer.Write(request.sourceFile.wstring());
+        writer.Write(request.includeDirectory.wstring());
+        writer.Write(request.target);
+        writer.Write(request.entryPoint);
+
+        writer.Write(static_cast<std::uint32_t>(request.arguments.size()));
+        for (const auto& argument : request.arguments) {
+            writer.Write(argument);
+        }
+
+        return writer.GetData();
+    }
+
+    ShaderCompileRequest DeserializeRequest(const std::vector<std::uint8_t>& message)
+    {
+        MessageReader reader(message);
+
+        if (reader.ReadUint32() != ProtocolVersion) {
+            throw std::runtime_error("Compile server protocol version mismatch");
+        }
+
+        ShaderCompileRequest request;
+
+        request.sourceFile       = reader.ReadWideString();
+        request.includeDirectory = reader.ReadWideString();
+        request.target           = reader.ReadWideString();
+        request.entryPoint       = reader.ReadWideString();
+
+        const auto argumentCount = reader.ReadUint32();
+        for (std::uint32_t i = 0; i < argumentCount; ++i) {
+            request.arguments.emplace_back(reader.ReadWideString());
+        }
+
+        return request;
+    }
+
+    std::vector<std::uint8_t> SerializeResult(const ShaderCompileResult& result)
+    {
+        MessageWriter writer;
+
+        writer.Write(static_cast<std::uint32_t>(result.success));
+        writer.Write(result.messages);
+
+        if (result.blob) {
+            writer.Write(static_cast<std::uint32_t>(result.blob->GetBufferSize()));
+            writer.Write(result.blob->GetBufferPointer(), result.blob->GetBufferSize());
+        } else {
+            writer.Write(std::uint32_t(0));
+        }
+
+        writer.Write(static_cast<std::uint32_t>(result.sourceFiles.size()));
+        for (const auto& sourceFile : result.sourceFiles) {
+            writer.Write(sourceFile.path.wstring());
+            writer.Write(sourceFile.contentHash);
+        }
+
+        return writer.GetData();
+    }
+
+    ShaderCompileResult DeserializeResult(const std::vector<std::uint8_t>& message)
+    {
+        MessageReader reader(message);
+
+        ShaderCompileResult result;
+
+        result.success  = reader.ReadUint32() != 0;
+        result.messages = reader.ReadString();
+
+        auto blobData = reader.ReadBytes();
+        if (!blobData.empty()) {
+            result.blob = Blob::Create(std::move(blobData));
+        }
+
+        const auto sourceFileCount = reader.ReadUint32();
+        for (std::uint32_t i = 0; i < sourceFileCount; ++i) {
+            auto path        = reader.ReadWideString();
+            auto contentHash = reader.ReadUint64();
+
+            result.sourceFiles.push_back({.path = std::move(path), .contentHash = contentHash});
+        }
+
+        return result;
+    }
+
+    // Reads or writes exactly "size" bytes. Pipes are opened for overlapped I/O to support timeouts.
+    bool TransferPipeData(HANDLE pipe, void* data, std::size_t size, const bool write, const DWORD timeoutMs)
+    {
+        auto* bytes = static_cast<std::uint8_t*>(data);
+
+        OVERLAPPED overlapped = {};
+        overlapped.hEvent     = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+
+        if (overlapped.hEvent == nullptr) {
+            return false;
+        }
+
+        bool success = true;
+
+        while (size > 0) {
+            const auto chunkSize = static_cast<DWORD>(std::min<std::size_t>(size, PipeBufferSize));
+
+            ResetEvent(overlapped.hEvent);
+
+            const BOOL started = write ? WriteFile(pipe, bytes, chunkSize, nullptr, &overlapped)
+                                       : ReadFile(pipe, bytes, chunkSize, nullptr, &overlapped);
+
+            if (!started && (GetLastError() != ERROR_IO_PENDING)) {
+                success = false;
+                break;
+            }
+
+            DWORD transferredSize = 0;
+            if (!GetOverlappedResultEx(pipe, &overlapped, &transferredSize, timeoutMs, FALSE)) {
+                if (GetLastError() == WAIT_TIMEOUT) {
+                    // Cancel pending operation and wait for it, as it still references "overlapped"
+                    CancelIoEx(pipe, &overlapped);
+                    GetOverlappedResult(pipe, &overlapped, &transferredSize, TRUE);
+                }
+
+                success = false;
+                break;
+            }
+
+            if (transferredSize == 0) {
+                success = false;
+                break;
+            }
+
+            bytes += transferredSize;
+            size -= transferredSize;
+        }
+
+        CloseHandle(overlapped.hEvent);
+
+        return success;
+    }
+
+    // Messages are prefixed by their size
+    bool WriteMessage(HANDLE pipe, const std::vector<std::uint8_t>& message)
+    {
+        auto size = static_cast<std::uint32_t>(message.size());
+
+        return TransferPipeData(pipe, &size, sizeof(size), true, INFINITE) &&
+               TransferPipeData(pipe, const_cast<std::uint8_t*>(message.data()), message.size(), true, INFINITE);
+    }
+
+    bool ReadMessage(HANDLE pipe, std::vector<std::uint8_t>& message, const DWORD timeoutMs)
+    {
+        std::uint32_t size;
+
+        if (!TransferPipeData(pipe, &size, sizeof(size), false, timeoutMs) || (size > MaxMessageSize)) {
+            return false;
+        }
+
+        message.resize(size);
+
+        return TransferPipeData(pipe, message.data(), message.size(), false, timeoutMs);
+    }
+
+    // Cache key covers everything that influences the compiler output, except for the contents of the source files.
+    std::uint64_t HashRequest(const ShaderCompileRequest& request)
+    {
+        std::uint64_t hash = HashSeed;
+
+        hash = HashString<wchar_t>(request.sourceFile.wstring(), hash);
+        hash = HashString<wchar_t>(request.includeDirectory.wstring(), hash);
+        hash = HashString<wchar_t>(request.target, hash);
+        hash = HashString<wchar_t>(request.entryPoint, hash);
+
+        for (const auto& argument : request.arguments) {
+            hash = HashString<wchar_t>(argument, hash);
+        }
+
+        return hash;
+    }
+
+    // Checks if all source files of a cached result are unchanged
+    bool IsUpToDate(const ShaderCompileResult& result)
+    {
+        for (const auto& sourceFile : result.sourceFiles) {
+            try {
+                if (HashFile(sourceFile.path) != sourceFile.contentHash) {
+                    return false;
+                }
+            } catch (const std::exception&) {
+                // File was deleted or is currently being written to
+                return false;
+            }
+        }
+
+        return true;
+    }
+}  // namespace
+
+CompileServer::CompileServer(const std::chrono::seconds idleTimeout)
+    : idleTimeout_(idleTimeout), lastActivityTime_(std::chrono::steady_clock::now())
+{
+}
+
+CompileServer::~CompileServer()
+{
+    for (auto& thread : clientThreads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+void CompileServer::Run()
+{
+    Trace::SetThreadName("Compile Server");
+
+    Log::Info() << "Compile server listening on pipe " << std::filesystem::path(PipeName).string();
+
+    HANDLE connectEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+
+    if (connectEvent == nullptr) {
+        throw std::runtime_error("Failed to create compile server event");
+    }
+
+    bool firstInstance = true;
+
+    while (true) {
+        // First instance ensures that only one server is running at a time
+        const DWORD openMode =
+            PIPE_ACCESS_DUPLEX | FILE_FLAG_OVERLAPPED | (firstInstance ? FILE_FLAG_FIRST_PIPE_INSTANCE : 0);
+
+        HANDLE pipe = CreateNamedPipeW(PipeName,
+                                       openMode,
+                                       PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+                                       PIPE_UNLIMITED_INSTANCES,
+                                       PipeBufferSize,
+                                       PipeBufferSize,
+                                       0,
+                                       nullptr);
+
+        if (pipe == INVALID_HANDLE_VALUE) {
+            CloseHandle(connectEvent);
+
+            if (firstInstance && (GetLastError() == ERROR_ACCESS_DENIED)) {
+                Log::Info() << "Compile server is already running.";
+                return;
+            }
+
+            throw std::runtime_error("Failed to create compile server pipe");
+        }
+
+        firstInstance = false;
+
+        OVERLAPPED overlapped = {};
+        overlapped.hEvent     = connectEvent;
+        ResetEvent(connectEvent);
+
+        bool connected = ConnectNamedPipe(pipe, &overlapped) != FALSE;
+
+        if (!connected && (GetLastError() == ERROR_PIPE_CONNECTED)) {
+            // Client connected between CreateNamedPipe and ConnectNamedPipe
+            connected = true;
+        } else if (!connected && (GetLastError() == ERROR_IO_PENDING)) {
+            // Wait for next client and check idle timeout in between
+            while (WaitForSingleObject(connectEvent, 1000) == WAIT_TIMEOUT) {
+                std::lock_guard lock(mutex_);
+
+                const auto idleTime = std::chrono::steady_clock::now() - lastActivityTime_;
+
+                if ((activeClientCount_ == 0) && (idleTime > idleTimeout_)) {
+                    break;
+                }
+            }
+
+            DWORD unused;
+            connected = GetOverlappedResult(pipe, &overlapped, &unused, FALSE) != FALSE;
+
+            if (!connected) {
+                // Idle timeout reached. Cancel pending connect and wait for it, as it still references "overlapped"
+                CancelIoEx(pipe, &overlapped);
+                GetOverlappedResult(pipe, &overlapped, &unused, TRUE);
+                CloseHandle(pipe);
+                break;
+            }
+        }
+
+        if (!connected) {
+            CloseHandle(pipe);
+            continue;
+        }
+
+        activeClientCount_++;
+        clientThreads_.emplace_back(&CompileServer::ServeClient, this, pipe);
+    }
+
+    CloseHandle(connectEvent);
+
+    Log::Info() << "Compile server idle for " << idleTimeout_.count() << "s. Shutting down.";
+}
+
+void CompileServer::ServeClient(HANDLE pipe)
+{
+    Trace::SetThreadName("Compile Server Client");
+
+    // Each client gets its own compiler instance, as IDxcCompiler must not be used from multiple threads
+    ShaderCompiler compiler;
+
+    std::vector<std::uint8_t> message;
+
+    while (ReadMessage(pipe, message, INFINITE)) {
+        ShaderCompileResult result;
+
+        try {
+            result = CompileCached(compiler, DeserializeRequest(message));
+        } catch (const std::exception& e) {
+            result          = {};
+            result.messages = e.what();
+        }
+
+        if (!WriteMessage(pipe, SerializeResult(result))) {
+            break;
+        }
+    }
+
+    DisconnectNamedPipe(pipe);
+    CloseHandle(pipe);
+
+    std::lock_guard lock(mutex_);
+    lastActivityTime_ = std::chrono::steady_clock::now();
+    activeClientCount_--;
+}
+
+ShaderCompileResult CompileServer::CompileCached(ShaderCompiler& compiler, const ShaderCompileRequest& request)
+{
+    const Trace::Scope traceScope("CompileServer::CompileCached");
+
+    const auto key = HashRequest(request);
+
+    {
+        ShaderCompileResult cachedResult;
+        {
+            std::lock_guard lock(mutex_);
+            lastActivityTime_ = std::chrono::steady_clock::now();
+
+            if (const auto it = cache_.find(key); it != cache_.end()) {
+                cachedResult = it->second;
+            }
+        }
+
+        // Check source files outside of lock, as it reads all files
+        if (cachedResult.success && IsUpToDate(cachedResult)) {
+            Log::Info() << "Using cached result for \"" << request.sourceFile.string() << "\"";
+            return cachedResult;
+        }
+    }
+
+    Log::Info() << "Compiling \"" << request.sourceFile.string() << "\"";
+
+    auto result = compiler.Compile(request);
+
+    // Only successful results are cached, such that errors are always reported with up-to-date messages
+    if (result.success) {
+        std::lock_guard lock(mutex_);
+        cache_[key] = result;
+    }
+
+    return result;
+}
+
+CompileClient::~CompileClient()
+{
+    Disconnect();
+}
+
+bool CompileClient::Connect()
+{
+    if (pipe_ != INVALID_HANDLE_VALUE) {
+        return true;
+    }
+
+    if (serverUnavailable_) {
+        return false;
+    }
+
+    const Trace::Scope traceScope("CompileClient::Connect");
+
+    if (!OpenPipe()) {
+        if (LaunchServer()) {
+            // Wait for server to create pipe
+            const auto launchTime = GetTickCount64();
+
+            while (!OpenPipe() && (GetTickCount64() - launchTime < ServerLaunchTimeoutMs)) {
+                Sleep(50);
+            }
+        }
+    }
+
+    if (pipe_ == INVALID_HANDLE_VALUE) {
+        Log::Info() << "Compile server is not available. Compiling shaders in-process.";
+        serverUnavailable_ = true;
+        return false;
+    }
+
+    return true;
+}
+
+ShaderCompileResult CompileClient::Compile(const ShaderCompileRequest& request)
+{
+    const Trace::Scope traceScope("CompileClient::Compile");
+
+    std::vector<std::uint8_t> message;
+
+    const bool success =
+        WriteMessage(pipe_, SerializeRequest(request)) && ReadMessage(pipe_, message, CompileTimeoutMs);
+
+    if (!success) {
+        // Server crashed or hung. Next connect will launch a new server.
+        Disconnect();
+
+        throw std::runtime_error("Lost connection to compile server while compiling \"" +
+                                 request.sourceFile.string() + "\". The shader compiler may have crashed.");
+    }
+
+    return DeserializeResult(message);
+}
+
+bool CompileClient::OpenPipe()
+{
+    pipe_ = CreateFileW(CompileServer::PipeName,
+                        GENERIC_READ | GENERIC_WRITE,
+                        0,
+                        nullptr,
+                        OPEN_EXISTING,
+                        FILE_FLAG_OVERLAPPED,
+                        nullptr);
+
+    if ((pipe_ == INVALID_HANDLE_VALUE) && (GetLastError() == ERROR_PIPE_BUSY)) {
+        // All pipe instances are busy, wait for server to create a new instance
+        if (WaitNamedPipeW(CompileServer::PipeName, ServerLaunchTimeoutMs)) {
+            pipe_ = CreateFileW(CompileServer::PipeName,
+                                GENERIC_READ | GENERIC_WRITE,
+                                0,
+                                nullptr,
+                                OPEN_EXISTING,
+                                FILE_FLAG_OVERLAPPED,
+                                nullptr);
+        }
+    }
+
+    return pipe_ != INVALID_HANDLE_VALUE;
+}
+
+bool CompileClient::LaunchServer()
+{
+    // Launch this executable in compile server mode
+    std::wstring executablePath(MAX_PATH, L'\0');
+    const auto   executablePathLength =
+        GetModuleFileNameW(nullptr, executablePath.data(), static_cast<DWORD>(executablePath.size()));
+
+    if ((executablePathLength == 0) || (executablePathLength == executablePath.size())) {
+        return false;
+    }
+
+    executablePath.resize(executablePathLength);
+
+    std::wstring commandLine = L"\"" + executablePath + L"\" --compileServer";
+
+    STARTUPINFOW        startupInfo = {.cb = sizeof(STARTUPINFOW)};
+    PROCESS_INFORMATION processInfo = {};
+
+    // Server is not tied to this process and keeps running for other instances until it is idle
+    if (!CreateProcessW(executablePath.c_str(),
+                        commandLine.data(),
+                        nullptr,
+                        nullptr,
+                        FALSE,
+                        CREATE_NO_WINDOW,
+                        nullptr,
+                        nullptr,
+                        &startupInfo,
+                        &processInfo))
+    {
+        return false;
+    }
+
+    Log::Info() << "Launched compile server.";
+
+    CloseHandle(processInfo.hThread);
+    CloseHandle(processInfo.hProcess);
+
+    return true;
+}
+
+void CompileClient::Disconnect()
+{
+    if (pipe_ != INVALID_HANDLE_VALUE) {
+        CloseHandle(pipe_);
+        pipe_ = INVALID_HANDLE_VALUE;
+    }
+}
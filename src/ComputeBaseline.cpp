@@ -0,0 +1,367 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "ComputeBaseline.h"
+
+#include <fstream>
+#include <regex>
+#include <sstream>
+
+#include "Application.h"
+#include "Hash.h"
+#include "Trace.h"
+
+namespace {
+    // Function names are ASCII
+    std::wstring ToWideString(const std::string& string)
+    {
+        return std::wstring(string.begin(), string.end());
+    }
+
+    // Parses decimal argument of a pass declaration. Throws if the argument is not a number of at least "minimum".
+    std::uint32_t ParseArgument(const std::string& declaration, const std::string& argument, std::uint32_t minimum)
+    {
+        std::size_t length = 0;
+
+        try {
+            const auto value = std::stoul(argument, &length);
+
+            if ((length == argument.size()) && (value >= minimum)) {
+                return static_cast<std::uint32_t>(value);
+            }
+        } catch (const std::exception&) {
+        }
+
+        throw std::runtime_error("pass declaration \"" + declaration + "\" has invalid argument \"" + argument + "\".");
+    }
+
+    // Compiles the shader of every pass
+    std::vector<ComPtr<IDxcBlob>> CompilePasses(ShaderCompiler&                        shaderCompiler,
+                                                const std::string&                     shaderFileName,
+                                                std::span<const ComputeBaseline::Pass> passes)
+    {
+        std::vector<ComPtr<IDxcBlob>> shaders;
+
+        for (const auto& pass : passes) {
+            shaders.emplace_back(
+                shaderCompiler.CompileShader(shaderFileName, L"cs_6_8", ToWideString(pass.functionName).c_str()));
+        }
+
+        return shaders;
+    }
+
+    // Hashes everything a baseline is created from. Fields are hashed individually, as structs contain padding.
+    std::uint64_t HashBaseline(std::span<const ComputeBaseline::Pass>          passes,
+                               std::span<const WorkGraph::ResourceDeclaration> resourceDeclarations,
+                               std::span<const ComPtr<IDxcBlob>>               shaders)
+    {
+        std::uint64_t hash = HashSeed;
+
+        for (const auto& pass : passes) {
+            hash = HashString(std::string_view(pass.functionName), hash);
+            hash = HashBytes(&pass.type, sizeof(pass.type), hash);
+            hash = HashBytes(pass.size.data(), sizeof(pass.size), hash);
+            hash = HashBytes(&pass.argumentOffset, sizeof(pass.argumentOffset), hash);
+            hash = HashBytes(&pass.iterations, sizeof(pass.iterations), hash);
+        }
+
+        for (const auto& declaration : resourceDeclarations) {
+            hash = HashBytes(&declaration.type, sizeof(declaration.type), hash);
+            hash = HashBytes(&declaration.registerIndex, sizeof(declaration.registerIndex), hash);
+            hash = HashBytes(&declaration.width, sizeof(declaration.width), hash);
+            hash = HashBytes(&declaration.height, sizeof(declaration.height), hash);
+        }
+
+        // Edits to comments or whitespace do not change the shader hash
+        for (const auto& shader : shaders) {
+            const auto shaderHash = ShaderCompiler::HashShaderCode(shader.Get());
+            hash                  = HashBytes(&shaderHash, sizeof(shaderHash), hash);
+        }
+
+        return hash;
+    }
+}  // namespace
+
+ComputeBaseline::ComputeBaseline(const Device*        device,
+                                 ShaderCompiler&      shaderCompiler,
+                                 DescriptorHeap&      descriptorHeap,
+                                 ID3D12RootSignature* rootSignature,
+                                 const std::uint32_t  tutorialIndex)
+    : tutorialIndex_(tutorialIndex), descriptorHeap_(descriptorHeap)
+{
+    const Trace::Scope traceScope("ComputeBaseline::ComputeBaseline");
+
+    const auto shaderFileName = GetShaderFileName(tutorialIndex);
+
+    passes_               = ReadPasses(shaderCompiler, shaderFileName);
+    resourceDeclarations_ = WorkGraph::ReadResourceDeclarations(shaderCompiler, shaderFileName);
+
+    if (passes_.empty()) {
+        throw std::runtime_error(shaderFileName + " does not declare any passes with \"// @Pass(...)\".");
+    }
+
+    const auto shaders = CompilePasses(shaderCompiler, shaderFileName, passes_);
+
+    sourceHash_ = HashBaseline(passes_, resourceDeclarations_, shaders);
+
+    for (const auto& shader : shaders) {
+        D3D12_COMPUTE_PIPELINE_STATE_DESC desc = {};
+        desc.pRootSignature                    = rootSignature;
+        desc.CS = CD3DX12_SHADER_BYTECODE(shader->GetBufferPointer(), shader->GetBufferSize());
+
+        ComPtr<ID3D12PipelineState> pipelineState;
+        ThrowIfFailed(device->GetDevice()->CreateComputePipelineState(&desc, IID_PPV_ARGS(&pipelineState)));
+
+        pipelineStates_.emplace_back(std::move(pipelineState));
+    }
+
+    // Arguments of one indirect dispatch
+    {
+        CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_DEFAULT);
+        CD3DX12_RESOURCE_DESC   resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(IndirectArgumentStride);
+        ThrowIfFailed(device->GetDevice()->CreateCommittedResource(&heapProperties,
+                                                                   D3D12_HEAP_FLAG_NONE,
+                                                                   &resourceDesc,
+                                                                   D3D12_RESOURCE_STATE_COPY_DEST,
+                                                                   nullptr,
+                                                                   IID_PPV_ARGS(&argumentBuffer_)));
+    }
+    {
+        D3D12_INDIRECT_ARGUMENT_DESC argumentDesc = {};
+        argumentDesc.Type                         = D3D12_INDIRECT_ARGUMENT_TYPE_DISPATCH;
+
+        D3D12_COMMAND_SIGNATURE_DESC signatureDesc = {};
+        signatureDesc.ByteStride                   = sizeof(D3D12_DISPATCH_ARGUMENTS);
+        signatureDesc.NumArgumentDescs             = 1;
+        signatureDesc.pArgumentDescs               = &argumentDesc;
+
+        ThrowIfFailed(
+            device->GetDevice()->CreateCommandSignature(&signatureDesc, nullptr, IID_PPV_ARGS(&commandSignature_)));
+    }
+
+    resourceDescriptorIndex_ = WorkGraph::CreateResources(device, descriptorHeap_, resourceDeclarations_, resources_);
+    memorySize_ = WorkGraph::GetAllocationSize(device, resources_) +
+                  WorkGraph::GetAllocationSize(device, std::span(&argumentBuffer_, 1));
+}
+
+ComputeBaseline::~ComputeBaseline()
+{
+    descriptorHeap_.Free(resourceDescriptorIndex_, WorkGraph::MaxResourceCount);
+}
+
+void ComputeBaseline::Dispatch(ID3D12GraphicsCommandList10* commandList,
+                               const std::uint32_t          renderWidth,
+                               const std::uint32_t          renderHeight,
+                               ID3D12Resource*              scratchBuffer)
+{
+    const Trace::Scope traceScope("ComputeBaseline::Dispatch");
+
+    // Every pass depends on the results of the previous pass
+    const auto uavBarrier = CD3DX12_RESOURCE_BARRIER::UAV(nullptr);
+
+    for (std::size_t passIndex = 0; passIndex < passes_.size(); ++passIndex) {
+        const auto& pass = passes_[passIndex];
+
+        commandList->SetPipelineState(pipelineStates_[passIndex].Get());
+
+        for (std::uint32_t iteration = 0; iteration < pass.iterations; ++iteration) {
+            commandList->SetComputeRoot32BitConstant(0, iteration, PassIterationConstant);
+
+            switch (pass.type) {
+                case Pass::Type::Fixed:
+                    commandList->Dispatch(pass.size[0], pass.size[1], pass.size[2]);
+                    break;
+                case Pass::Type::RenderSize:
+                    commandList->Dispatch((renderWidth + pass.size[0] - 1) / pass.size[0],
+                                          (renderHeight + pass.size[1] - 1) / pass.size[1],
+                                          1);
+                    break;
+                case Pass::Type::Indirect: {
+                    // Argument buffer is in COPY_DEST state between indirect passes
+                    const auto preBarrier = CD3DX12_RESOURCE_BARRIER::Transition(
+                        scratchBuffer, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE);
+                    commandList->ResourceBarrier(1, &preBarrier);
+
+                    commandList->CopyBufferRegion(argumentBuffer_.Get(),
+                                                  0,
+                                                  scratchBuffer,
+                                                  pass.argumentOffset + iteration * IndirectArgumentStride,
+                                                  sizeof(D3D12_DISPATCH_ARGUMENTS));
+
+                    std::array<D3D12_RESOURCE_BARRIER, 2> postBarriers = {
+                        CD3DX12_RESOURCE_BARRIER::Transition(
+                            scratchBuffer, D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_UNORDERED_ACCESS),
+                        CD3DX12_RESOURCE_BARRIER::Transition(argumentBuffer_.Get(),
+                                                             D3D12_RESOURCE_STATE_COPY_DEST,
+                                                             D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT),
+                    };
+                    commandList->ResourceBarrier(postBarriers.size(), postBarriers.data());
+
+                    commandList->ExecuteIndirect(commandSignature_.Get(), 1, argumentBuffer_.Get(), 0, nullptr, 0);
+
+                    const auto barrier = CD3DX12_RESOURCE_BARRIER::Transition(argumentBuffer_.Get(),
+                                                                              D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT,
+                                                                              D3D12_RESOURCE_STATE_COPY_DEST);
+                    commandList->ResourceBarrier(1, &barrier);
+                    break;
+                }
+            }
+
+            commandList->ResourceBarrier(1, &uavBarrier);
+        }
+    }
+}
+
+std::uint32_t ComputeBaseline::GetTutorialIndex() const
+{
+    return tutorialIndex_;
+}
+
+std::uint64_t ComputeBaseline::GetMemorySize() const
+{
+    return memorySize_;
+}
+
+std::uint64_t ComputeBaseline::GetSourceHash() const
+{
+    return sourceHash_;
+}
+
+std::span<const WorkGraph::ResourceDeclaration> ComputeBaseline::GetResourceDeclarations() const
+{
+    return resourceDeclarations_;
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE ComputeBaseline::GetResourceDescriptorTable() const
+{
+    return descriptorHeap_.GetGPUHandle(resourceDescriptorIndex_);
+}
+
+std::uint64_t ComputeBaseline::HashSources(ShaderCompiler& shaderCompiler, const std::uint32_t tutorialIndex)
+{
+    const Trace::Scope traceScope("ComputeBaseline::HashSources");
+
+    const auto shaderFileName       = GetShaderFileName(tutorialIndex);
+    const auto passes               = ReadPasses(shaderCompiler, shaderFileName);
+    const auto resourceDeclarations = WorkGraph::ReadResourceDeclarations(shaderCompiler, shaderFileName);
+
+    return HashBaseline(passes, resourceDeclarations, CompilePasses(shaderCompiler, shaderFileName, passes));
+}
+
+std::string ComputeBaseline::GetShaderFileName(const std::uint32_t tutorialIndex)
+{
+    const auto& tutorial = Application::GetTutorials()[tutorialIndex];
+
+    if (tutorial.baselineShaderFileName.empty()) {
+        throw std::runtime_error("selected tutorial does not provide a compute baseline.");
+    }
+
+    return tutorial.baselineShaderFileName;
+}
+
+std::vector<ComputeBaseline::Pass> ComputeBaseline::ReadPasses(const ShaderCompiler& shaderCompiler,
+                                                               const std::string&    shaderFileName)
+{
+    static const std::regex passPattern(R"(//\s*@Pass\(([^)]*)\))");
+
+    std::vector<Pass> passes;
+
+    // Only the shader file itself is searched, not its includes
+    std::ifstream file(shaderCompiler.GetShaderSourceFilePath(shaderFileName));
+    std::string   line;
+
+    while (std::getline(file, line)) {
+        std::smatch match;
+
+        if (!std::regex_search(line, match, passPattern)) {
+            continue;
+        }
+
+        const auto declaration = match.str();
+
+        std::vector<std::string> arguments;
+        {
+            std::istringstream stream(match[1].str());
+            std::string        argument;
+
+            while (std::getline(stream, argument, ',')) {
+                std::erase(argument, ' ');
+                std::erase(argument, '\t');
+                arguments.emplace_back(argument);
+            }
+        }
+
+        if (arguments.size() < 2) {
+            throw std::runtime_error("pass declaration \"" + declaration +
+                                     "\" requires a function and a dispatch size.");
+        }
+
+        Pass pass = {.functionName = arguments[0]};
+
+        // Number of arguments after the function name, excluding the optional repetition count
+        std::size_t sizeArgumentCount = 0;
+
+        if (arguments[1] == "RenderSize") {
+            pass.type         = Pass::Type::RenderSize;
+            sizeArgumentCount = 3;
+        } else if (arguments[1] == "Indirect") {
+            pass.type         = Pass::Type::Indirect;
+            sizeArgumentCount = 2;
+        } else {
+            pass.type         = Pass::Type::Fixed;
+            sizeArgumentCount = 3;
+        }
+
+        if ((arguments.size() != 1 + sizeArgumentCount) && (arguments.size() != 2 + sizeArgumentCount)) {
+            throw std::runtime_error("pass declaration \"" + declaration + "\" has wrong number of arguments.");
+        }
+
+        switch (pass.type) {
+            case Pass::Type::Fixed:
+                for (std::size_t dimension = 0; dimension < 3; ++dimension) {
+                    pass.size[dimension] = ParseArgument(declaration, arguments[1 + dimension], 1);
+                }
+                break;
+            case Pass::Type::RenderSize:
+                pass.size[0] = ParseArgument(declaration, arguments[2], 1);
+                pass.size[1] = ParseArgument(declaration, arguments[3], 1);
+                break;
+            case Pass::Type::Indirect:
+                pass.argumentOffset = ParseArgument(declaration, arguments[2], 0);
+
+                if (pass.argumentOffset % sizeof(std::uint32_t) != 0) {
+                    throw std::runtime_error("pass declaration \"" + declaration +
+                                             "\" must use an argument offset that is a multiple of 4.");
+                }
+                break;
+        }
+
+        if (arguments.size() == 2 + sizeArgumentCount) {
+            pass.iterations = ParseArgument(declaration, arguments.back(), 1);
+        }
+
+        passes.emplace_back(pass);
+    }
+
+    return passes;
+}
@@ -0,0 +1,107 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "DescriptorHeap.h"
+
+#include <stdexcept>
+
+DescriptorHeap::DescriptorHeap(Device* device, const std::uint32_t descriptorCount) : device_(device)
+{
+    D3D12_DESCRIPTOR_HEAP_DESC desc = {};
+    desc.Type                       = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+    desc.NumDescriptors             = descriptorCount;
+    desc.Flags                      = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+    desc.NodeMask                   = 1;
+    ThrowIfFailed(device_->GetDevice()->CreateDescriptorHeap(&desc, IID_PPV_ARGS(&heap_)));
+
+    descriptorSize_ = device_->GetDevice()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+    // Entire heap is free
+    freeRanges_.emplace(0, descriptorCount);
+}
+
+std::uint32_t DescriptorHeap::Allocate(const std::uint32_t count)
+{
+    for (auto it = freeRanges_.begin(); it != freeRanges_.end(); ++it) {
+        const auto [index, rangeCount] = *it;
+
+        if (rangeCount < count) {
+            continue;
+        }
+
+        freeRanges_.erase(it);
+
+        // Keep remainder of the range in the free list
+        if (rangeCount > count) {
+            freeRanges_.emplace(index + count, rangeCount - count);
+        }
+
+        return index;
+    }
+
+    throw std::runtime_error("descriptor heap is full.");
+}
+
+void DescriptorHeap::Free(const std::uint32_t index, const std::uint32_t count)
+{
+    // Frames in flight may still reference the descriptors
+    device_->OnCompleted([this, index, count]() { Release(index, count); });
+}
+
+void DescriptorHeap::Release(std::uint32_t index, std::uint32_t count)
+{
+    auto next = freeRanges_.lower_bound(index);
+
+    // Merge with following range
+    if ((next != freeRanges_.end()) && (index + count == next->first)) {
+        count += next->second;
+        next = freeRanges_.erase(next);
+    }
+
+    // Merge with preceding range
+    if (next != freeRanges_.begin()) {
+        const auto previous = std::prev(next);
+
+        if (previous->first + previous->second == index) {
+            previous->second += count;
+            return;
+        }
+    }
+
+    freeRanges_.emplace_hint(next, index, count);
+}
+
+ID3D12DescriptorHeap* DescriptorHeap::GetHeap() const
+{
+    return heap_.Get();
+}
+
+D3D12_CPU_DESCRIPTOR_HANDLE DescriptorHeap::GetCPUHandle(const std::uint32_t index) const
+{
+    return CD3DX12_CPU_DESCRIPTOR_HANDLE(heap_->GetCPUDescriptorHandleForHeapStart(), index, descriptorSize_);
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE DescriptorHeap::GetGPUHandle(const std::uint32_t index) const
+{
+    return CD3DX12_GPU_DESCRIPTOR_HANDLE(heap_->GetGPUDescriptorHandleForHeapStart(), index, descriptorSize_);
+}
@@ -24,11 +24,16 @@
 #include "Device.h"
 
 #include <codecvt>
-#include <iostream>
+#include <fstream>
+#include <iomanip>
 #include <locale>
+#include <optional>
 #include <sstream>
 #include <system_error>
 
+#include "Log.h"
+#include "Trace.h"
+
 // Declarations for Microsoft.D3D.D3D12 Agility SDK NuGet package.
 // D3D12SDKVersion needs to be updated if newer NuGet package is used.
 extern "C" {
@@ -48,12 +53,200 @@ void ThrowIfFailed(const HRESULT hr)
             " (" << cond.value() << ") (" << std::hex << hr << "): " <<  //
             cond.message();
 
+        // Device is unusable after it was removed, e.g. by a GPU reset (TDR)
+        if ((hr == DXGI_ERROR_DEVICE_REMOVED) || (hr == DXGI_ERROR_DEVICE_HUNG) || (hr == DXGI_ERROR_DEVICE_RESET)) {
+            throw DeviceLostError(stream.str());
+        }
+
         throw std::runtime_error(stream.str());
     }
 }
 
-Device::Device(const bool forceWarpAdapter, const bool enableDebugLayer, const bool enableGpuValidationLayer)
+namespace {
+    // Adapter selected by a previous launch. LUIDs change when the system restarts, thus vendor and device ID are
+    // stored as well to find the adapter again.
+    struct CachedAdapter {
+        LUID          luid;
+        std::uint32_t vendorId;
+        std::uint32_t deviceId;
+        // Benchmark score in GB/s, zero if adapters were not benchmarked
+        double        score;
+    };
+
+    std::optional<CachedAdapter> ReadAdapterCache(const std::filesystem::path& path)
+    {
+        std::ifstream file(path);
+
+        CachedAdapter cachedAdapter = {};
+        if (file >> cachedAdapter.luid.LowPart >> cachedAdapter.luid.HighPart >> cachedAdapter.vendorId >>
+            cachedAdapter.deviceId >> cachedAdapter.score)
+        {
+            return cachedAdapter;
+        }
+
+        return std::nullopt;
+    }
+
+    void WriteAdapterCache(const std::filesystem::path& path, const CachedAdapter& cachedAdapter)
+    {
+        std::ofstream file(path, std::ios::trunc);
+
+        file << cachedAdapter.luid.LowPart << " " << cachedAdapter.luid.HighPart << " " << cachedAdapter.vendorId << " "
+             << cachedAdapter.deviceId << " " << cachedAdapter.score << "\n";
+    }
+
+    // Micro-benchmark for adapter selection: repeatedly clears and copies a buffer and returns the achieved memory
+    // bandwidth in GB/s. Does not require any shaders, such that it can run before the shader compiler is loaded.
+    double BenchmarkDevice(ID3D12Device9* device)
+    {
+        static constexpr std::uint64_t BufferSize = 128 * 1024 * 1024;
+        static constexpr std::uint32_t Iterations = 8;
+
+        ComPtr<ID3D12CommandQueue>        queue;
+        ComPtr<ID3D12CommandAllocator>    commandAllocator;
+        ComPtr<ID3D12GraphicsCommandList> commandList;
+
+        const D3D12_COMMAND_QUEUE_DESC queueDesc = {.Type = D3D12_COMMAND_LIST_TYPE_DIRECT};
+        ThrowIfFailed(device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&queue)));
+        ThrowIfFailed(device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&commandAllocator)));
+        ThrowIfFailed(device->CreateCommandList(
+            0, D3D12_COMMAND_LIST_TYPE_DIRECT, commandAllocator.Get(), nullptr, IID_PPV_ARGS(&commandList)));
+
+        // Source buffer is cleared and copied to destination buffer
+        ComPtr<ID3D12Resource> sourceBuffer;
+        ComPtr<ID3D12Resource> destinationBuffer;
+        ComPtr<ID3D12Resource> readbackBuffer;
+        {
+            const CD3DX12_HEAP_PROPERTIES defaultHeapProperties(D3D12_HEAP_TYPE_DEFAULT);
+            const CD3DX12_HEAP_PROPERTIES readbackHeapProperties(D3D12_HEAP_TYPE_READBACK);
+
+            const auto bufferFlags  = D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
+            const auto bufferDesc   = CD3DX12_RESOURCE_DESC::Buffer(BufferSize, bufferFlags);
+            const auto readbackDesc = CD3DX12_RESOURCE_DESC::Buffer(2 * sizeof(std::uint64_t));
+
+            ThrowIfFailed(device->CreateCommittedResource(&defaultHeapProperties,
+                                                          D3D12_HEAP_FLAG_NONE,
+                                                          &bufferDesc,
+                                                          D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+                                                          nullptr,
+                                                          IID_PPV_ARGS(&sourceBuffer)));
+            ThrowIfFailed(device->CreateCommittedResource(&defaultHeapProperties,
+                                                          D3D12_HEAP_FLAG_NONE,
+                                                          &bufferDesc,
+                                                          D3D12_RESOURCE_STATE_COPY_DEST,
+                                                          nullptr,
+                                                          IID_PPV_ARGS(&destinationBuffer)));
+            ThrowIfFailed(device->CreateCommittedResource(&readbackHeapProperties,
+                                                          D3D12_HEAP_FLAG_NONE,
+                                                          &readbackDesc,
+                                                          D3D12_RESOURCE_STATE_COPY_DEST,
+                                                          nullptr,
+                                                          IID_PPV_ARGS(&readbackBuffer)));
+        }
+
+        // Clearing a UAV requires a descriptor in a shader visible and a non-shader visible heap
+        ComPtr<ID3D12DescriptorHeap> clearDescriptorHeap;
+        ComPtr<ID3D12DescriptorHeap> descriptorHeap;
+        {
+            D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
+            heapDesc.Type                       = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+            heapDesc.NumDescriptors             = 1;
+            ThrowIfFailed(device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&clearDescriptorHeap)));
+            heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+            ThrowIfFailed(device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&descriptorHeap)));
+
+            D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+            uavDesc.ViewDimension                    = D3D12_UAV_DIMENSION_BUFFER;
+            uavDesc.Format                           = DXGI_FORMAT_R32_TYPELESS;
+            uavDesc.Buffer.NumElements               = BufferSize / sizeof(std::uint32_t);
+            uavDesc.Buffer.Flags                     = D3D12_BUFFER_UAV_FLAG_RAW;
+
+            device->CreateUnorderedAccessView(
+                sourceBuffer.Get(), nullptr, &uavDesc, clearDescriptorHeap->GetCPUDescriptorHandleForHeapStart());
+            device->CreateUnorderedAccessView(
+                sourceBuffer.Get(), nullptr, &uavDesc, descriptorHeap->GetCPUDescriptorHandleForHeapStart());
+        }
+
+        ComPtr<ID3D12QueryHeap> queryHeap;
+        {
+            D3D12_QUERY_HEAP_DESC queryHeapDesc = {};
+            queryHeapDesc.Type                  = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+            queryHeapDesc.Count                 = 2;
+            ThrowIfFailed(device->CreateQueryHeap(&queryHeapDesc, IID_PPV_ARGS(&queryHeap)));
+        }
+
+        commandList->SetDescriptorHeaps(1, descriptorHeap.GetAddressOf());
+        commandList->EndQuery(queryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, 0);
+
+        for (std::uint32_t iteration = 0; iteration < Iterations; ++iteration) {
+            const std::uint32_t clearValue[4] = {iteration, iteration, iteration, iteration};
+            commandList->ClearUnorderedAccessViewUint(descriptorHeap->GetGPUDescriptorHandleForHeapStart(),
+                                                      clearDescriptorHeap->GetCPUDescriptorHandleForHeapStart(),
+                                                      sourceBuffer.Get(),
+                                                      clearValue,
+                                                      0,
+                                                      nullptr);
+
+            const auto preBarrier = CD3DX12_RESOURCE_BARRIER::Transition(
+                sourceBuffer.Get(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE);
+            commandList->ResourceBarrier(1, &preBarrier);
+
+            commandList->CopyResource(destinationBuffer.Get(), sourceBuffer.Get());
+
+            const auto postBarrier = CD3DX12_RESOURCE_BARRIER::Transition(
+                sourceBuffer.Get(), D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+            commandList->ResourceBarrier(1, &postBarrier);
+        }
+
+        commandList->EndQuery(queryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, 1);
+        commandList->ResolveQueryData(queryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, 0, 2, readbackBuffer.Get(), 0);
+        ThrowIfFailed(commandList->Close());
+
+        ComPtr<ID3D12Fence> fence;
+        ThrowIfFailed(device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence)));
+        const auto fenceEvent = CreateEventA(nullptr, false, false, nullptr);
+
+        // First run warms up caches and memory residency, second run is measured
+        for (std::uint64_t run = 1; run <= 2; ++run) {
+            queue->ExecuteCommandLists(1, reinterpret_cast<ID3D12CommandList* const*>(commandList.GetAddressOf()));
+            queue->Signal(fence.Get(), run);
+
+            fence->SetEventOnCompletion(run, fenceEvent);
+            WaitForSingleObject(fenceEvent, INFINITE);
+        }
+
+        CloseHandle(fenceEvent);
+
+        std::uint64_t timestampFrequency = 0;
+        ThrowIfFailed(queue->GetTimestampFrequency(&timestampFrequency));
+
+        std::uint64_t* timestamps = nullptr;
+        ThrowIfFailed(readbackBuffer->Map(0, nullptr, reinterpret_cast<void**>(&timestamps)));
+        const auto ticks = timestamps[1] - timestamps[0];
+        readbackBuffer->Unmap(0, nullptr);
+
+        if ((ticks == 0) || (timestampFrequency == 0)) {
+            return 0.0;
+        }
+
+        // Clear writes the buffer, copy reads and writes it
+        const auto bytes   = static_cast<double>(Iterations) * BufferSize * 3;
+        const auto seconds = static_cast<double>(ticks) / timestampFrequency;
+
+        return bytes / seconds / 1e9;
+    }
+}  // namespace
+
+Device::Device(const bool                      forceWarpAdapter,
+               const bool                      enableDebugLayer,
+               const bool                      enableGpuValidationLayer,
+               const std::filesystem::path&    adapterCacheFile,
+               const bool                      benchmarkAdapters,
+               const std::chrono::milliseconds gpuTimeout)
+    : gpuTimeout_(gpuTimeout)
 {
+    const Trace::Scope traceScope("Device::Device");
+
     CreateDXGIFactory(enableDebugLayer, enableGpuValidationLayer);
 
     if (forceWarpAdapter) {
@@ -62,21 +255,13 @@ Device::Device(const bool forceWarpAdapter, const bool enableDebugLayer, const b
 
         device_ = CreateDevice(adapter.Get());
     } else {
-        // Try to find suitable adapter, fallback to WARP
-        for (std::uint32_t adapterId = 0; true; ++adapterId) {
-            ComPtr<IDXGIAdapter1> adapter;
-
-            if (dxgiFactory_->EnumAdapters1(adapterId, &adapter) == DXGI_ERROR_NOT_FOUND) {
-                // No more adapters to check
-                break;
-            }
-
-            device_ = CreateDevice(adapter.Get());
+        if (!benchmarkAdapters) {
+            device_ = CreateCachedDevice(adapterCacheFile);
+        }
 
-            // End search if adapter creation was successful.
-            if (device_) {
-                break;
-            }
+        // Try to find suitable adapter, fallback to WARP
+        if (!device_) {
+            device_ = SelectDevice(adapterCacheFile, benchmarkAdapters);
         }
     }
 
@@ -104,7 +289,7 @@ Device::Device(const bool forceWarpAdapter, const bool enableDebugLayer, const b
     } while (false);
 
     if (enableDebugLayer) {
-        // Register callback to print D3D12 debug messages to std::cout
+        // Register callback to forward D3D12 debug messages to the log
         RegisterDebugMessageCallback();
     }
 
@@ -114,21 +299,68 @@ Device::Device(const bool forceWarpAdapter, const bool enableDebugLayer, const b
 
 void Device::WaitForDevice()
 {
+    const Trace::Scope traceScope("Device::WaitForDevice");
+
+    // Fence of a lost device is never signaled
+    if (lost_) {
+        return;
+    }
+
     // Increment signaled value and set fence
     signaledFenceValue_++;
     commandQueue_->Signal(fence_.Get(), signaledFenceValue_);
 
-    // Fence is already signaled
-    if (fence_->GetCompletedValue() >= signaledFenceValue_) {
+    WaitForFence(signaledFenceValue_);
+
+    // All submitted work is done
+    ProcessCompletionTasks();
+}
+
+void Device::WaitForFence(const std::uint64_t fenceValue)
+{
+    // Only wait if fence is not already signaled
+    if (fence_->GetCompletedValue() >= fenceValue) {
         return;
     }
 
-    fence_->SetEventOnCompletion(signaledFenceValue_, fenceEvent_);
-    WaitForSingleObject(fenceEvent_, INFINITE);
+    fence_->SetEventOnCompletion(fenceValue, fenceEvent_);
+
+    const auto timeout = (gpuTimeout_.count() > 0) ? static_cast<DWORD>(gpuTimeout_.count()) : INFINITE;
+
+    if (WaitForSingleObject(fenceEvent_, timeout) == WAIT_OBJECT_0) {
+        // Fences of removed devices are signaled with UINT64_MAX
+        if (device_->GetDeviceRemovedReason() == S_OK) {
+            return;
+        }
+    }
+
+    lost_ = true;
+
+    std::stringstream message;
+    if (device_->GetDeviceRemovedReason() != S_OK) {
+        message << "GPU device was removed (reason " << std::hex << device_->GetDeviceRemovedReason()
+                << "), e.g., after a work graph did not finish in time.";
+    } else {
+        message << "GPU did not finish within " << gpuTimeout_.count()
+                << "ms, e.g., because of an infinite loop or unbounded recursion in a work graph.";
+    }
+
+    throw DeviceLostError(message.str());
+}
+
+void Device::OnCompleted(std::function<void()> callback)
+{
+    // Next signaled fence value covers all work submitted or recorded so far
+    completionTasks_.push_back({
+        .fenceValue = signaledFenceValue_ + 1,
+        .callback   = std::move(callback),
+    });
 }
 
 ID3D12GraphicsCommandList10* Device::GetNextFrameCommandList()
 {
+    const Trace::Scope traceScope("Device::GetNextFrameCommandList");
+
     // Increment frame index to next frame
     frameIndex_ = (frameIndex_ + 1) % BufferedFramesCount;
 
@@ -139,18 +371,28 @@ ID3D12GraphicsCommandList10* Device::GetNextFrameCommandList()
     if ((frameContext.waitFenceValue != 0) &&  //
         (fence_->GetCompletedValue() < frameContext.waitFenceValue))
     {
-        fence_->SetEventOnCompletion(frameContext.waitFenceValue, fenceEvent_);
-        WaitForSingleObject(fenceEvent_, INFINITE);
+        const Trace::Scope waitTraceScope("Device::WaitForFrameFence");
+
+        WaitForFence(frameContext.waitFenceValue);
     }
 
+    ProcessCompletionTasks();
+
     ThrowIfFailed(frameContext.commandAllocator->Reset());
     ThrowIfFailed(frameContext.commandList->Reset(frameContext.commandAllocator.Get(), nullptr));
 
     return frameContext.commandList.Get();
 }
 
+std::uint32_t Device::GetFrameIndex() const
+{
+    return frameIndex_;
+}
+
 void Device::ExecuteCurrentFrameCommandList()
 {
+    const Trace::Scope traceScope("Device::ExecuteCurrentFrameCommandList");
+
     auto& frameContext = frameContexts_[frameIndex_];
 
     // Close command list
@@ -225,48 +467,185 @@ void Device::CreateDXGIFactory(bool enableDebugLayer, bool enableGpuValidationLa
     }
 }
 
+std::vector<ComPtr<IDXGIAdapter1>> Device::EnumerateAdapters() const
+{
+    std::vector<ComPtr<IDXGIAdapter1>> adapters;
+
+    ComPtr<IDXGIFactory6> factory6;
+    const bool            gpuPreference = SUCCEEDED(dxgiFactory_.As(&factory6));
+
+    for (std::uint32_t adapterId = 0; true; ++adapterId) {
+        ComPtr<IDXGIAdapter1> adapter;
+
+        // Prefer discrete GPUs over integrated GPUs, if the factory supports it
+        const auto result =
+            gpuPreference
+                ? factory6->EnumAdapterByGpuPreference(
+                      adapterId, DXGI_GPU_PREFERENCE_HIGH_PERFORMANCE, IID_PPV_ARGS(&adapter))
+                : dxgiFactory_->EnumAdapters1(adapterId, &adapter);
+
+        if (result == DXGI_ERROR_NOT_FOUND) {
+            // No more adapters to check
+            break;
+        }
+
+        if (SUCCEEDED(result)) {
+            adapters.emplace_back(std::move(adapter));
+        }
+    }
+
+    return adapters;
+}
+
+ComPtr<ID3D12Device9> Device::CreateCachedDevice(const std::filesystem::path& adapterCacheFile) const
+{
+    if (adapterCacheFile.empty()) {
+        return {};
+    }
+
+    const auto cachedAdapter = ReadAdapterCache(adapterCacheFile);
+
+    if (!cachedAdapter) {
+        return {};
+    }
+
+    // Find adapter by LUID first, then by vendor & device ID, as the LUID changes when the system restarts
+    ComPtr<IDXGIAdapter1> matchingAdapter;
+
+    for (const auto& adapter : EnumerateAdapters()) {
+        DXGI_ADAPTER_DESC1 desc;
+        if (FAILED(adapter->GetDesc1(&desc)) || (desc.VendorId != cachedAdapter->vendorId) ||
+            (desc.DeviceId != cachedAdapter->deviceId))
+        {
+            continue;
+        }
+
+        const bool sameLuid = (desc.AdapterLuid.LowPart == cachedAdapter->luid.LowPart) &&
+                              (desc.AdapterLuid.HighPart == cachedAdapter->luid.HighPart);
+
+        if (sameLuid || !matchingAdapter) {
+            matchingAdapter = adapter;
+        }
+        if (sameLuid) {
+            break;
+        }
+    }
+
+    if (!matchingAdapter) {
+        Log::Info() << "Adapter stored in " << adapterCacheFile.string() << " is not available.";
+        return {};
+    }
+
+    return CreateDevice(matchingAdapter.Get());
+}
+
+ComPtr<ID3D12Device9> Device::SelectDevice(const std::filesystem::path& adapterCacheFile,
+                                           const bool                   benchmarkAdapters) const
+{
+    const Trace::Scope traceScope("Device::SelectDevice");
+
+    ComPtr<ID3D12Device9> selectedDevice;
+    double                selectedScore = -1.0;
+
+    for (const auto& adapter : EnumerateAdapters()) {
+        auto device = CreateDevice(adapter.Get());
+
+        if (!device) {
+            continue;
+        }
+
+        // Without benchmark, first adapter in order of GPU preference is used
+        if (!benchmarkAdapters) {
+            selectedDevice = std::move(device);
+            selectedScore  = 0.0;
+            break;
+        }
+
+        double score = 0.0;
+        try {
+            const Trace::Scope benchmarkTraceScope("Device::BenchmarkDevice");
+            score = BenchmarkDevice(device.Get());
+        } catch (const std::exception& e) {
+            Log::Warning() << "Adapter benchmark failed: " << e.what();
+        }
+
+        DXGI_ADAPTER_DESC1 desc = {};
+        adapter->GetDesc1(&desc);
+
+        std::wstring_convert<std::codecvt_utf8<wchar_t>> converter;
+        Log::Info() << "Benchmarked adapter \"" << converter.to_bytes(desc.Description) << "\": " << std::fixed
+                    << std::setprecision(1) << score << " GB/s";
+
+        if (score > selectedScore) {
+            selectedDevice = std::move(device);
+            selectedScore  = score;
+        }
+    }
+
+    if (selectedDevice && !adapterCacheFile.empty()) {
+        ComPtr<IDXGIAdapter1> adapter;
+        DXGI_ADAPTER_DESC1    desc;
+
+        if (SUCCEEDED(dxgiFactory_->EnumAdapterByLuid(selectedDevice->GetAdapterLuid(), IID_PPV_ARGS(&adapter))) &&
+            SUCCEEDED(adapter->GetDesc1(&desc)))
+        {
+            WriteAdapterCache(adapterCacheFile,
+                              {
+                                  .luid     = desc.AdapterLuid,
+                                  .vendorId = desc.VendorId,
+                                  .deviceId = desc.DeviceId,
+                                  .score    = selectedScore,
+                              });
+        }
+    }
+
+    return selectedDevice;
+}
+
 ComPtr<ID3D12Device9> Device::CreateDevice(IDXGIAdapter1* adapter) const
 {
     DXGI_ADAPTER_DESC1 desc;
     if (FAILED(adapter->GetDesc1(&desc))) {
-        std::cout << "Could not get adapter description for adapter." << std::endl;
+        Log::Warning() << "Could not get adapter description for adapter.";
         return {};
     }
 
-    std::wcout << "Testing adapter \"" << desc.Description << "\": ";
+    // Every result is logged as a single message, as messages of other threads may be interleaved
+    std::wstring_convert<std::codecvt_utf8<wchar_t>> converter;
+    const auto adapterPrefix = "Testing adapter \"" + converter.to_bytes(desc.Description) + "\": ";
+
+    const Trace::Scope traceScope("Device::CreateDevice");
 
     ComPtr<ID3D12Device9> device;
 
     if (FAILED(D3D12CreateDevice(adapter, D3D_FEATURE_LEVEL_12_2, IID_PPV_ARGS(&device)))) {
-        std::cout << "Failed to create D3D12 device." << std::endl;
+        Log::Info() << adapterPrefix << "Failed to create D3D12 device.";
 
         if (desc.Flags & DXGI_ADAPTER_FLAG_SOFTWARE) {
-            std::cout
+            Log::Info()
                 << "WARP adapter does not support D3D feature level 12.2 and work graphs.\n"
                    " See readme.md#running-on-gpus-without-work-graphs-support for instructions on installing latest "
-                   "WARP adapter."
-                << std::endl;
+                   "WARP adapter.";
         }
 
         return {};
     }
 
     if (!CheckDeviceFeatures(device.Get())) {
-        std::cout << "Device does not support work graphs." << std::endl;
+        Log::Info() << adapterPrefix << "Device does not support work graphs.";
 
         if (desc.Flags & DXGI_ADAPTER_FLAG_SOFTWARE) {
-            std::cout
+            Log::Info()
                 << "WARP adapter does not support work graphs.\n"
                    " See readme.md#running-on-gpus-without-work-graphs-support for instructions on installing latest "
-                   "WARP adapter."
-                << std::endl;
+                   "WARP adapter.";
         }
 
         return {};
     }
 
     // Adapter does support work graphs.
-    std::cout << "Device supports work graphs." << std::endl;
+    Log::Info() << adapterPrefix << "Device supports work graphs.";
 
     return device;
 }
@@ -308,6 +687,23 @@ void Device::CreateDeviceResources()
     fenceEvent_ = CreateEventA(nullptr, false, false, nullptr);
 }
 
+void Device::ProcessCompletionTasks()
+{
+    const auto completedFenceValue = fence_->GetCompletedValue();
+
+    while (!completionTasks_.empty() && (completionTasks_.front().fenceValue <= completedFenceValue)) {
+        auto callback = std::move(completionTasks_.front().callback);
+        completionTasks_.pop_front();
+
+        // Remaining tasks must still run, e.g. to release deferred objects
+        try {
+            callback();
+        } catch (const std::exception& e) {
+            Log::Error() << "Completion task failed: " << e.what();
+        }
+    }
+}
+
 void Device::RegisterDebugMessageCallback()
 {
     static const auto callback = [](D3D12_MESSAGE_CATEGORY category,
@@ -316,7 +712,8 @@ void Device::RegisterDebugMessageCallback()
                                     LPCSTR description,
                                     void*  context) {
         if (severity == D3D12_MESSAGE_SEVERITY_CORRUPTION || severity == D3D12_MESSAGE_SEVERITY_ERROR) {
-            std::cout << "[D3D12] " << description << std::endl;
+            // Debug layer may report the same error every frame. Log writes repeated messages once per second.
+            Log::Error() << "[D3D12] " << description;
         }
     };
 
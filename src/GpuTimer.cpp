@@ -0,0 +1,121 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "GpuTimer.h"
+
+GpuTimer::GpuTimer(ID3D12Device*       device,
+                   ID3D12CommandQueue* commandQueue,
+                   std::uint32_t       timerCount,
+                   std::uint32_t       slotCount)
+    : timerCount_(timerCount), slotCount_(slotCount), slotResolved_(slotCount, false), milliseconds_(timerCount, 0.0)
+{
+    std::uint64_t frequency;
+    ThrowIfFailed(commandQueue->GetTimestampFrequency(&frequency));
+    ticksPerMillisecond_ = static_cast<double>(frequency) / 1000.0;
+
+    // Two timestamps (begin & end) per timer and slot
+    D3D12_QUERY_HEAP_DESC queryHeapDesc = {};
+    queryHeapDesc.Type                  = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+    queryHeapDesc.Count                 = 2 * timerCount_ * slotCount_;
+    queryHeapDesc.NodeMask              = 0;
+    ThrowIfFailed(device->CreateQueryHeap(&queryHeapDesc, IID_PPV_ARGS(&queryHeap_)));
+
+    CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_READBACK);
+    CD3DX12_RESOURCE_DESC   resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(queryHeapDesc.Count * sizeof(std::uint64_t));
+    ThrowIfFailed(device->CreateCommittedResource(&heapProperties,
+                                                  D3D12_HEAP_FLAG_NONE,
+                                                  &resourceDesc,
+                                                  D3D12_RESOURCE_STATE_COPY_DEST,
+                                                  nullptr,
+                                                  IID_PPV_ARGS(&readbackBuffer_)));
+}
+
+void GpuTimer::BeginFrame(const std::uint32_t slot)
+{
+    CollectResults(slot);
+
+    currentSlot_ = slot;
+}
+
+void GpuTimer::EndFrame(ID3D12GraphicsCommandList* commandList)
+{
+    const auto firstQuery = 2 * timerCount_ * currentSlot_;
+
+    commandList->ResolveQueryData(queryHeap_.Get(),
+                                  D3D12_QUERY_TYPE_TIMESTAMP,
+                                  firstQuery,
+                                  2 * timerCount_,
+                                  readbackBuffer_.Get(),
+                                  firstQuery * sizeof(std::uint64_t));
+
+    slotResolved_[currentSlot_] = true;
+}
+
+void GpuTimer::Begin(ID3D12GraphicsCommandList* commandList, const std::uint32_t timerIndex)
+{
+    commandList->EndQuery(
+        queryHeap_.Get(), D3D12_QUERY_TYPE_TIMESTAMP, 2 * (timerCount_ * currentSlot_ + timerIndex) + 0);
+}
+
+void GpuTimer::End(ID3D12GraphicsCommandList* commandList, const std::uint32_t timerIndex)
+{
+    commandList->EndQuery(
+        queryHeap_.Get(), D3D12_QUERY_TYPE_TIMESTAMP, 2 * (timerCount_ * currentSlot_ + timerIndex) + 1);
+}
+
+void GpuTimer::CollectResults(const std::uint32_t slot)
+{
+    if (!slotResolved_[slot]) {
+        return;
+    }
+
+    const auto firstQuery = 2 * timerCount_ * slot;
+
+    const D3D12_RANGE readRange = {
+        .Begin = firstQuery * sizeof(std::uint64_t),
+        .End   = (firstQuery + 2 * timerCount_) * sizeof(std::uint64_t),
+    };
+
+    void* mappedData;
+    ThrowIfFailed(readbackBuffer_->Map(0, &readRange, &mappedData));
+
+    const auto* timestamps = static_cast<const std::uint64_t*>(mappedData) + firstQuery;
+
+    for (std::uint32_t timerIndex = 0; timerIndex < timerCount_; ++timerIndex) {
+        const auto begin = timestamps[2 * timerIndex + 0];
+        const auto end   = timestamps[2 * timerIndex + 1];
+
+        // Unused timers or timers that span a GPU clock reset are reported as zero
+        milliseconds_[timerIndex] = (end > begin) ? static_cast<double>(end - begin) / ticksPerMillisecond_ : 0.0;
+    }
+
+    const D3D12_RANGE writeRange = {0, 0};
+    readbackBuffer_->Unmap(0, &writeRange);
+
+    slotResolved_[slot] = false;
+}
+
+double GpuTimer::GetMilliseconds(const std::uint32_t timerIndex) const
+{
+    return milliseconds_[timerIndex];
+}
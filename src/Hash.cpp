@@ -0,0 +1,61 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "Hash.h"
+
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+std::uint64_t HashBytes(const void* data, const std::size_t size, const std::uint64_t seed)
+{
+    static constexpr std::uint64_t Prime = 0x100000001b3ULL;
+
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+
+    std::uint64_t hash = seed;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * Prime;
+    }
+
+    return hash;
+}
+
+std::uint64_t HashFile(const std::filesystem::path& path, const std::uint64_t seed)
+{
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file) {
+        throw std::runtime_error("Failed to open file \"" + path.string() + "\"");
+    }
+
+    std::uint64_t hash = seed;
+
+    std::vector<char> buffer(64 * 1024);
+    while (file) {
+        file.read(buffer.data(), buffer.size());
+        hash = HashBytes(buffer.data(), static_cast<std::size_t>(file.gcount()), hash);
+    }
+
+    return hash;
+}
@@ -0,0 +1,131 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "Image.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+
+Image::Image(const std::uint32_t width, const std::uint32_t height)
+    : width_(width), height_(height), data_(static_cast<std::size_t>(width) * height * 3, 0)
+{
+}
+
+Image Image::Load(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file) {
+        throw std::runtime_error("Failed to open image \"" + path.string() + "\"");
+    }
+
+    std::string   magic;
+    std::uint32_t width, height, maxValue;
+    file >> magic >> width >> height >> maxValue;
+
+    if (!file || (magic != "P6") || (maxValue != 255)) {
+        throw std::runtime_error("\"" + path.string() + "\" is not an 8-bit binary PPM image.");
+    }
+
+    // Skip single whitespace after header
+    file.get();
+
+    Image image(width, height);
+    file.read(reinterpret_cast<char*>(image.data_.data()), image.data_.size());
+
+    if (!file) {
+        throw std::runtime_error("Image \"" + path.string() + "\" is truncated.");
+    }
+
+    return image;
+}
+
+void Image::Save(const std::filesystem::path& path) const
+{
+    if (path.has_parent_path()) {
+        std::filesystem::create_directories(path.parent_path());
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+    if (!file) {
+        throw std::runtime_error("Failed to write image \"" + path.string() + "\"");
+    }
+
+    file << "P6\n" << width_ << " " << height_ << "\n255\n";
+    file.write(reinterpret_cast<const char*>(data_.data()), data_.size());
+}
+
+Image::Difference Image::Compare(const Image& a, const Image& b, const std::uint32_t channelTolerance)
+{
+    if ((a.width_ != b.width_) || (a.height_ != b.height_)) {
+        throw std::runtime_error("Cannot compare images of different sizes.");
+    }
+
+    Difference difference = {};
+
+    for (std::size_t pixel = 0; pixel < a.GetPixelCount(); ++pixel) {
+        std::uint32_t maxPixelDifference = 0;
+
+        for (std::size_t channel = 0; channel < 3; ++channel) {
+            const auto index = 3 * pixel + channel;
+
+            maxPixelDifference = std::max<std::uint32_t>(maxPixelDifference, std::abs(a.data_[index] - b.data_[index]));
+        }
+
+        difference.maxChannelDifference = std::max(difference.maxChannelDifference, maxPixelDifference);
+
+        if (maxPixelDifference > channelTolerance) {
+            difference.differentPixels++;
+        }
+    }
+
+    return difference;
+}
+
+std::uint32_t Image::GetWidth() const
+{
+    return width_;
+}
+
+std::uint32_t Image::GetHeight() const
+{
+    return height_;
+}
+
+std::uint64_t Image::GetPixelCount() const
+{
+    return static_cast<std::uint64_t>(width_) * height_;
+}
+
+std::vector<std::uint8_t>& Image::GetData()
+{
+    return data_;
+}
+
+const std::vector<std::uint8_t>& Image::GetData() const
+{
+    return data_;
+}
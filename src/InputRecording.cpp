@@ -0,0 +1,95 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "InputRecording.h"
+
+#include <stdexcept>
+
+namespace {
+    struct InputFileHeader {
+        std::uint32_t magic;
+        std::uint32_t version;
+    };
+
+    // "WGIR" - Work Graph Input Recording
+    constexpr std::uint32_t InputFileMagic   = 0x52494757;
+    constexpr std::uint32_t InputFileVersion = 1;
+}  // namespace
+
+InputRecorder::InputRecorder(const std::filesystem::path& path) : file_(path, std::ios::binary | std::ios::trunc)
+{
+    if (!file_) {
+        throw std::runtime_error("Failed to open input recording file \"" + path.string() + "\"");
+    }
+
+    const InputFileHeader header = {
+        .magic   = InputFileMagic,
+        .version = InputFileVersion,
+    };
+
+    file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+void InputRecorder::RecordFrame(const InputFrame& frame)
+{
+    file_.write(reinterpret_cast<const char*>(&frame), sizeof(frame));
+}
+
+InputReplay::InputReplay(const std::filesystem::path& path) : file_(path, std::ios::binary)
+{
+    if (!file_) {
+        throw std::runtime_error("Failed to open input recording file \"" + path.string() + "\"");
+    }
+
+    InputFileHeader header = {};
+    file_.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+    if (!file_ || (header.magic != InputFileMagic) || (header.version != InputFileVersion)) {
+        throw std::runtime_error("\"" + path.string() + "\" is not a valid input recording.");
+    }
+
+    frameCount_ = (std::filesystem::file_size(path) - sizeof(InputFileHeader)) / sizeof(InputFrame);
+}
+
+bool InputReplay::NextFrame(InputFrame& frame)
+{
+    file_.read(reinterpret_cast<char*>(&frame), sizeof(frame));
+
+    return file_.gcount() == sizeof(frame);
+}
+
+bool InputReplay::PeekFrame(InputFrame& frame)
+{
+    const auto position = file_.tellg();
+    const auto result   = NextFrame(frame);
+
+    file_.clear();
+    file_.seekg(position);
+
+    return result;
+}
+
+std::uint64_t InputReplay::GetFrameCount() const
+{
+    return frameCount_;
+}
@@ -0,0 +1,317 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "Log.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "Trace.h"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct Slot {
+        // Sequence number of the slot (see Logger::Push)
+        std::atomic<std::uint64_t> sequence;
+        Log::Level                 level;
+        std::uint32_t              length;
+        char                       text[Log::MaxMessageLength];
+    };
+
+    // Bounded multi-producer single-consumer ring buffer with per-slot sequence numbers.
+    // Producers claim a slot by advancing writeIndex and publish it by setting its sequence number to index + 1.
+    // The writer thread consumes published slots in order and returns them to producers by setting their sequence
+    // number to index + MessageCapacity.
+    class Logger {
+    public:
+        Logger()
+        {
+            for (std::uint32_t index = 0; index < Log::MessageCapacity; ++index) {
+                slots_[index].sequence.store(index, std::memory_order_relaxed);
+            }
+
+            thread_ = std::thread(&Logger::Run, this);
+        }
+
+        ~Logger()
+        {
+            stop_.store(true, std::memory_order_release);
+            thread_.join();
+        }
+
+        void Push(const Log::Level level, const std::string_view message)
+        {
+            auto index = writeIndex_.load(std::memory_order_relaxed);
+
+            Slot* slot = nullptr;
+
+            while (true) {
+                slot = &slots_[index % Log::MessageCapacity];
+
+                const auto sequence   = slot->sequence.load(std::memory_order_acquire);
+                const auto difference = static_cast<std::int64_t>(sequence) - static_cast<std::int64_t>(index);
+
+                if (difference == 0) {
+                    // Slot is free, try to claim it
+                    if (writeIndex_.compare_exchange_weak(index, index + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (difference < 0) {
+                    // Ring buffer is full. Drop message instead of blocking the calling thread.
+                    droppedCount_.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                } else {
+                    // Slot was claimed by another producer
+                    index = writeIndex_.load(std::memory_order_relaxed);
+                }
+            }
+
+            slot->level  = level;
+            slot->length = static_cast<std::uint32_t>(std::min<std::size_t>(message.size(), Log::MaxMessageLength));
+            std::memcpy(slot->text, message.data(), slot->length);
+
+            // Publish slot to writer thread
+            slot->sequence.store(index + 1, std::memory_order_release);
+        }
+
+        void Flush()
+        {
+            // Messages claimed so far are written once the writer thread passed their index
+            const auto index = writeIndex_.load(std::memory_order_acquire);
+
+            while (writtenIndex_.load(std::memory_order_acquire) < index) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+    private:
+        // Time span in which repeated messages are only counted
+        static constexpr auto RepeatInterval = std::chrono::seconds(1);
+        // Repeat counts are reported early, if more distinct messages are tracked
+        static constexpr std::size_t MaxTrackedMessages = 256;
+
+        void Run()
+        {
+            Trace::SetThreadName("Log Writer");
+
+            while (true) {
+                // Read stop flag before draining, such that all messages pushed before the stop are written
+                const bool stop = stop_.load(std::memory_order_acquire);
+
+                const bool wroteMessages = Drain();
+
+                if (stop || (Clock::now() - repeatIntervalStart_ >= RepeatInterval)) {
+                    WriteRepeatCounts();
+                }
+
+                if (wroteMessages || stop) {
+                    std::cout.flush();
+                    std::cerr.flush();
+                }
+
+                if (stop) {
+                    break;
+                }
+
+                if (!wroteMessages) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                }
+            }
+        }
+
+        // Writes all published messages. Returns true if any message was consumed.
+        bool Drain()
+        {
+            bool consumed = false;
+
+            while (true) {
+                const auto index = writtenIndex_.load(std::memory_order_relaxed);
+                auto&      slot  = slots_[index % Log::MessageCapacity];
+
+                if (slot.sequence.load(std::memory_order_acquire) != index + 1) {
+                    break;
+                }
+
+                Write(slot.level, std::string(slot.text, slot.length));
+
+                // Return slot to producers
+                slot.sequence.store(index + Log::MessageCapacity, std::memory_order_release);
+                writtenIndex_.store(index + 1, std::memory_order_release);
+
+                consumed = true;
+            }
+
+            return consumed;
+        }
+
+        void Write(const Log::Level level, std::string message)
+        {
+            // Level is part of the key, such that an error is never hidden by an identical info message
+            message.insert(message.begin(), static_cast<char>('0' + static_cast<int>(level)));
+
+            const auto [it, inserted] = repeatCounts_.try_emplace(std::move(message), 0);
+
+            if (!inserted) {
+                it->second++;
+                return;
+            }
+
+            GetStream(level) << std::string_view(it->first).substr(1) << '\n';
+
+            if (repeatCounts_.size() > MaxTrackedMessages) {
+                WriteRepeatCounts();
+            }
+        }
+
+        void WriteRepeatCounts()
+        {
+            for (auto it = repeatCounts_.begin(); it != repeatCounts_.end();) {
+                // Messages without repetitions in the last interval are no longer tracked
+                if (it->second == 0) {
+                    it = repeatCounts_.erase(it);
+                    continue;
+                }
+
+                const auto level = static_cast<Log::Level>(it->first[0] - '0');
+
+                GetStream(level) << std::string_view(it->first).substr(1) << " (repeated " << it->second
+                                 << " times)\n";
+
+                it->second = 0;
+                ++it;
+            }
+
+            if (const auto dropped = droppedCount_.exchange(0, std::memory_order_relaxed); dropped != 0) {
+                std::cerr << "[Log] " << dropped << " messages were dropped, as the log buffer was full.\n";
+            }
+
+            repeatIntervalStart_ = Clock::now();
+        }
+
+        static std::ostream& GetStream(const Log::Level level)
+        {
+            return (level >= Log::Level::Warning) ? std::cerr : std::cout;
+        }
+
+        std::unique_ptr<Slot[]>    slots_        = std::make_unique<Slot[]>(Log::MessageCapacity);
+        std::atomic<std::uint64_t> writeIndex_   = 0;
+        std::atomic<std::uint64_t> writtenIndex_ = 0;
+        std::atomic<std::uint64_t> droppedCount_ = 0;
+        std::atomic<bool>          stop_         = false;
+
+        // Only accessed by writer thread. Key is level followed by message text.
+        std::unordered_map<std::string, std::uint32_t> repeatCounts_;
+        Clock::time_point                               repeatIntervalStart_ = Clock::now();
+
+        std::thread thread_;
+    };
+
+    Logger& GetLogger()
+    {
+        static Logger logger;
+        return logger;
+    }
+
+    std::atomic<Log::Level> minimumLevel = Log::Level::Info;
+}  // namespace
+
+Log::Message::Message(const Level level) : level_(level), enabled_(IsEnabled(level)) {}
+
+Log::Message::~Message()
+{
+    if (enabled_) {
+        Write(level_, stream_.view());
+    }
+}
+
+Log::Message Log::Debug()
+{
+    return Message(Level::Debug);
+}
+
+Log::Message Log::Info()
+{
+    return Message(Level::Info);
+}
+
+Log::Message Log::Warning()
+{
+    return Message(Level::Warning);
+}
+
+Log::Message Log::Error()
+{
+    return Message(Level::Error);
+}
+
+void Log::Write(const Level level, const std::string_view message)
+{
+    if (!IsEnabled(level)) {
+        return;
+    }
+
+    GetLogger().Push(level, message);
+}
+
+void Log::SetLevel(const Level level)
+{
+    minimumLevel.store(level, std::memory_order_relaxed);
+}
+
+bool Log::IsEnabled(const Level level)
+{
+    return level >= minimumLevel.load(std::memory_order_relaxed);
+}
+
+Log::Level Log::ParseLevel(const std::string_view name)
+{
+    if (name == "debug") {
+        return Level::Debug;
+    }
+    if (name == "info") {
+        return Level::Info;
+    }
+    if (name == "warning") {
+        return Level::Warning;
+    }
+    if (name == "error") {
+        return Level::Error;
+    }
+
+    throw std::runtime_error("Unknown log level \"" + std::string(name) + "\"");
+}
+
+void Log::Flush()
+{
+    GetLogger().Flush();
+}
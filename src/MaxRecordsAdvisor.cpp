@@ -0,0 +1,260 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include "MaxRecordsAdvisor.h"
+
+#include <algorithm>
+#include <cctype>
+#include <numeric>
+#include <optional>
+#include <regex>
+#include <stdexcept>
+#include <string_view>
+
+namespace {
+    bool IsSpace(const char c)
+    {
+        return std::isspace(static_cast<unsigned char>(c)) != 0;
+    }
+
+    bool IsDigit(const char c)
+    {
+        return std::isdigit(static_cast<unsigned char>(c)) != 0;
+    }
+
+    // Evaluates integer expressions with + - * / and parentheses, e.g. "8 * 8"
+    class BoundExpression {
+    public:
+        explicit BoundExpression(const std::string& expression) : expression_(expression) {}
+
+        std::optional<std::int64_t> Evaluate()
+        {
+            const auto value = ParseSum();
+            SkipWhitespace();
+
+            if (!value || (position_ != expression_.size())) {
+                return std::nullopt;
+            }
+            return value;
+        }
+
+    private:
+        void SkipWhitespace()
+        {
+            while ((position_ < expression_.size()) && IsSpace(expression_[position_])) {
+                ++position_;
+            }
+        }
+
+        bool Accept(const char c)
+        {
+            SkipWhitespace();
+
+            if ((position_ < expression_.size()) && (expression_[position_] == c)) {
+                ++position_;
+                return true;
+            }
+            return false;
+        }
+
+        std::optional<std::int64_t> ParseSum()
+        {
+            auto value = ParseProduct();
+
+            while (value) {
+                if (Accept('+')) {
+                    const auto rhs = ParseProduct();
+                    value          = rhs ? std::optional(*value + *rhs) : std::nullopt;
+                } else if (Accept('-')) {
+                    const auto rhs = ParseProduct();
+                    value          = rhs ? std::optional(*value - *rhs) : std::nullopt;
+                } else {
+                    break;
+                }
+            }
+
+            return value;
+        }
+
+        std::optional<std::int64_t> ParseProduct()
+        {
+            auto value = ParseFactor();
+
+            while (value) {
+                if (Accept('*')) {
+                    const auto rhs = ParseFactor();
+                    value          = rhs ? std::optional(*value * *rhs) : std::nullopt;
+                } else if (Accept('/')) {
+                    const auto rhs = ParseFactor();
+                    value          = (rhs && (*rhs != 0)) ? std::optional(*value / *rhs) : std::nullopt;
+                } else {
+                    break;
+                }
+            }
+
+            return value;
+        }
+
+        std::optional<std::int64_t> ParseFactor()
+        {
+            if (Accept('(')) {
+                const auto value = ParseSum();
+                return (value && Accept(')')) ? value : std::nullopt;
+            }
+
+            SkipWhitespace();
+
+            const auto begin = position_;
+            while ((position_ < expression_.size()) && IsDigit(expression_[position_])) {
+                ++position_;
+            }
+
+            // Identifiers, e.g. macros or constants, cannot be evaluated
+            if ((position_ == begin) || (position_ - begin > 9)) {
+                return std::nullopt;
+            }
+
+            return std::stoll(expression_.substr(begin, position_ - begin));
+        }
+
+        const std::string& expression_;
+        std::size_t        position_ = 0;
+    };
+
+    bool IsWhitespace(const std::string_view string)
+    {
+        return std::ranges::all_of(string, IsSpace);
+    }
+}  // namespace
+
+std::vector<MaxRecordsProbe> MaxRecordsAdvisor::ReadProbes(const std::string& source)
+{
+    static const std::regex probePattern(R"(//\s*@MaxRecordsProbe\(\s*(\d+)\s*\))");
+    static const std::regex boundPattern(R"(\[\s*MaxRecords\s*\(([^\]]*)\)\s*\])");
+    static const std::regex outputPattern(R"((?:Empty)?NodeOutput(?:Array)?\s*(?:<[^>]*>)?\s+(\w+))");
+    static const std::regex functionPattern(R"(\bvoid\s+(\w+)\s*\()");
+
+    std::vector<MaxRecordsProbe> probes;
+
+    for (auto it = std::sregex_iterator(source.begin(), source.end(), probePattern); it != std::sregex_iterator();
+         ++it)
+    {
+        const auto& match = *it;
+
+        const auto id = std::stoul(match[1].str());
+        if (id >= MaxProbeCount) {
+            throw std::runtime_error("MaxRecords probe \"" + match.str() + "\" exceeds maximum probe id " +
+                                     std::to_string(MaxProbeCount - 1) + ".");
+        }
+        if (std::ranges::any_of(probes, [&](const MaxRecordsProbe& probe) { return probe.id == id; })) {
+            throw std::runtime_error("MaxRecords probe " + std::to_string(id) + " is declared more than once.");
+        }
+
+        const auto annotationEnd = source.begin() + match.position() + match.length();
+
+        // Annotation must be directly followed by the MaxRecords attribute
+        std::smatch boundMatch;
+        if (!std::regex_search(annotationEnd, source.end(), boundMatch, boundPattern) ||
+            !IsWhitespace(std::string_view(&*annotationEnd, boundMatch.position())))
+        {
+            throw std::runtime_error("MaxRecords probe \"" + match.str() +
+                                     "\" must be followed by a [MaxRecords(...)] attribute.");
+        }
+
+        const auto boundEnd = boundMatch[0].second;
+
+        std::smatch outputMatch;
+        if (!std::regex_search(boundEnd, source.end(), outputMatch, outputPattern)) {
+            throw std::runtime_error("MaxRecords probe \"" + match.str() + "\" is not followed by a node output.");
+        }
+
+        // Node function is the last function declared before the annotation
+        std::string function;
+        for (auto functionIt = std::sregex_iterator(source.begin(), annotationEnd, functionPattern);
+             functionIt != std::sregex_iterator();
+             ++functionIt)
+        {
+            function = (*functionIt)[1].str();
+        }
+
+        const auto bound = BoundExpression(boundMatch[1].str()).Evaluate();
+
+        probes.emplace_back(MaxRecordsProbe{
+            .id                 = static_cast<std::uint32_t>(id),
+            .function           = function,
+            .output             = outputMatch[1].str(),
+            .declaredMaxRecords = (bound && (*bound > 0)) ? static_cast<std::uint32_t>(*bound) : 0,
+            .boundOffset        = static_cast<std::size_t>(boundMatch[1].first - source.begin()),
+            .boundLength        = static_cast<std::size_t>(boundMatch[1].length()),
+        });
+    }
+
+    std::ranges::sort(probes, {}, &MaxRecordsProbe::id);
+
+    return probes;
+}
+
+std::string MaxRecordsAdvisor::ApplyBounds(const std::string&                  source,
+                                           const std::vector<MaxRecordsProbe>& probes,
+                                           const std::vector<std::uint32_t>&   maxRecords)
+{
+    // Replace from back to front, such that offsets of remaining probes stay valid
+    std::vector<std::size_t> order(probes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::sort(order, std::greater<>(), [&](const std::size_t i) { return probes[i].boundOffset; });
+
+    std::string result = source;
+    for (const auto i : order) {
+        result.replace(probes[i].boundOffset, probes[i].boundLength, std::to_string(maxRecords[i]));
+    }
+
+    return result;
+}
+
+std::uint32_t MaxRecordsAdvisor::GetSuggestedMaxRecords(const std::uint32_t peakRecords)
+{
+    return std::max(peakRecords, 1u);
+}
+
+void MaxRecordsAdvisor::WriteReportHeader(std::ostream& stream)
+{
+    stream << "shader_file,probe,node_function,output,declared_max_records,peak_records,suggested_max_records,"
+              "backing_memory_saving_bytes\n";
+}
+
+void MaxRecordsAdvisor::WriteReport(std::ostream&                        stream,
+                                    const std::string&                   shaderFile,
+                                    const std::vector<MaxRecordsAdvice>& advice)
+{
+    for (const auto& entry : advice) {
+        stream << shaderFile << "," << entry.probe.id << "," << entry.probe.function << "," << entry.probe.output
+               << ",";
+        // Declared bound is unknown if it could not be evaluated
+        if (entry.probe.declaredMaxRecords != 0) {
+            stream << entry.probe.declaredMaxRecords;
+        }
+        stream << "," << entry.peakRecords << "," << entry.suggestedMaxRecords << "," << entry.backingMemorySaving
+               << "\n";
+    }
+}
@@ -0,0 +1,248 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "NodeBenchmark.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "Hash.h"
+#include "NodeCostModel.h"
+
+namespace {
+    static_assert(sizeof(D3D12_NODE_GPU_INPUT) <= WorkGraph::GpuInputStride);
+
+    using FieldGenerator = std::function<std::uint32_t(std::uint32_t recordIndex)>;
+
+    std::uint32_t ParseModulus(const std::string& field, const std::size_t offset)
+    {
+        const auto modulus = std::stoul(field.substr(offset), nullptr, 0);
+
+        if (modulus == 0) {
+            throw std::runtime_error("record field \"" + field + "\" must not use modulus zero.");
+        }
+
+        return static_cast<std::uint32_t>(modulus);
+    }
+
+    FieldGenerator ParseField(const std::string& field, const std::uint32_t fieldIndex)
+    {
+        if (field == "index") {
+            return [](std::uint32_t recordIndex) { return recordIndex; };
+        }
+        if (field.starts_with("index%")) {
+            const auto modulus = ParseModulus(field, 6);
+            return [modulus](std::uint32_t recordIndex) { return recordIndex % modulus; };
+        }
+        if (field.starts_with("random%")) {
+            const auto modulus = ParseModulus(field, 7);
+            // Each field is seeded differently, such that fields of the same record are not correlated
+            return [modulus, fieldIndex](std::uint32_t recordIndex) {
+                const auto hash = HashBytes(&recordIndex, sizeof(recordIndex), HashSeed + fieldIndex);
+                return static_cast<std::uint32_t>(hash % modulus);
+            };
+        }
+        if ((field.find('.') != std::string::npos) && field.ends_with('f')) {
+            const auto value = std::bit_cast<std::uint32_t>(std::stof(field));
+            return [value](std::uint32_t) { return value; };
+        }
+
+        const auto value = static_cast<std::uint32_t>(std::stoul(field, nullptr, 0));
+        return [value](std::uint32_t) { return value; };
+    }
+}  // namespace
+
+NodeBenchmark::RecordGenerator NodeBenchmark::ParseRecordFields(const std::string& fields)
+{
+    std::vector<FieldGenerator> fieldGenerators;
+
+    std::istringstream stream(fields);
+    std::string        field;
+
+    while (std::getline(stream, field, ',')) {
+        std::erase(field, ' ');
+
+        try {
+            fieldGenerators.emplace_back(ParseField(field, static_cast<std::uint32_t>(fieldGenerators.size())));
+        } catch (const std::invalid_argument&) {
+            throw std::runtime_error("invalid record field \"" + field + "\".");
+        }
+    }
+
+    return [fieldGenerators](std::uint32_t recordIndex, std::span<std::byte> record) {
+        std::ranges::fill(record, std::byte(0));
+
+        const auto fieldCount = std::min(fieldGenerators.size(), record.size() / sizeof(std::uint32_t));
+
+        for (std::size_t fieldIndex = 0; fieldIndex < fieldCount; ++fieldIndex) {
+            const auto value = fieldGenerators[fieldIndex](recordIndex);
+            std::memcpy(record.data() + fieldIndex * sizeof(std::uint32_t), &value, sizeof(value));
+        }
+    };
+}
+
+NodeBenchmark::RecordGenerator NodeBenchmark::LoadRecordFile(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file) {
+        throw std::runtime_error("Failed to open record file \"" + path.string() + "\"");
+    }
+
+    const auto data =
+        std::make_shared<std::vector<char>>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    return [data, path](std::uint32_t recordIndex, std::span<std::byte> record) {
+        if (record.empty()) {
+            return;
+        }
+        if (data->empty() || (data->size() % record.size() != 0)) {
+            throw std::runtime_error("record file \"" + path.string() + "\" does not contain records of " +
+                                     std::to_string(record.size()) + " bytes.");
+        }
+
+        const auto fileRecordCount = data->size() / record.size();
+
+        std::memcpy(record.data(), data->data() + (recordIndex % fileRecordCount) * record.size(), record.size());
+    };
+}
+
+WorkGraph::EntryNode NodeBenchmark::FindNode(ShaderCompiler&    shaderCompiler,
+                                             IDxcBlob*          library,
+                                             const std::string& node)
+{
+    // Split node ID into name and array index, e.g. "ShadePixel[1]"
+    auto          name       = node;
+    std::uint32_t arrayIndex = 0;
+
+    if (const auto bracket = node.find('['); (bracket != std::string::npos) && node.ends_with(']')) {
+        name       = node.substr(0, bracket);
+        arrayIndex = static_cast<std::uint32_t>(std::stoul(node.substr(bracket + 1)));
+    }
+
+    const auto nodes = NodeCostModel::Analyze(shaderCompiler.Disassemble(library));
+
+    // Node IDs take precedence over function names
+    auto it = std::ranges::find_if(
+        nodes, [&](const NodeCost& cost) { return (cost.name == name) && (cost.arrayIndex == arrayIndex); });
+
+    if (it == nodes.end()) {
+        it = std::ranges::find(nodes, node, &NodeCost::functionName);
+    }
+
+    if (it == nodes.end()) {
+        throw std::runtime_error("work graph does not contain node \"" + node + "\".");
+    }
+
+    return {
+        .name         = it->name,
+        .arrayIndex   = it->arrayIndex,
+        .functionName = it->functionName,
+    };
+}
+
+NodeBenchmark::NodeBenchmark(const Device*              device,
+                             ID3D12GraphicsCommandList* commandList,
+                             const WorkGraph&           workGraph,
+                             const std::uint32_t        recordCount,
+                             const RecordGenerator&     generator,
+                             const std::uint32_t        maxBatchRecordCount)
+{
+    const auto batchRecordCount = ((maxBatchRecordCount > 0) && (maxBatchRecordCount < recordCount))
+                                      ? maxBatchRecordCount
+                                      : std::max(recordCount, 1u);
+
+    batchCount_ = (std::max(recordCount, 1u) + batchRecordCount - 1) / batchRecordCount;
+
+    // Records follow the D3D12_NODE_GPU_INPUT of all batches
+    const auto recordsOffset = std::uint64_t(batchCount_) * WorkGraph::GpuInputStride;
+    const auto recordSize    = workGraph.GetEntryRecordSize();
+    const auto bufferSize    = recordsOffset + std::uint64_t(recordCount) * recordSize;
+
+    // Records are uploaded once and read from GPU memory by every dispatch
+    {
+        CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_UPLOAD);
+        CD3DX12_RESOURCE_DESC   resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(bufferSize);
+        ThrowIfFailed(device->GetDevice()->CreateCommittedResource(&heapProperties,
+                                                                   D3D12_HEAP_FLAG_NONE,
+                                                                   &resourceDesc,
+                                                                   D3D12_RESOURCE_STATE_GENERIC_READ,
+                                                                   nullptr,
+                                                                   IID_PPV_ARGS(&uploadBuffer_)));
+    }
+    {
+        CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_DEFAULT);
+        CD3DX12_RESOURCE_DESC   resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(bufferSize);
+        ThrowIfFailed(device->GetDevice()->CreateCommittedResource(&heapProperties,
+                                                                   D3D12_HEAP_FLAG_NONE,
+                                                                   &resourceDesc,
+                                                                   D3D12_RESOURCE_STATE_COPY_DEST,
+                                                                   nullptr,
+                                                                   IID_PPV_ARGS(&inputBuffer_)));
+    }
+
+    std::byte* data = nullptr;
+    ThrowIfFailed(uploadBuffer_->Map(0, nullptr, reinterpret_cast<void**>(&data)));
+
+    for (std::uint32_t batch = 0; batch < batchCount_; ++batch) {
+        const auto firstRecord = batch * batchRecordCount;
+
+        D3D12_NODE_GPU_INPUT input  = {};
+        input.EntrypointIndex       = workGraph.GetEntryPointIndex();
+        input.NumRecords            = std::min(batchRecordCount, recordCount - firstRecord);
+        input.Records.StartAddress  = inputBuffer_->GetGPUVirtualAddress() + recordsOffset +
+                                     std::uint64_t(firstRecord) * recordSize;
+        input.Records.StrideInBytes = recordSize;
+        std::memcpy(data + std::uint64_t(batch) * WorkGraph::GpuInputStride, &input, sizeof(input));
+    }
+
+    for (std::uint32_t recordIndex = 0; recordIndex < recordCount; ++recordIndex) {
+        generator(recordIndex, std::span(data + recordsOffset + std::uint64_t(recordIndex) * recordSize, recordSize));
+    }
+
+    uploadBuffer_->Unmap(0, nullptr);
+
+    commandList->CopyResource(inputBuffer_.Get(), uploadBuffer_.Get());
+
+    // Input is read by DispatchGraph like indirect arguments, records are read by the entry node
+    const auto barrier = CD3DX12_RESOURCE_BARRIER::Transition(
+        inputBuffer_.Get(),
+        D3D12_RESOURCE_STATE_COPY_DEST,
+        D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+    commandList->ResourceBarrier(1, &barrier);
+}
+
+D3D12_GPU_VIRTUAL_ADDRESS NodeBenchmark::GetGpuInput() const
+{
+    return inputBuffer_->GetGPUVirtualAddress();
+}
+
+std::uint32_t NodeBenchmark::GetBatchCount() const
+{
+    return batchCount_;
+}
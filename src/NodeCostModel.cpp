@@ -0,0 +1,617 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "NodeCostModel.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <map>
+#include <string_view>
+#include <unordered_map>
+
+namespace {
+    // Weights of instruction classes relative to a plain ALU instruction
+    constexpr double UavWriteWeight   = 4;
+    constexpr double TypedWriteWeight = 8;
+    constexpr double AtomicWeight     = 16;
+    constexpr double BarrierWeight    = 32;
+    constexpr double OutputCallWeight = 8;
+    // Upper limit for weights & invocation counts, e.g. for deep recursion
+    constexpr double MaxWeight        = 1e15;
+
+    // DXIL metadata tags, see DxilConstants.h in DirectXShaderCompiler
+    constexpr std::int64_t NumThreadsTag            = 4;
+    constexpr std::int64_t NodeLaunchTypeTag        = 13;
+    constexpr std::int64_t NodeIsProgramEntryTag    = 14;
+    constexpr std::int64_t NodeIdTag                = 15;
+    constexpr std::int64_t NodeDispatchGridTag      = 18;
+    constexpr std::int64_t NodeMaxRecursionDepthTag = 19;
+    constexpr std::int64_t NodeInputsTag            = 20;
+    constexpr std::int64_t NodeOutputsTag           = 21;
+    constexpr std::int64_t NodeMaxDispatchGridTag   = 22;
+
+    constexpr std::int64_t NodeOutputIdTag             = 0;
+    constexpr std::int64_t NodeMaxRecordsTag           = 3;
+    constexpr std::int64_t NodeMaxRecordsSharedWithTag = 4;
+    constexpr std::int64_t NodeOutputArraySizeTag      = 5;
+
+    // Values of NodeLaunchTypeTag
+    constexpr std::int64_t BroadcastingLaunch = 1;
+    constexpr std::int64_t CoalescingLaunch   = 2;
+    constexpr std::int64_t ThreadLaunch       = 3;
+
+    std::string_view Trim(std::string_view string)
+    {
+        const auto begin = string.find_first_not_of(" \t\r");
+        if (begin == std::string_view::npos) {
+            return {};
+        }
+        const auto end = string.find_last_not_of(" \t\r");
+        return string.substr(begin, end - begin + 1);
+    }
+
+    // Parses last integer of an element, e.g. "i32 5" or "%7 = icmp slt i32 %6, 256"
+    bool TryParseInteger(std::string_view element, std::int64_t& value)
+    {
+        element = Trim(element);
+
+        const auto separator = element.find_last_of(" ,");
+        if (separator != std::string_view::npos) {
+            element = element.substr(separator + 1);
+        }
+
+        const auto [end, error] = std::from_chars(element.data(), element.data() + element.size(), value);
+        return (error == std::errc()) && (end == element.data() + element.size());
+    }
+
+    std::int64_t ParseInteger(std::string_view element, const std::int64_t defaultValue)
+    {
+        std::int64_t value;
+        return TryParseInteger(element, value) ? value : defaultValue;
+    }
+
+    // Parses metadata string, e.g. !"Entry"
+    std::string ParseString(std::string_view element)
+    {
+        element = Trim(element);
+
+        if ((element.size() < 3) || !element.starts_with("!\"")) {
+            return {};
+        }
+
+        return std::string(element.substr(2, element.size() - 3));
+    }
+
+    // Returns name of global referenced in "line", e.g. @main or @"\01?Entry@@YAXXZ"
+    std::string ParseGlobalName(std::string_view line)
+    {
+        const auto begin = line.find('@');
+        if (begin == std::string_view::npos) {
+            return {};
+        }
+
+        line = line.substr(begin + 1);
+
+        if (line.starts_with('"')) {
+            return std::string(line.substr(0, line.find('"', 1) + 1));
+        }
+
+        return std::string(line.substr(0, line.find_first_of("(, ")));
+    }
+
+    // Metadata nodes of a DXIL module, e.g. "!5 = !{i32 1, !6}" or "!dx.entryPoints = !{!3}"
+    class Metadata {
+    public:
+        Metadata(const std::vector<std::string_view>& lines)
+        {
+            for (const auto& line : lines) {
+                if (!line.starts_with('!')) {
+                    continue;
+                }
+
+                const auto separator = line.find(" = ");
+                if (separator == std::string_view::npos) {
+                    continue;
+                }
+
+                auto value = Trim(line.substr(separator + 3));
+                if (value.starts_with("distinct ")) {
+                    value = value.substr(9);
+                }
+
+                tuples_[std::string(line.substr(1, separator - 1))] = SplitTuple(value);
+            }
+        }
+
+        // Returns elements of tuple referenced by "reference", e.g. "!5"
+        const std::vector<std::string>& GetTuple(std::string_view reference) const
+        {
+            static const std::vector<std::string> Empty;
+
+            reference = Trim(reference);
+            if (!reference.starts_with('!')) {
+                return Empty;
+            }
+
+            const auto it = tuples_.find(std::string(reference.substr(1)));
+            return (it != tuples_.end()) ? it->second : Empty;
+        }
+
+        // Returns tag-value pairs of tuple referenced by "reference"
+        std::map<std::int64_t, std::string> GetProperties(std::string_view reference) const
+        {
+            std::map<std::int64_t, std::string> properties;
+
+            const auto& tuple = GetTuple(reference);
+            for (std::size_t i = 0; (i + 1) < tuple.size(); i += 2) {
+                properties[ParseInteger(tuple[i], -1)] = tuple[i + 1];
+            }
+
+            return properties;
+        }
+
+    private:
+        // Splits "!{a, b, c}" into elements. Ignores commas in strings and nested brackets.
+        static std::vector<std::string> SplitTuple(std::string_view value)
+        {
+            std::vector<std::string> elements;
+
+            const auto begin = value.find('{');
+            const auto end   = value.rfind('}');
+            if ((begin == std::string_view::npos) || (end == std::string_view::npos) || (end <= begin)) {
+                return elements;
+            }
+
+            value = value.substr(begin + 1, end - begin - 1);
+
+            int         depth    = 0;
+            bool        inString = false;
+            std::size_t start    = 0;
+
+            for (std::size_t i = 0; i < value.size(); ++i) {
+                const char c = value[i];
+
+                if (c == '"') {
+                    inString = !inString;
+                } else if (!inString && ((c == '(') || (c == '[') || (c == '{'))) {
+                    depth++;
+                } else if (!inString && ((c == ')') || (c == ']') || (c == '}'))) {
+                    depth--;
+                } else if (!inString && (depth == 0) && (c == ',')) {
+                    elements.emplace_back(Trim(value.substr(start, i - start)));
+                    start = i + 1;
+                }
+            }
+
+            if (!Trim(value.substr(start)).empty()) {
+                elements.emplace_back(Trim(value.substr(start)));
+            }
+
+            return elements;
+        }
+
+        std::unordered_map<std::string, std::vector<std::string>> tuples_;
+    };
+
+    // Analyzes instructions of a single function body
+    void AnalyzeFunction(const std::vector<std::string_view>& body, NodeCost& cost)
+    {
+        // Line index of basic block labels, e.g. "; <label>:12" or "for.body:"
+        std::unordered_map<std::string_view, std::size_t> labels;
+        // Line index of value definitions, e.g. "%12 = ..."
+        std::unordered_map<std::string_view, std::size_t> definitions;
+
+        for (std::size_t i = 0; i < body.size(); ++i) {
+            const auto& line = body[i];
+
+            if (line.starts_with("; <label>:")) {
+                const auto label = line.substr(10);
+                labels[label.substr(0, label.find_first_of(" \t"))] = i;
+            } else if (!line.empty() && (line[0] != ' ') && (line[0] != ';') && (line.find(':') != line.npos)) {
+                labels[line.substr(0, line.find(':'))] = i;
+            } else {
+                const auto instruction = Trim(line);
+                const auto separator   = instruction.find(" = ");
+
+                if (instruction.starts_with('%') && (separator != std::string_view::npos)) {
+                    definitions[instruction.substr(1, separator - 1)] = i;
+                }
+            }
+        }
+
+        // Returns constant bound of integer comparison used as branch condition in "line", e.g. "br i1 %7, ..."
+        const auto GetLoopBound = [&](std::string_view line) -> double {
+            line = Trim(line);
+            if (!line.starts_with("br i1 %")) {
+                return 0;
+            }
+
+            const auto condition  = line.substr(7, line.find(',') - 7);
+            const auto definition = definitions.find(condition);
+            if (definition == definitions.end()) {
+                return 0;
+            }
+
+            const auto& instruction = body[definition->second];
+
+            std::int64_t bound;
+            if ((instruction.find(" icmp ") == std::string_view::npos) || !TryParseInteger(instruction, bound)) {
+                return 0;
+            }
+
+            // Comparisons against 0 or 1 are usually not loop counters
+            bound = std::abs(bound);
+            return (bound > 1) ? static_cast<double>(bound) : 0;
+        };
+
+        struct Loop {
+            std::size_t begin;
+            std::size_t end;
+            double      tripCount;
+        };
+
+        std::vector<Loop> loops;
+
+        for (std::size_t i = 0; i < body.size(); ++i) {
+            const auto instruction = Trim(body[i]);
+            if (!instruction.starts_with("br ")) {
+                continue;
+            }
+
+            // Branches to earlier blocks are loop back-edges
+            for (auto position = instruction.find("label %"); position != std::string_view::npos;
+                 position      = instruction.find("label %", position + 1))
+            {
+                const auto target = instruction.substr(position + 7, instruction.find_first_of(", ", position + 7) -
+                                                                         (position + 7));
+                const auto label  = labels.find(target);
+
+                if ((label == labels.end()) || (label->second > i)) {
+                    continue;
+                }
+
+                // Use bound of back-edge condition or first conditional branch in loop
+                double tripCount = GetLoopBound(instruction);
+                for (std::size_t j = label->second; (tripCount == 0) && (j < i); ++j) {
+                    tripCount = GetLoopBound(body[j]);
+                }
+
+                loops.push_back({
+                    .begin     = label->second,
+                    .end       = i,
+                    .tripCount = (tripCount > 0) ? tripCount : NodeCostModel::DefaultLoopTripCount,
+                });
+            }
+        }
+
+        cost.loops = static_cast<std::uint32_t>(loops.size());
+
+        // Weight instructions by trip count of all enclosing loops
+        std::vector<double> weights(body.size(), 1.0);
+        for (const auto& loop : loops) {
+            for (std::size_t i = loop.begin; i <= loop.end; ++i) {
+                weights[i] = std::min(weights[i] * loop.tripCount, MaxWeight);
+            }
+        }
+
+        for (std::size_t i = 0; i < body.size(); ++i) {
+            const auto& line        = body[i];
+            const auto  instruction = Trim(line);
+
+            // Instructions are indented, labels & comments are not
+            if (!line.starts_with("  ") || instruction.empty() || instruction.starts_with(';')) {
+                continue;
+            }
+
+            cost.instructions++;
+
+            double weight = 1.0;
+
+            if (const auto position = instruction.find("@dx.op."); position != std::string_view::npos) {
+                const auto operation =
+                    instruction.substr(position + 7, instruction.find_first_of(".(", position + 7) - (position + 7));
+
+                if (operation == "rawBufferStore") {
+                    cost.uavWrites++;
+                    weight = UavWriteWeight;
+                } else if ((operation == "bufferStore") || operation.starts_with("textureStore")) {
+                    cost.typedWrites++;
+                    weight = TypedWriteWeight;
+                } else if ((operation == "atomicBinOp") || (operation == "atomicCompareExchange")) {
+                    cost.atomics++;
+                    weight = AtomicWeight;
+                } else if (operation.starts_with("barrier")) {
+                    cost.barriers++;
+                    weight = BarrierWeight;
+                } else if ((operation == "allocateNodeOutputRecords") || (operation == "outputComplete") ||
+                           (operation == "incrementOutputCount"))
+                {
+                    cost.outputCalls++;
+                    weight = OutputCallWeight;
+                }
+            } else if ((instruction.find(" atomicrmw ") != std::string_view::npos) ||
+                       (instruction.find(" cmpxchg ") != std::string_view::npos))
+            {
+                // Atomics on groupshared memory or node records
+                cost.atomics++;
+                weight = AtomicWeight;
+            }
+
+            cost.threadCost = std::min(cost.threadCost + weights[i] * weight, MaxWeight);
+        }
+    }
+
+    struct NodeOutput {
+        std::string   name;
+        std::uint32_t arrayIndex = 0;
+        std::uint32_t arraySize  = 1;
+        double        maxRecords = 1;
+    };
+
+    struct Node {
+        NodeCost                cost;
+        std::int64_t            launchType        = BroadcastingLaunch;
+        bool                    isEntry           = false;
+        double                  dispatchGroups    = 1;
+        double                  maxRecursionDepth = 1;
+        std::vector<NodeOutput> outputs;
+    };
+
+    bool Targets(const NodeOutput& output, const Node& node)
+    {
+        return (output.name == node.cost.name) && (node.cost.arrayIndex >= output.arrayIndex) &&
+               (node.cost.arrayIndex - output.arrayIndex < output.arraySize);
+    }
+}  // namespace
+
+std::vector<NodeCost> NodeCostModel::Analyze(const std::string& disassembly)
+{
+    std::vector<std::string_view> lines;
+    {
+        std::string_view remaining = disassembly;
+        while (!remaining.empty()) {
+            const auto end = remaining.find('\n');
+            lines.emplace_back(remaining.substr(0, end));
+            remaining = (end == std::string_view::npos) ? std::string_view() : remaining.substr(end + 1);
+        }
+    }
+
+    // Collect function bodies
+    std::unordered_map<std::string, std::vector<std::string_view>> functions;
+    for (std::size_t i = 0; i < lines.size(); ++i) {
+        if (!lines[i].starts_with("define ")) {
+            continue;
+        }
+
+        auto& body = functions[ParseGlobalName(lines[i])];
+        for (++i; (i < lines.size()) && (lines[i] != "}"); ++i) {
+            body.emplace_back(lines[i]);
+        }
+    }
+
+    const Metadata metadata(lines);
+
+    // Collect nodes from entry points
+    std::vector<Node> nodes;
+
+    for (const auto& entryPoint : metadata.GetTuple("!dx.entryPoints")) {
+        const auto& entry = metadata.GetTuple(entryPoint);
+        if (entry.size() < 5) {
+            continue;
+        }
+
+        const auto properties = metadata.GetProperties(entry[4]);
+
+        if (!properties.contains(NodeIdTag)) {
+            // Not a node, e.g. library entry
+            continue;
+        }
+
+        Node node;
+
+        const auto& nodeId     = metadata.GetTuple(properties.at(NodeIdTag));
+        node.cost.name         = nodeId.empty() ? "" : ParseString(nodeId[0]);
+        node.cost.arrayIndex   = (nodeId.size() < 2) ? 0 : static_cast<std::uint32_t>(ParseInteger(nodeId[1], 0));
+        node.cost.functionName = ParseString(entry[1]);
+
+        if (properties.contains(NodeLaunchTypeTag)) {
+            node.launchType = ParseInteger(properties.at(NodeLaunchTypeTag), BroadcastingLaunch);
+        }
+        node.cost.launchType = (node.launchType == CoalescingLaunch) ? "Coalescing"
+                               : (node.launchType == ThreadLaunch)   ? "Thread"
+                                                                     : "Broadcasting";
+
+        if (properties.contains(NumThreadsTag)) {
+            const auto& numThreads = metadata.GetTuple(properties.at(NumThreadsTag));
+            for (std::size_t i = 0; (i < numThreads.size()) && (i < 3); ++i) {
+                node.cost.numThreads[i] = static_cast<std::uint32_t>(ParseInteger(numThreads[i], 1));
+            }
+        }
+
+        // Fixed dispatch grid, or worst case of dynamic dispatch grid
+        for (const auto tag : {NodeDispatchGridTag, NodeMaxDispatchGridTag}) {
+            if (properties.contains(tag)) {
+                node.dispatchGroups = 1;
+                for (const auto& dimension : metadata.GetTuple(properties.at(tag))) {
+                    node.dispatchGroups *= std::max<std::int64_t>(ParseInteger(dimension, 1), 1);
+                }
+            }
+        }
+
+        if (properties.contains(NodeMaxRecursionDepthTag)) {
+            const auto maxRecursionDepth = ParseInteger(properties.at(NodeMaxRecursionDepthTag), 1);
+            node.maxRecursionDepth       = static_cast<double>(std::max<std::int64_t>(maxRecursionDepth, 1));
+        }
+
+        node.isEntry = (properties.contains(NodeIsProgramEntryTag) &&
+                        (ParseInteger(properties.at(NodeIsProgramEntryTag), 0) != 0)) ||
+                       !properties.contains(NodeInputsTag);
+
+        if (properties.contains(NodeOutputsTag)) {
+            const auto& outputs = metadata.GetTuple(properties.at(NodeOutputsTag));
+
+            for (const auto& outputReference : outputs) {
+                const auto outputProperties = metadata.GetProperties(outputReference);
+
+                NodeOutput output;
+
+                if (outputProperties.contains(NodeOutputIdTag)) {
+                    const auto& outputId = metadata.GetTuple(outputProperties.at(NodeOutputIdTag));
+
+                    output.name = outputId.empty() ? "" : ParseString(outputId[0]);
+                    if (outputId.size() >= 2) {
+                        output.arrayIndex = static_cast<std::uint32_t>(ParseInteger(outputId[1], 0));
+                    }
+                }
+                if (outputProperties.contains(NodeOutputArraySizeTag)) {
+                    // Unbounded arrays are stored as -1, which covers all indices as unsigned size
+                    const auto arraySize = ParseInteger(outputProperties.at(NodeOutputArraySizeTag), 1);
+                    output.arraySize     = std::max(static_cast<std::uint32_t>(arraySize), 1u);
+                }
+                if (outputProperties.contains(NodeMaxRecordsTag)) {
+                    output.maxRecords = static_cast<double>(ParseInteger(outputProperties.at(NodeMaxRecordsTag), 1));
+                } else if (outputProperties.contains(NodeMaxRecordsSharedWithTag)) {
+                    // Budget is shared with another output, which may use all records
+                    const auto sharedWith = ParseInteger(outputProperties.at(NodeMaxRecordsSharedWithTag), -1);
+                    if ((sharedWith >= 0) && (sharedWith < static_cast<std::int64_t>(outputs.size()))) {
+                        const auto sharedProperties = metadata.GetProperties(outputs[sharedWith]);
+                        if (sharedProperties.contains(NodeMaxRecordsTag)) {
+                            output.maxRecords =
+                                static_cast<double>(ParseInteger(sharedProperties.at(NodeMaxRecordsTag), 1));
+                        }
+                    }
+                }
+
+                node.outputs.emplace_back(std::move(output));
+            }
+        }
+
+        if (const auto function = functions.find(ParseGlobalName(entry[0])); function != functions.end()) {
+            AnalyzeFunction(function->second, node.cost);
+        }
+
+        nodes.emplace_back(std::move(node));
+    }
+
+    // Propagate worst-case record counts from entry nodes to all consumers in topological order.
+    // Work graphs only allow recursion of a node to itself, which is handled separately.
+    std::vector<double>      records(nodes.size(), 0.0);
+    std::vector<std::size_t> producerCount(nodes.size(), 0);
+
+    for (std::size_t producer = 0; producer < nodes.size(); ++producer) {
+        for (const auto& output : nodes[producer].outputs) {
+            for (std::size_t consumer = 0; consumer < nodes.size(); ++consumer) {
+                if ((consumer != producer) && Targets(output, nodes[consumer])) {
+                    producerCount[consumer]++;
+                }
+            }
+        }
+    }
+
+    std::vector<std::size_t> queue;
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        if (nodes[i].isEntry) {
+            records[i] = 1;
+        }
+        if (producerCount[i] == 0) {
+            queue.emplace_back(i);
+        }
+    }
+
+    for (std::size_t queueIndex = 0; queueIndex < queue.size(); ++queueIndex) {
+        const auto producer = queue[queueIndex];
+        auto&      node     = nodes[producer];
+
+        // Thread groups per input record
+        const double groupsPerRecord = (node.launchType == BroadcastingLaunch) ? node.dispatchGroups : 1.0;
+
+        double selfRecords = 0;
+        for (const auto& output : node.outputs) {
+            if (Targets(output, node)) {
+                selfRecords += output.maxRecords;
+            }
+        }
+
+        // Geometric series over all recursion levels
+        double invocations      = records[producer] * groupsPerRecord;
+        double levelInvocations = invocations;
+        for (double level = 1; level < node.maxRecursionDepth; ++level) {
+            levelInvocations = std::min(levelInvocations * selfRecords * groupsPerRecord, MaxWeight);
+            invocations      = std::min(invocations + levelInvocations, MaxWeight);
+        }
+
+        node.cost.invocations = invocations;
+
+        for (const auto& output : node.outputs) {
+            for (std::size_t consumer = 0; consumer < nodes.size(); ++consumer) {
+                if ((consumer == producer) || !Targets(output, nodes[consumer])) {
+                    continue;
+                }
+
+                records[consumer] = std::min(records[consumer] + invocations * output.maxRecords, MaxWeight);
+
+                if (--producerCount[consumer] == 0) {
+                    queue.emplace_back(consumer);
+                }
+            }
+        }
+    }
+
+    std::vector<NodeCost> result;
+
+    for (auto& node : nodes) {
+        const double threadsPerInvocation =
+            (node.launchType == ThreadLaunch)
+                ? 1.0
+                : double(node.cost.numThreads[0]) * node.cost.numThreads[1] * node.cost.numThreads[2];
+
+        node.cost.estimatedCost =
+            std::min(node.cost.threadCost * threadsPerInvocation * node.cost.invocations, MaxWeight);
+
+        result.emplace_back(std::move(node.cost));
+    }
+
+    std::sort(result.begin(), result.end(), [](const NodeCost& a, const NodeCost& b) {
+        return a.estimatedCost > b.estimatedCost;
+    });
+
+    return result;
+}
+
+void NodeCostModel::WriteReportHeader(std::ostream& stream)
+{
+    stream << "shader,node,array index,launch,threads,invocations,instructions,loops,uav writes,typed writes,atomics,"
+              "barriers,output calls,thread cost,estimated cost\n";
+}
+
+void NodeCostModel::WriteReport(std::ostream& stream, const std::string& shaderFile, const std::vector<NodeCost>& nodes)
+{
+    for (const auto& node : nodes) {
+        stream << shaderFile << "," << node.name << "," << node.arrayIndex << "," << node.launchType << ","
+               << node.numThreads[0] << "x" << node.numThreads[1] << "x" << node.numThreads[2] << ","
+               << node.invocations << "," << node.instructions << "," << node.loops << "," << node.uavWrites << ","
+               << node.typedWrites << "," << node.atomics << "," << node.barriers << "," << node.outputCalls << ","
+               << node.threadCost << "," << node.estimatedCost << "\n";
+    }
+}
@@ -0,0 +1,164 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "OptimizationReport.h"
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "Application.h"
+#include "Log.h"
+#include "NodeCostModel.h"
+#include "Trace.h"
+
+std::vector<OptimizationReport::Variant> OptimizationReport::GetVariants()
+{
+    struct FloatMode {
+        const char*  name;
+        std::wstring denormMode;
+        bool         ieeeStrictness;
+    };
+
+    const std::vector<FloatMode> floatModes = {
+        {"default", L"", false},
+        {"ftz", L"ftz", false},
+        {"preserve", L"preserve", false},
+        {"ieee", L"", true},
+    };
+
+    std::vector<Variant> variants;
+
+    for (int optimizationLevel = 0; optimizationLevel <= 3; ++optimizationLevel) {
+        for (const bool enable16BitTypes : {true, false}) {
+            for (const auto& floatMode : floatModes) {
+                std::stringstream name;
+                name << "O" << optimizationLevel << (enable16BitTypes ? " 16bit " : " 32bit ") << floatMode.name;
+
+                variants.push_back({
+                    .name    = name.str(),
+                    .options = {
+                        .optimizationLevel = optimizationLevel,
+                        .enable16BitTypes  = enable16BitTypes,
+                        .denormMode        = floatMode.denormMode,
+                        .ieeeStrictness    = floatMode.ieeeStrictness,
+                    },
+                });
+            }
+        }
+    }
+
+    return variants;
+}
+
+void OptimizationReport::Write(const std::filesystem::path&  file,
+                               ShaderCompiler&               shaderCompiler,
+                               const MeasureGpuTimeFunction& measureGpuTime)
+{
+    const Trace::Scope traceScope("OptimizationReport::Write");
+
+    std::ofstream report(file, std::ios::trunc);
+
+    if (!report) {
+        throw std::runtime_error("Failed to open file \"" + file.string() + "\"");
+    }
+
+    report << "shader,variant,arguments,result,compile_ms,dxil_bytes,gpu_ms,node,instructions,loops,thread_cost,"
+              "estimated_cost\n";
+
+    const auto tutorials = Application::GetTutorials();
+    const auto variants  = GetVariants();
+
+    for (std::uint32_t tutorialIndex = 0; tutorialIndex < tutorials.size(); ++tutorialIndex) {
+        for (const bool sampleSolution : {false, true}) {
+            const auto& tutorial   = tutorials[tutorialIndex];
+            const auto& shaderFile = sampleSolution ? tutorial.solutionShaderFileName : tutorial.shaderFileName;
+
+            if (shaderFile.empty()) {
+                continue;
+            }
+
+            for (const auto& variant : variants) {
+                const auto request =
+                    shaderCompiler.CreateCompileRequest(shaderFile, L"lib_6_8", nullptr, variant.options);
+
+                std::string arguments;
+                for (const auto& argument : request.arguments) {
+                    arguments += (arguments.empty() ? "" : " ") + std::filesystem::path(argument).string();
+                }
+
+                // Compile in-process without shader pack or compile server, to measure the compiler itself
+                const auto compileStart = std::chrono::steady_clock::now();
+                const auto result       = shaderCompiler.Compile(request);
+                const auto compileTime =
+                    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - compileStart).count();
+
+                if (!result.success) {
+                    Log::Info() << shaderFile << " [" << variant.name << "]: compile error";
+                    report << shaderFile << "," << variant.name << "," << arguments << ",compile error,"
+                           << compileTime << ",,,,,,,\n";
+                    continue;
+                }
+
+                double gpuTime = -1.0;
+                if (measureGpuTime) {
+                    try {
+                        gpuTime = measureGpuTime(tutorialIndex, sampleSolution, result.blob);
+                    } catch (const std::exception& e) {
+                        Log::Error() << shaderFile << " [" << variant.name << "]: " << e.what();
+                    }
+                }
+
+                const auto nodes = NodeCostModel::Analyze(shaderCompiler.Disassemble(result.blob.Get()));
+
+                std::uint32_t instructions = 0;
+                for (const auto& node : nodes) {
+                    instructions += node.instructions;
+                }
+
+                {
+                    auto message = Log::Info();
+                    message << shaderFile << " [" << variant.name << "]: compile " << std::fixed
+                            << std::setprecision(1) << compileTime << "ms, " << result.blob->GetBufferSize()
+                            << " bytes, " << instructions << " instructions";
+                    if (gpuTime >= 0) {
+                        message << ", GPU " << std::setprecision(3) << gpuTime << "ms";
+                    }
+                }
+
+                for (const auto& node : nodes) {
+                    report << shaderFile << "," << variant.name << "," << arguments << ",ok," << compileTime << ","
+                           << result.blob->GetBufferSize() << ",";
+                    if (gpuTime >= 0) {
+                        report << gpuTime;
+                    }
+                    report << "," << node.name << "[" << node.arrayIndex << "]," << node.instructions << ","
+                           << node.loops << "," << node.threadCost << "," << node.estimatedCost << "\n";
+                }
+            }
+        }
+    }
+
+    Log::Info() << "Optimization report written to " << file.string();
+}
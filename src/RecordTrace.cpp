@@ -0,0 +1,412 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include "RecordTrace.h"
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <regex>
+#include <stdexcept>
+
+namespace {
+    struct RecordTraceFileHeader {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint64_t frame;
+        std::uint64_t appendedEventCount;
+        std::uint32_t eventCount;
+        std::uint32_t nodeNameCount;
+        std::uint32_t shaderFileNameSize;
+        std::uint32_t reserved;
+    };
+
+    // "WGRT" - Work Graph Record Trace
+    constexpr std::uint32_t RecordTraceFileMagic   = 0x54524757;
+    constexpr std::uint32_t RecordTraceFileVersion = 1;
+
+    std::string GetNodeName(const RecordTraceCapture& capture, std::uint32_t node)
+    {
+        const auto it = capture.nodeNames.find(node);
+
+        return (it != capture.nodeNames.end()) ? it->second : "Node " + std::to_string(node);
+    }
+
+    void WriteEscaped(std::ostream& stream, const std::string& string)
+    {
+        for (const auto c : string) {
+            if ((c == '"') || (c == '\\')) {
+                stream << '\\';
+            }
+            stream << c;
+        }
+    }
+
+    std::uint64_t GetFanOut(const RecordTraceTree::Group& group)
+    {
+        std::uint64_t fanOut = 0;
+        for (const auto& output : group.outputs) {
+            fanOut += output.recordCount;
+        }
+        return fanOut;
+    }
+}  // namespace
+
+std::map<std::uint32_t, std::string> RecordTrace::ReadNodeNames(const std::filesystem::path& shaderFile)
+{
+    static const std::regex nodePattern(R"(//\s*@TraceNode\(\s*(\d+)\s*,\s*([^\s\)]+)\s*\))");
+
+    std::map<std::uint32_t, std::string> nodeNames;
+
+    std::ifstream file(shaderFile);
+    std::string   line;
+
+    while (std::getline(file, line)) {
+        std::smatch match;
+
+        if (std::regex_search(line, match, nodePattern)) {
+            nodeNames[static_cast<std::uint32_t>(std::stoul(match[1]))] = match[2];
+        }
+    }
+
+    return nodeNames;
+}
+
+RecordTraceTree RecordTrace::BuildTree(const RecordTraceCapture& capture)
+{
+    const auto& events = capture.events;
+
+    RecordTraceTree tree;
+
+    // Group index of every group event
+    std::vector<std::uint32_t> groupIndices(events.size(), NoGroup);
+
+    for (std::uint32_t eventIndex = 0; eventIndex < events.size(); ++eventIndex) {
+        const auto& event = events[eventIndex];
+
+        if ((event.node & OutputFlag) == 0) {
+            groupIndices[eventIndex] = static_cast<std::uint32_t>(tree.groups.size());
+
+            tree.groups.push_back({
+                .node        = event.node,
+                .parent      = NoGroup,
+                .depth       = 0,
+                .recordCount = event.recordCount,
+                .recordBytes = event.recordBytes,
+                .children    = {},
+                .outputs     = {},
+            });
+        }
+    }
+
+    // Parents of groups were dropped if the trace buffer was full, such groups become roots
+    const auto FindGroup = [&](std::uint32_t eventIndex) {
+        return (eventIndex < events.size()) ? groupIndices[eventIndex] : NoGroup;
+    };
+
+    for (std::uint32_t eventIndex = 0; eventIndex < events.size(); ++eventIndex) {
+        const auto& event = events[eventIndex];
+        const auto  group = groupIndices[eventIndex];
+        const auto  owner = FindGroup(event.parentGroup);
+
+        if (group != NoGroup) {
+            if ((owner != NoGroup) && (owner != group)) {
+                tree.groups[group].parent = owner;
+                tree.groups[owner].children.push_back(group);
+            } else {
+                tree.roots.push_back(group);
+            }
+        } else if (event.recordCount > 0) {
+            if (owner == NoGroup) {
+                ++tree.orphanedOutputCount;
+                continue;
+            }
+
+            // Outputs of a group are accumulated per node, e.g. for per-thread output requests
+            auto&      outputs = tree.groups[owner].outputs;
+            const auto node    = event.node & ~OutputFlag;
+            auto       it      = std::ranges::find(outputs, node, &RecordTraceTree::Output::node);
+
+            if (it == outputs.end()) {
+                it = outputs.insert(it, {.node = node, .recordCount = 0, .recordBytes = 0});
+            }
+
+            it->recordCount += event.recordCount;
+            it->recordBytes += event.recordBytes;
+        }
+    }
+
+    // Depth from roots, in breadth-first order
+    std::vector<std::uint32_t> queue = tree.roots;
+
+    for (std::size_t i = 0; i < queue.size(); ++i) {
+        const auto& group = tree.groups[queue[i]];
+
+        for (const auto child : group.children) {
+            tree.groups[child].depth = group.depth + 1;
+            queue.push_back(child);
+        }
+    }
+
+    return tree;
+}
+
+void RecordTrace::WriteCapture(const std::filesystem::path& path, const RecordTraceCapture& capture)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+    if (!file) {
+        throw std::runtime_error("Failed to open record trace file \"" + path.string() + "\"");
+    }
+
+    const RecordTraceFileHeader header = {
+        .magic              = RecordTraceFileMagic,
+        .version            = RecordTraceFileVersion,
+        .frame              = capture.frame,
+        .appendedEventCount = capture.appendedEventCount,
+        .eventCount         = static_cast<std::uint32_t>(capture.events.size()),
+        .nodeNameCount      = static_cast<std::uint32_t>(capture.nodeNames.size()),
+        .shaderFileNameSize = static_cast<std::uint32_t>(capture.shaderFileName.size()),
+        .reserved           = 0,
+    };
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(capture.shaderFileName.data(), capture.shaderFileName.size());
+
+    for (const auto& [node, name] : capture.nodeNames) {
+        const std::uint32_t nameSize = static_cast<std::uint32_t>(name.size());
+
+        file.write(reinterpret_cast<const char*>(&node), sizeof(node));
+        file.write(reinterpret_cast<const char*>(&nameSize), sizeof(nameSize));
+        file.write(name.data(), name.size());
+    }
+
+    file.write(reinterpret_cast<const char*>(capture.events.data()),
+               capture.events.size() * sizeof(RecordTraceEvent));
+}
+
+RecordTraceCapture RecordTrace::ReadCapture(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file) {
+        throw std::runtime_error("Failed to open record trace file \"" + path.string() + "\"");
+    }
+
+    RecordTraceFileHeader header = {};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+    if (!file || (header.magic != RecordTraceFileMagic) || (header.version != RecordTraceFileVersion)) {
+        throw std::runtime_error("\"" + path.string() + "\" is not a valid record trace.");
+    }
+
+    RecordTraceCapture capture = {
+        .shaderFileName     = std::string(header.shaderFileNameSize, '\0'),
+        .frame              = header.frame,
+        .appendedEventCount = header.appendedEventCount,
+        .events             = {},
+        .nodeNames          = {},
+    };
+
+    file.read(capture.shaderFileName.data(), capture.shaderFileName.size());
+
+    for (std::uint32_t i = 0; (i < header.nodeNameCount) && file; ++i) {
+        std::uint32_t node     = 0;
+        std::uint32_t nameSize = 0;
+
+        file.read(reinterpret_cast<char*>(&node), sizeof(node));
+        file.read(reinterpret_cast<char*>(&nameSize), sizeof(nameSize));
+
+        std::string name(nameSize, '\0');
+        file.read(name.data(), name.size());
+
+        capture.nodeNames[node] = std::move(name);
+    }
+
+    capture.events.resize(header.eventCount);
+    file.read(reinterpret_cast<char*>(capture.events.data()), capture.events.size() * sizeof(RecordTraceEvent));
+
+    if (!file) {
+        throw std::runtime_error("Record trace \"" + path.string() + "\" is truncated.");
+    }
+
+    return capture;
+}
+
+void RecordTrace::WritePerfettoJson(const std::filesystem::path& path,
+                                    const RecordTraceCapture&    capture,
+                                    const RecordTraceTree&       tree)
+{
+    std::ofstream file(path, std::ios::trunc);
+
+    if (!file) {
+        throw std::runtime_error("Failed to open record trace file \"" + path.string() + "\"");
+    }
+
+    // Outputs to nodes without group events (i.e., nodes that are not instrumented) are leaves of the tree
+    std::vector<bool> instrumented;
+    for (const auto& group : tree.groups) {
+        instrumented.resize(std::max<std::size_t>(instrumented.size(), group.node + 1), false);
+        instrumented[group.node] = true;
+    }
+
+    const auto IsLeaf = [&](const RecordTraceTree::Output& output) {
+        return (output.node >= instrumented.size()) || !instrumented[output.node];
+    };
+
+    // Width of every group is the number of records in its subtree, at least one
+    std::vector<std::uint64_t> widths(tree.groups.size(), 0);
+
+    const std::function<std::uint64_t(std::uint32_t)> ComputeWidth = [&](std::uint32_t groupIndex) {
+        const auto& group = tree.groups[groupIndex];
+
+        std::uint64_t width = 0;
+        for (const auto child : group.children) {
+            width += ComputeWidth(child);
+        }
+        for (const auto& output : group.outputs) {
+            width += IsLeaf(output) ? output.recordCount : 0;
+        }
+
+        return widths[groupIndex] = std::max<std::uint64_t>(width, 1);
+    };
+
+    file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    file << R"({"name":"process_name","ph":"M","pid":1,"tid":1,"args":{"name":"Record trace of )";
+    WriteEscaped(file, capture.shaderFileName);
+    file << " (frame " << capture.frame << ")\"}}";
+
+    const std::function<void(std::uint32_t, std::uint64_t)> WriteGroup = [&](std::uint32_t groupIndex,
+                                                                             std::uint64_t start) {
+        const auto& group = tree.groups[groupIndex];
+
+        file << ",\n" << R"({"name":")";
+        WriteEscaped(file, GetNodeName(capture, group.node));
+        file << R"(","ph":"X","pid":1,"tid":1,"ts":)" << start << ",\"dur\":" << widths[groupIndex]
+             << R"(,"args":{"group":)" << groupIndex << ",\"depth\":" << group.depth
+             << ",\"records\":" << group.recordCount << ",\"bytes\":" << group.recordBytes
+             << ",\"fan_out\":" << GetFanOut(group) << "}}";
+
+        for (const auto child : group.children) {
+            WriteGroup(child, start);
+            start += widths[child];
+        }
+
+        for (const auto& output : group.outputs) {
+            if (!IsLeaf(output)) {
+                continue;
+            }
+
+            file << ",\n" << R"({"name":")";
+            WriteEscaped(file, GetNodeName(capture, output.node));
+            file << R"(","ph":"X","pid":1,"tid":1,"ts":)" << start << ",\"dur\":" << output.recordCount
+                 << R"(,"args":{"records":)" << output.recordCount << ",\"bytes\":" << output.recordBytes << "}}";
+
+            start += output.recordCount;
+        }
+    };
+
+    std::uint64_t start = 0;
+
+    for (const auto root : tree.roots) {
+        ComputeWidth(root);
+        WriteGroup(root, start);
+        start += widths[root];
+    }
+
+    file << "\n]}\n";
+}
+
+void RecordTrace::WriteSummary(std::ostream& stream, const RecordTraceCapture& capture, const RecordTraceTree& tree)
+{
+    struct NodeSummary {
+        std::uint64_t groupCount  = 0;
+        std::uint64_t recordCount = 0;
+        std::uint32_t minDepth    = ~0u;
+        std::uint32_t maxDepth    = 0;
+        std::uint64_t minFanOut   = ~0ull;
+        std::uint64_t maxFanOut   = 0;
+        std::uint64_t fanOut      = 0;
+        // Number of groups per depth
+        std::vector<std::uint64_t> depthHistogram;
+        // Records and bytes emitted to each node
+        std::map<std::uint32_t, std::pair<std::uint64_t, std::uint64_t>> outputs;
+    };
+
+    std::map<std::uint32_t, NodeSummary> nodes;
+    std::uint32_t                        maxDepth = 0;
+
+    for (const auto& group : tree.groups) {
+        auto&      node   = nodes[group.node];
+        const auto fanOut = GetFanOut(group);
+
+        node.groupCount += 1;
+        node.recordCount += group.recordCount;
+        node.minDepth  = std::min(node.minDepth, group.depth);
+        node.maxDepth  = std::max(node.maxDepth, group.depth);
+        node.minFanOut = std::min(node.minFanOut, fanOut);
+        node.maxFanOut = std::max(node.maxFanOut, fanOut);
+        node.fanOut += fanOut;
+
+        node.depthHistogram.resize(std::max<std::size_t>(node.depthHistogram.size(), group.depth + 1), 0);
+        node.depthHistogram[group.depth] += 1;
+
+        for (const auto& output : group.outputs) {
+            node.outputs[output.node].first += output.recordCount;
+            node.outputs[output.node].second += output.recordBytes;
+        }
+
+        maxDepth = std::max(maxDepth, group.depth);
+    }
+
+    const auto droppedEventCount = capture.appendedEventCount - std::min<std::uint64_t>(capture.appendedEventCount,
+                                                                                         capture.events.size());
+
+    stream << "Record trace of " << capture.shaderFileName << " (frame " << capture.frame << "): " << tree.groups.size()
+           << " groups, " << capture.events.size() << " events, maximum depth " << maxDepth << "\n";
+
+    if (droppedEventCount > 0) {
+        stream << "  " << droppedEventCount << " events were dropped, as the trace buffer was full\n";
+    }
+
+    for (const auto& [nodeId, node] : nodes) {
+        stream << std::fixed << std::setprecision(1);
+        stream << "  " << GetNodeName(capture, nodeId) << ": " << node.groupCount << " groups, " << node.recordCount
+               << " input records, depth " << node.minDepth << "-" << node.maxDepth << ", fan-out " << node.minFanOut
+               << "/" << static_cast<double>(node.fanOut) / node.groupCount << "/" << node.maxFanOut
+               << " (min/avg/max)\n";
+
+        stream << "    groups per depth:";
+        for (std::uint32_t depth = node.minDepth; depth < node.depthHistogram.size(); ++depth) {
+            stream << " " << depth << ":" << node.depthHistogram[depth];
+        }
+        stream << "\n";
+
+        for (const auto& [outputNode, output] : node.outputs) {
+            stream << "    -> " << GetNodeName(capture, outputNode) << ": " << output.first << " records, "
+                   << output.second << " bytes\n";
+        }
+    }
+}
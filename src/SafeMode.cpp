@@ -0,0 +1,103 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "SafeMode.h"
+
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    struct LastGoodWorkGraphHeader {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t tutorialIndex;
+        std::uint32_t sampleSolution;
+        std::uint32_t shaderFileNameSize;
+        std::uint32_t librarySize;
+    };
+
+    // "WGLG" - Work Graph Last Good
+    constexpr std::uint32_t LastGoodWorkGraphMagic   = 0x474C4757;
+    constexpr std::uint32_t LastGoodWorkGraphVersion = 1;
+}  // namespace
+
+void LastGoodWorkGraph::Save(const std::filesystem::path& path) const
+{
+    // Write to temporary file first, such that a hang while writing does not leave a broken file behind
+    const auto temporaryPath = std::filesystem::path(path).concat(".tmp");
+
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+
+        if (!file) {
+            throw std::runtime_error("Failed to open last good work graph file \"" + temporaryPath.string() + "\"");
+        }
+
+        const LastGoodWorkGraphHeader header = {
+            .magic              = LastGoodWorkGraphMagic,
+            .version            = LastGoodWorkGraphVersion,
+            .tutorialIndex      = tutorialIndex,
+            .sampleSolution     = sampleSolution ? 1u : 0u,
+            .shaderFileNameSize = static_cast<std::uint32_t>(shaderFileName.size()),
+            .librarySize        = static_cast<std::uint32_t>(library->GetBufferSize()),
+        };
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(shaderFileName.data(), shaderFileName.size());
+        file.write(static_cast<const char*>(library->GetBufferPointer()), library->GetBufferSize());
+    }
+
+    std::filesystem::rename(temporaryPath, path);
+}
+
+std::optional<LastGoodWorkGraph> LastGoodWorkGraph::Load(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+
+    LastGoodWorkGraphHeader header = {};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+    if (!file || (header.magic != LastGoodWorkGraphMagic) || (header.version != LastGoodWorkGraphVersion)) {
+        return std::nullopt;
+    }
+
+    LastGoodWorkGraph workGraph = {
+        .tutorialIndex  = header.tutorialIndex,
+        .sampleSolution = header.sampleSolution != 0,
+        .shaderFileName = std::string(header.shaderFileNameSize, '\0'),
+    };
+
+    std::vector<std::uint8_t> library(header.librarySize);
+
+    file.read(workGraph.shaderFileName.data(), workGraph.shaderFileName.size());
+    file.read(reinterpret_cast<char*>(library.data()), library.size());
+
+    if (!file) {
+        return std::nullopt;
+    }
+
+    workGraph.library = Blob::Create(std::move(library));
+
+    return workGraph;
+}
@@ -23,12 +23,26 @@
 
 #include "ShaderCompiler.h"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <sstream>
 
+#include "CompileServer.h"
+#include "Hash.h"
+#include "Log.h"
+#include "ShaderPack.h"
+#include "Trace.h"
+
 // Include handler library to collect all included files for tracking
 class FileTrackingIncludeHandler : public IDxcIncludeHandler {
 public:
-    FileTrackingIncludeHandler(ShaderCompiler& parent) : parent_(parent) {}
+    FileTrackingIncludeHandler(IDxcUtils*                     utils,
+                               const std::filesystem::path&   includeDirectory,
+                               std::vector<ShaderSourceFile>& sourceFiles)
+        : utils_(utils), includeDirectory_(includeDirectory), sourceFiles_(sourceFiles)
+    {
+    }
 
     HRESULT STDMETHODCALLTYPE LoadSource(_In_ LPCWSTR                             pFilename,
                                          _COM_Outptr_result_maybenull_ IDxcBlob** ppIncludeSource) override
@@ -40,19 +54,29 @@ public:
             return E_FAIL;
         }
 
-        const auto shaderSourceFilePath = parent_.GetShaderSourceFilePath(pFilename);
+        // Exceptions must not propagate into the compiler
+        try {
+            const std::filesystem::path includeSourceFilePath =
+                std::filesystem::absolute(includeDirectory_ / pFilename).generic_string();
 
-        IDxcBlobEncoding* includeSource;
-        const auto result = parent_.utils_->LoadFile(shaderSourceFilePath.wstring().c_str(), nullptr, &includeSource);
+            IDxcBlobEncoding* includeSource;
+            const auto result = utils_->LoadFile(includeSourceFilePath.wstring().c_str(), nullptr, &includeSource);
 
-        *ppIncludeSource = includeSource;
+            *ppIncludeSource = includeSource;
 
-        if (SUCCEEDED(result)) {
-            // Update/insert last file write time for hot-reloading
-            parent_.trackedFiles_[shaderSourceFilePath] = std::filesystem::last_write_time(shaderSourceFilePath);
-        }
+            if (SUCCEEDED(result)) {
+                // Record included file and its contents for hot-reloading & caching
+                sourceFiles_.push_back({
+                    .path        = includeSourceFilePath,
+                    .contentHash = HashBytes(includeSource->GetBufferPointer(), includeSource->GetBufferSize()),
+                });
+            }
 
-        return result;
+            return result;
+        } catch (const std::exception&) {
+            *ppIncludeSource = nullptr;
+            return E_FAIL;
+        }
     }
 
     HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, _COM_Outptr_ void __RPC_FAR* __RPC_FAR* ppvObject) override
@@ -71,11 +95,67 @@ public:
     }
 
 private:
-    ShaderCompiler& parent_;
+    IDxcUtils*                     utils_;
+    std::filesystem::path          includeDirectory_;
+    std::vector<ShaderSourceFile>& sourceFiles_;
 };
 
-ShaderCompiler::ShaderCompiler()
+namespace {
+    // DXIL container layout, see DxilContainer.h of the DirectX Shader Compiler
+    struct DxilContainerHeader {
+        std::uint32_t fourCC;
+        std::uint8_t  digest[16];
+        std::uint16_t majorVersion;
+        std::uint16_t minorVersion;
+        std::uint32_t containerSize;
+        std::uint32_t partCount;
+        // followed by std::uint32_t partOffsets[partCount]
+    };
+
+    struct DxilPartHeader {
+        std::uint32_t fourCC;
+        std::uint32_t partSize;
+        // followed by partSize bytes of part data
+    };
+
+    constexpr std::uint32_t MakeFourCC(const char a, const char b, const char c, const char d)
+    {
+        return static_cast<std::uint32_t>(a) | (static_cast<std::uint32_t>(b) << 8) |
+               (static_cast<std::uint32_t>(c) << 16) | (static_cast<std::uint32_t>(d) << 24);
+    }
+
+    // Parts that do not affect execution of the shader
+    constexpr std::array<std::uint32_t, 5> IgnoredDxilParts = {
+        MakeFourCC('I', 'L', 'D', 'B'),  // DXIL with debug info
+        MakeFourCC('I', 'L', 'D', 'N'),  // debug name
+        MakeFourCC('H', 'A', 'S', 'H'),  // shader hash, may be computed from source
+        MakeFourCC('P', 'D', 'B', 'I'),  // PDB info
+        MakeFourCC('S', 'R', 'C', 'I'),  // source info
+    };
+}  // namespace
+
+ShaderCompiler::ShaderCompiler(const bool useCompileServer, const std::filesystem::path& shaderPackFile)
+{
+    if (useCompileServer) {
+        compileClient_ = std::make_unique<CompileClient>();
+    }
+    if (!shaderPackFile.empty()) {
+        shaderPack_ = std::make_unique<ShaderPack>(shaderPackFile);
+    }
+
+    shaderFolderPath_ = std::filesystem::current_path() / L"tutorials";
+}
+
+ShaderCompiler::~ShaderCompiler() = default;
+
+void ShaderCompiler::LoadCompiler()
 {
+    if (compiler_) {
+        return;
+    }
+
+    const Trace::Scope traceScope("ShaderCompiler::LoadCompiler");
+
     HMODULE dxcompilerModule = LoadLibraryW(L"dxcompiler.dll");
 
     if (!dxcompilerModule) {
@@ -91,65 +171,267 @@ ShaderCompiler::ShaderCompiler()
 
     ThrowIfFailed(pfnDxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&utils_)));
     ThrowIfFailed(pfnDxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&compiler_)));
-    ThrowIfFailed(utils_->CreateDefaultIncludeHandler(&includeHandler_));
+}
 
-    shaderFolderPath_ = std::filesystem::current_path() / L"tutorials";
+ComPtr<IDxcBlob> ShaderCompiler::CompileShader(const std::string&          shaderFile,
+                                               const wchar_t*              target,
+                                               const wchar_t*              entryPoint,
+                                               const ShaderCompileOptions& options)
+{
+    const Trace::Scope traceScope("ShaderCompiler::CompileShader");
+
+    const auto request = CreateCompileRequest(shaderFile, target, entryPoint, options);
+
+    ShaderCompileResult result;
+
+    const bool packed = shaderPack_ && shaderPack_->Find(request, result);
+
+    if (!packed) {
+        result = CompileUncached(request);
+    }
+
+    TrackSourceFiles(result.sourceFiles);
+
+    if (!result.success) {
+        std::stringstream stream;
+        stream << "Failed to compile shader \"" << shaderFile << "\":\n" << result.messages;
+
+        throw std::runtime_error(stream.str());
+    }
+
+    if (shaderPack_ && !packed) {
+        try {
+            shaderPack_->Append(request, result);
+        } catch (const std::exception& e) {
+            // Shader pack is only an optimization
+            Log::Error() << e.what();
+        }
+    }
+
+    return result.blob;
+}
+
+ComPtr<IDxcBlob> ShaderCompiler::FindCompiledShader(const std::string&          shaderFile,
+                                                     const wchar_t*              target,
+                                                     const wchar_t*              entryPoint,
+                                                     const ShaderCompileOptions& options)
+{
+    const Trace::Scope traceScope("ShaderCompiler::FindCompiledShader");
+
+    ShaderCompileResult result;
+
+    if (!shaderPack_ || !shaderPack_->Find(CreateCompileRequest(shaderFile, target, entryPoint, options), result)) {
+        return nullptr;
+    }
+
+    TrackSourceFiles(result.sourceFiles);
+
+    return result.blob;
+}
+
+std::string ShaderCompiler::Disassemble(IDxcBlob* blob)
+{
+    const Trace::Scope traceScope("ShaderCompiler::Disassemble");
+
+    LoadCompiler();
+
+    ComPtr<IDxcBlobEncoding> disassembly;
+    ThrowIfFailed(compiler_->Disassemble(blob, &disassembly));
+
+    ComPtr<IDxcBlobUtf8> disassembly8;
+    ThrowIfFailed(utils_->GetBlobAsUtf8(disassembly.Get(), &disassembly8));
+
+    return std::string(disassembly8->GetStringPointer(), disassembly8->GetStringLength());
+}
+
+std::uint64_t ShaderCompiler::HashShaderCode(IDxcBlob* blob)
+{
+    const auto* data = static_cast<const std::uint8_t*>(blob->GetBufferPointer());
+    const auto  size = blob->GetBufferSize();
+
+    DxilContainerHeader header = {};
+
+    if (size >= sizeof(header)) {
+        std::memcpy(&header, data, sizeof(header));
+    }
+
+    // Hash entire blob if it is not a DXIL container
+    if ((header.fourCC != MakeFourCC('D', 'X', 'B', 'C')) ||
+        (sizeof(header) + header.partCount * sizeof(std::uint32_t) > size))
+    {
+        return HashBytes(data, size);
+    }
+
+    // Container header is skipped, as its digest covers all parts
+    std::uint64_t hash = HashSeed;
+
+    for (std::uint32_t partIndex = 0; partIndex < header.partCount; ++partIndex) {
+        std::uint32_t partOffset;
+        std::memcpy(&partOffset, data + sizeof(header) + partIndex * sizeof(std::uint32_t), sizeof(partOffset));
+
+        DxilPartHeader partHeader;
+        if (partOffset + sizeof(partHeader) > size) {
+            return HashBytes(data, size);
+        }
+        std::memcpy(&partHeader, data + partOffset, sizeof(partHeader));
+
+        if (partOffset + sizeof(partHeader) + partHeader.partSize > size) {
+            return HashBytes(data, size);
+        }
+
+        if (std::ranges::find(IgnoredDxilParts, partHeader.fourCC) != IgnoredDxilParts.end()) {
+            continue;
+        }
+
+        hash = HashBytes(data + partOffset, sizeof(partHeader) + partHeader.partSize, hash);
+    }
+
+    return hash;
+}
+
+bool ShaderCompiler::RebuildShaderPack(const std::vector<std::string>& shaderFiles)
+{
+    if (!shaderPack_) {
+        throw std::runtime_error("No shader pack file specified");
+    }
+
+    bool success = true;
+
+    std::vector<std::pair<ShaderCompileRequest, ShaderCompileResult>> entries;
+
+    for (const auto& shaderFile : shaderFiles) {
+        Log::Info() << "Compiling \"" << shaderFile << "\"";
+
+        auto request = CreateCompileRequest(shaderFile, L"lib_6_8", nullptr);
+        auto result  = CompileUncached(request);
+
+        if (!result.success) {
+            Log::Error() << "Failed to compile shader \"" << shaderFile << "\":\n" << result.messages;
+            success = false;
+            continue;
+        }
+
+        entries.emplace_back(std::move(request), std::move(result));
+    }
+
+    shaderPack_->Write(entries);
+
+    Log::Info() << "Wrote " << entries.size() << " shaders to shader pack.";
+
+    return success;
+}
+
+void ShaderCompiler::CompactShaderPack()
+{
+    if (!shaderPack_) {
+        throw std::runtime_error("No shader pack file specified");
+    }
+
+    shaderPack_->Compact(std::filesystem::absolute(shaderFolderPath_));
+}
+
+ShaderCompileResult ShaderCompiler::CompileUncached(const ShaderCompileRequest& request)
+{
+    if (compileClient_ && compileClient_->Connect()) {
+        try {
+            return compileClient_->Compile(request);
+        } catch (const std::exception& e) {
+            // Connection to compile server was lost, most likely because the compiler crashed.
+            // Report as compile error and keep tracking the source file to retry once it was changed.
+            ShaderCompileResult result;
+
+            result.messages    = e.what();
+            result.sourceFiles = {{.path = request.sourceFile, .contentHash = 0}};
+
+            return result;
+        }
+    }
+
+    return Compile(request);
 }
 
-ComPtr<IDxcBlob> ShaderCompiler::CompileShader(const std::string& shaderFile,
-                                               const wchar_t*     target,
-                                               const wchar_t*     entryPoint)
+ShaderCompileResult ShaderCompiler::Compile(const ShaderCompileRequest& request)
 {
-    const auto shaderSourceFilePath = GetShaderSourceFilePath(shaderFile);
+    const Trace::Scope traceScope("ShaderCompiler::Compile");
+
+    LoadCompiler();
 
     HRESULT                  loadSourceResult;
     ComPtr<IDxcBlobEncoding> source;
 
-    loadSourceResult = utils_->LoadFile(shaderSourceFilePath.wstring().c_str(), nullptr, &source);
+    loadSourceResult = utils_->LoadFile(request.sourceFile.wstring().c_str(), nullptr, &source);
 
     if (FAILED(loadSourceResult) || (source == nullptr)) {
         // try load source again. Sometimes loading the file for hot-reloading will fail if the
         // file is still being written to.
-        loadSourceResult = utils_->LoadFile(shaderSourceFilePath.wstring().c_str(), nullptr, &source);
+        loadSourceResult = utils_->LoadFile(request.sourceFile.wstring().c_str(), nullptr, &source);
     }
 
     if (FAILED(loadSourceResult) || (source == nullptr)) {
-        // Second attempt failed as well. Throw error
-        throw std::runtime_error("Failed to load shader file \"" + shaderFile + "\"");
+        // Second attempt failed as well
+        ShaderCompileResult compileResult;
+        compileResult.messages = "Failed to load shader file \"" + request.sourceFile.string() + "\"";
+        return compileResult;
     }
 
-    const auto shaderIncludeArgument = std::wstring(L"-I") + shaderFolderPath_.wstring();
+    return CompileSource(request, source.Get());
+}
+
+ShaderCompileResult ShaderCompiler::Compile(const ShaderCompileRequest& request, const std::string_view source)
+{
+    const Trace::Scope traceScope("ShaderCompiler::Compile");
 
-    std::vector<const wchar_t*> arguments = {
-        L"-enable-16bit-types",
-        // use HLSL 2021
-        L"-HV",
-        L"2021",
-        // column major matrices
-        DXC_ARG_PACK_MATRIX_COLUMN_MAJOR,
-        // include path for "tutorials" folder
-        shaderIncludeArgument.c_str(),
-    };
+    LoadCompiler();
 
-    FileTrackingIncludeHandler includeHandler(*this);
+    ComPtr<IDxcBlobEncoding> sourceBlob;
+    ThrowIfFailed(utils_->CreateBlob(source.data(), static_cast<UINT32>(source.size()), DXC_CP_UTF8, &sourceBlob));
+
+    return CompileSource(request, sourceBlob.Get());
+}
 
+ShaderCompileResult ShaderCompiler::CompileSource(const ShaderCompileRequest& request, IDxcBlobEncoding* source)
+{
+    ShaderCompileResult compileResult;
+
+    compileResult.sourceFiles.push_back({
+        .path        = request.sourceFile,
+        .contentHash = HashBytes(source->GetBufferPointer(), source->GetBufferSize()),
+    });
+
+    std::vector<const wchar_t*> arguments;
+    for (const auto& argument : request.arguments) {
+        arguments.emplace_back(argument.c_str());
+    }
+
+    // Include path is not part of the request arguments, such that requests (and their hashes) are independent of
+    // the location of the "tutorials" folder
+    const auto includeArgument = L"-I" + request.includeDirectory.wstring();
+    arguments.emplace_back(includeArgument.c_str());
+
+    FileTrackingIncludeHandler includeHandler(utils_.Get(), request.includeDirectory, compileResult.sourceFiles);
+
+    const auto sourceName = request.sourceFile.wstring();
+
+    // Crashes of the compiler (e.g. on malformed shaders) are not caught, as the state of this process is unknown
+    // afterwards. Only the compile server (see CompileServer.h) isolates them with a process boundary.
     ComPtr<IDxcOperationResult> result = nullptr;
-    ThrowIfFailed(compiler_->Compile(source.Get(),
-                                     shaderSourceFilePath.wstring().c_str(),
-                                     entryPoint,
-                                     target,
-                                     arguments.data(),
-                                     static_cast<UINT32>(arguments.size()),
-                                     nullptr,
-                                     0,
-                                     &includeHandler,
-                                     &result));
+    {
+        const Trace::Scope compileTraceScope("IDxcCompiler::Compile");
+        ThrowIfFailed(compiler_->Compile(source,
+                                         sourceName.c_str(),
+                                         request.entryPoint.empty() ? nullptr : request.entryPoint.c_str(),
+                                         request.target.c_str(),
+                                         arguments.data(),
+                                         static_cast<UINT32>(arguments.size()),
+                                         nullptr,
+                                         0,
+                                         &includeHandler,
+                                         &result));
+    }
 
     HRESULT compileStatus;
     ThrowIfFailed(result->GetStatus(&compileStatus));
 
-    std::string errorString = "";
-
     // try get error string from DXC result
     {
         ComPtr<IDxcBlobEncoding> errorStringBlob = nullptr;
@@ -157,28 +439,24 @@ ComPtr<IDxcBlob> ShaderCompiler::CompileShader(const std::string& shaderFile,
             ComPtr<IDxcBlobUtf8> errorStringBlob8 = nullptr;
             utils_->GetBlobAsUtf8(errorStringBlob.Get(), &errorStringBlob8);
 
-            errorString = std::string(errorStringBlob8->GetStringPointer(), errorStringBlob8->GetStringLength());
+            compileResult.messages =
+                std::string(errorStringBlob8->GetStringPointer(), errorStringBlob8->GetStringLength());
         }
     }
 
-    if (FAILED(compileStatus)) {
-        std::stringstream stream;
-        stream << "Failed to compile shader \"" << shaderFile << "\":\n" << errorString;
+    compileResult.success = SUCCEEDED(compileStatus);
 
-        throw std::runtime_error(stream.str());
+    if (compileResult.success) {
+        ThrowIfFailed(result->GetResult(&compileResult.blob));
     }
 
-    ComPtr<IDxcBlob> outputBlob;
-    ThrowIfFailed(result->GetResult(&outputBlob));
-
-    // Update/insert last file write time for hot-reloading
-    trackedFiles_[shaderSourceFilePath] = std::filesystem::last_write_time(shaderSourceFilePath);
-
-    return outputBlob;
+    return compileResult;
 }
 
 bool ShaderCompiler::CheckShaderSourceFiles()
 {
+    const Trace::Scope traceScope("ShaderCompiler::CheckShaderSourceFiles");
+
     bool result = false;
 
     for (auto& [file, writeTime] : trackedFiles_) {
@@ -199,12 +477,67 @@ bool ShaderCompiler::CheckShaderSourceFiles()
     return result;
 }
 
-std::filesystem::path ShaderCompiler::GetShaderSourceFilePath(const std::string& shaderFile)
+void ShaderCompiler::TrackShaderFile(const std::string& shaderFile)
 {
-    return std::filesystem::absolute(shaderFolderPath_ / shaderFile).generic_string();
+    TrackSourceFiles({{.path = GetShaderSourceFilePath(shaderFile), .contentHash = 0}});
 }
 
-std::filesystem::path ShaderCompiler::GetShaderSourceFilePath(const std::wstring& shaderFile)
+ShaderCompileRequest ShaderCompiler::CreateCompileRequest(const std::string&          shaderFile,
+                                                          const wchar_t*              target,
+                                                          const wchar_t*              entryPoint,
+                                                          const ShaderCompileOptions& options) const
+{
+    ShaderCompileRequest request = {
+        .sourceFile       = GetShaderSourceFilePath(shaderFile),
+        .includeDirectory = std::filesystem::absolute(shaderFolderPath_),
+        .target           = target,
+        .entryPoint       = (entryPoint != nullptr) ? entryPoint : L"",
+    };
+
+    if (options.enable16BitTypes) {
+        request.arguments.emplace_back(L"-enable-16bit-types");
+    }
+
+    request.arguments.insert(request.arguments.end(),
+                             {
+                                 // use HLSL 2021
+                                 L"-HV",
+                                 L"2021",
+                                 // column major matrices
+                                 DXC_ARG_PACK_MATRIX_COLUMN_MAJOR,
+                             });
+
+    if (options.optimizationLevel >= 0) {
+        request.arguments.emplace_back(L"-O" + std::to_wstring(options.optimizationLevel));
+    }
+    if (!options.denormMode.empty()) {
+        request.arguments.emplace_back(L"-denorm");
+        request.arguments.emplace_back(options.denormMode);
+    }
+    if (options.ieeeStrictness) {
+        request.arguments.emplace_back(DXC_ARG_IEEE_STRICTNESS);
+    }
+    if (options.skipOptimizations) {
+        request.arguments.emplace_back(DXC_ARG_SKIP_OPTIMIZATIONS);
+    }
+
+    return request;
+}
+
+std::filesystem::path ShaderCompiler::GetShaderSourceFilePath(const std::string& shaderFile) const
 {
     return std::filesystem::absolute(shaderFolderPath_ / shaderFile).generic_string();
 }
+
+void ShaderCompiler::TrackSourceFiles(const std::vector<ShaderSourceFile>& sourceFiles)
+{
+    // Update/insert last file write time for hot-reloading
+    for (const auto& sourceFile : sourceFiles) {
+        try {
+            trackedFiles_[sourceFile.path] = std::filesystem::last_write_time(sourceFile.path);
+        } catch (const std::filesystem::filesystem_error&) {
+            // last_write_time can throw an error if the file is currently being written to
+            continue;
+        }
+    }
+}
@@ -0,0 +1,509 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "ShaderPack.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include "Blob.h"
+#include "Hash.h"
+#include "Log.h"
+#include "Trace.h"
+
+namespace {
+    constexpr std::uint32_t PackMagic     = 0x50534757;  // "WGSP"
+    constexpr std::uint32_t PackVersion   = 1;
+    constexpr std::uint64_t DataAlignment = 64;
+
+    struct Header {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint64_t indexOffset;
+        std::uint64_t indexEntryCount;
+    };
+
+    std::uint64_t AlignUp(const std::uint64_t value, const std::uint64_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    // Pack entries are identified by the source file path relative to the include directory and all compiler
+    // arguments. Thus packs can be moved together with the "tutorials" folder.
+    std::uint64_t GetEntryKey(const ShaderCompileRequest& request)
+    {
+        const auto sourceFile = request.sourceFile.lexically_relative(request.includeDirectory).generic_string();
+
+        std::uint64_t hash = HashSeed;
+
+        hash = HashString<char>(sourceFile, hash);
+        hash = HashString<wchar_t>(request.target, hash);
+        hash = HashString<wchar_t>(request.entryPoint, hash);
+
+        for (const auto& argument : request.arguments) {
+            hash = HashString<wchar_t>(argument, hash);
+        }
+
+        return hash;
+    }
+
+    // Source files are stored as count, followed by (path length, UTF-8 path, content hash) for each file
+    std::vector<std::uint8_t> SerializeSourceFiles(const std::vector<ShaderSourceFile>& sourceFiles,
+                                                   const std::filesystem::path&         includeDirectory)
+    {
+        std::vector<std::uint8_t> data;
+
+        const auto Write = [&](const void* value, const std::size_t size) {
+            const auto* bytes = static_cast<const std::uint8_t*>(value);
+            data.insert(data.end(), bytes, bytes + size);
+        };
+
+        const auto count = static_cast<std::uint32_t>(sourceFiles.size());
+        Write(&count, sizeof(count));
+
+        for (const auto& sourceFile : sourceFiles) {
+            const auto path   = sourceFile.path.lexically_relative(includeDirectory).generic_u8string();
+            const auto length = static_cast<std::uint32_t>(path.size());
+
+            Write(&length, sizeof(length));
+            Write(path.data(), path.size());
+            Write(&sourceFile.contentHash, sizeof(sourceFile.contentHash));
+        }
+
+        return data;
+    }
+
+    void WriteAt(HANDLE file, const std::uint64_t offset, const void* data, const std::size_t size)
+    {
+        OVERLAPPED overlapped = {};
+        overlapped.Offset     = static_cast<DWORD>(offset);
+        overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+        DWORD writtenBytes = 0;
+        if (!WriteFile(file, data, static_cast<DWORD>(size), &writtenBytes, &overlapped) || (writtenBytes != size)) {
+            throw std::runtime_error("Failed to write shader pack");
+        }
+    }
+
+    bool ReadAt(HANDLE file, const std::uint64_t offset, void* data, const std::size_t size)
+    {
+        OVERLAPPED overlapped = {};
+        overlapped.Offset     = static_cast<DWORD>(offset);
+        overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+        DWORD readBytes = 0;
+        return ReadFile(file, data, static_cast<DWORD>(size), &readBytes, &overlapped) && (readBytes == size);
+    }
+}  // namespace
+
+struct ShaderPack::MappedFile {
+    ~MappedFile()
+    {
+        if (data != nullptr) {
+            UnmapViewOfFile(data);
+        }
+        if (mapping != nullptr) {
+            CloseHandle(mapping);
+        }
+        if (file != INVALID_HANDLE_VALUE) {
+            CloseHandle(file);
+        }
+    }
+
+    HANDLE              file    = INVALID_HANDLE_VALUE;
+    HANDLE              mapping = nullptr;
+    const std::uint8_t* data    = nullptr;
+    std::uint64_t       size    = 0;
+};
+
+ShaderPack::ShaderPack(const std::filesystem::path& path) : path_(path)
+{
+    Map();
+}
+
+ShaderPack::~ShaderPack() = default;
+
+bool ShaderPack::Find(const ShaderCompileRequest& request, ShaderCompileResult& result) const
+{
+    const Trace::Scope traceScope("ShaderPack::Find");
+
+    const auto it = index_.find(GetEntryKey(request));
+
+    if (it == index_.end()) {
+        return false;
+    }
+
+    try {
+        auto packedResult = ReadEntry(it->second, request.includeDirectory);
+
+        // Check if any source file was changed since the shader was packed
+        for (const auto& sourceFile : packedResult.sourceFiles) {
+            if (HashFile(sourceFile.path) != sourceFile.contentHash) {
+                return false;
+            }
+        }
+
+        result = std::move(packedResult);
+    } catch (const std::exception&) {
+        // Source file no longer exists or pack entry is corrupted
+        return false;
+    }
+
+    return true;
+}
+
+void ShaderPack::Append(const ShaderCompileRequest& request, const ShaderCompileResult& result)
+{
+    const Trace::Scope traceScope("ShaderPack::Append");
+
+    if (!result.success || (result.blob == nullptr)) {
+        return;
+    }
+
+    HANDLE file = CreateFileW(path_.wstring().c_str(),
+                              GENERIC_READ | GENERIC_WRITE,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              nullptr,
+                              OPEN_ALWAYS,
+                              FILE_ATTRIBUTE_NORMAL,
+                              nullptr);
+
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Failed to open shader pack \"" + path_.string() + "\"");
+    }
+
+    // Serialize appends from multiple instances. Locks a single byte far beyond the end of the file,
+    // as locked regions cannot be read by other processes.
+    OVERLAPPED lockOverlapped = {};
+    lockOverlapped.OffsetHigh = MAXDWORD;
+    if (!LockFileEx(file, LOCKFILE_EXCLUSIVE_LOCK, 0, 1, 0, &lockOverlapped)) {
+        CloseHandle(file);
+        throw std::runtime_error("Failed to lock shader pack \"" + path_.string() + "\"");
+    }
+
+    try {
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize)) {
+            throw std::runtime_error("Failed to get size of shader pack \"" + path_.string() + "\"");
+        }
+
+        // Read current index from file, as other instances may have appended to it since it was mapped
+        Header                  header = {};
+        std::vector<IndexEntry> index;
+
+        if (ReadAt(file, 0, &header, sizeof(header)) && (header.magic == PackMagic) &&
+            (header.version == PackVersion) && (header.indexEntryCount <= fileSize.QuadPart / sizeof(IndexEntry)))
+        {
+            index.resize(header.indexEntryCount);
+
+            if (!ReadAt(file, header.indexOffset, index.data(), index.size() * sizeof(IndexEntry))) {
+                index.clear();
+            }
+        }
+
+        const auto sourceFiles = SerializeSourceFiles(result.sourceFiles, request.includeDirectory);
+        const auto key         = GetEntryKey(request);
+
+        IndexEntry entry = {
+            .key        = key,
+            .dataOffset = AlignUp(std::max<std::uint64_t>(fileSize.QuadPart, sizeof(Header)), DataAlignment),
+            .dataSize   = result.blob->GetBufferSize(),
+        };
+        entry.sourceFilesOffset = entry.dataOffset + entry.dataSize;
+        entry.sourceFilesSize   = sourceFiles.size();
+
+        WriteAt(file, entry.dataOffset, result.blob->GetBufferPointer(), entry.dataSize);
+        WriteAt(file, entry.sourceFilesOffset, sourceFiles.data(), sourceFiles.size());
+
+        // Replace previous entry for same shader
+        std::erase_if(index, [&](const IndexEntry& indexEntry) { return indexEntry.key == key; });
+        index.emplace_back(entry);
+
+        header = {
+            .magic           = PackMagic,
+            .version         = PackVersion,
+            .indexOffset     = AlignUp(entry.sourceFilesOffset + entry.sourceFilesSize, sizeof(std::uint64_t)),
+            .indexEntryCount = index.size(),
+        };
+
+        WriteAt(file, header.indexOffset, index.data(), index.size() * sizeof(IndexEntry));
+        // Header is written last, such that the pack stays valid if appending fails
+        WriteAt(file, 0, &header, sizeof(header));
+    } catch (const std::exception&) {
+        UnlockFileEx(file, 0, 1, 0, &lockOverlapped);
+        CloseHandle(file);
+        throw;
+    }
+
+    UnlockFileEx(file, 0, 1, 0, &lockOverlapped);
+    CloseHandle(file);
+
+    // Re-map to include new entry. Previously returned blobs keep the old mapping alive.
+    Map();
+}
+
+void ShaderPack::Write(const std::vector<std::pair<ShaderCompileRequest, ShaderCompileResult>>& entries)
+{
+    std::vector<PackEntry> packEntries;
+
+    for (const auto& [request, result] : entries) {
+        if (!result.success || (result.blob == nullptr)) {
+            continue;
+        }
+
+        packEntries.push_back({
+            .key         = GetEntryKey(request),
+            .data        = result.blob->GetBufferPointer(),
+            .dataSize    = result.blob->GetBufferSize(),
+            .sourceFiles = SerializeSourceFiles(result.sourceFiles, request.includeDirectory),
+        });
+    }
+
+    WritePackFile(packEntries);
+}
+
+void ShaderPack::Compact(const std::filesystem::path& includeDirectory)
+{
+    // Keep mapping alive until new pack file is written
+    const auto mappedFile = mappedFile_;
+
+    std::vector<PackEntry> packEntries;
+
+    for (const auto& [key, entry] : index_) {
+        try {
+            const auto result = ReadEntry(entry, includeDirectory);
+
+            bool upToDate = true;
+            for (const auto& sourceFile : result.sourceFiles) {
+                upToDate &= (HashFile(sourceFile.path) == sourceFile.contentHash);
+            }
+
+            if (!upToDate) {
+                continue;
+            }
+        } catch (const std::exception&) {
+            // Source file no longer exists
+            continue;
+        }
+
+        // Copy serialized source files as-is
+        const auto* sourceFiles = mappedFile->data + entry.sourceFilesOffset;
+
+        packEntries.push_back({
+            .key         = key,
+            .data        = mappedFile->data + entry.dataOffset,
+            .dataSize    = entry.dataSize,
+            .sourceFiles = {sourceFiles, sourceFiles + entry.sourceFilesSize},
+        });
+    }
+
+    Log::Info() << "Compacting shader pack: keeping " << packEntries.size() << " of " << index_.size() << " shaders.";
+
+    WritePackFile(packEntries);
+}
+
+void ShaderPack::Map()
+{
+    const Trace::Scope traceScope("ShaderPack::Map");
+
+    mappedFile_.reset();
+    index_.clear();
+
+    auto mappedFile = std::make_shared<MappedFile>();
+
+    mappedFile->file = CreateFileW(path_.wstring().c_str(),
+                                   GENERIC_READ,
+                                   FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                   nullptr,
+                                   OPEN_EXISTING,
+                                   FILE_ATTRIBUTE_NORMAL,
+                                   nullptr);
+
+    if (mappedFile->file == INVALID_HANDLE_VALUE) {
+        // No pack file yet
+        return;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(mappedFile->file, &fileSize) || (fileSize.QuadPart < sizeof(Header))) {
+        return;
+    }
+
+    mappedFile->size    = fileSize.QuadPart;
+    mappedFile->mapping = CreateFileMappingW(mappedFile->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if (mappedFile->mapping == nullptr) {
+        return;
+    }
+
+    mappedFile->data = static_cast<const std::uint8_t*>(MapViewOfFile(mappedFile->mapping, FILE_MAP_READ, 0, 0, 0));
+
+    if (mappedFile->data == nullptr) {
+        return;
+    }
+
+    Header header;
+    std::memcpy(&header, mappedFile->data, sizeof(header));
+
+    const auto IsInFile = [&](const std::uint64_t offset, const std::uint64_t size) {
+        return (offset <= mappedFile->size) && (size <= mappedFile->size - offset);
+    };
+
+    if ((header.magic != PackMagic) || (header.version != PackVersion) ||
+        (header.indexEntryCount > mappedFile->size / sizeof(IndexEntry)) ||
+        !IsInFile(header.indexOffset, header.indexEntryCount * sizeof(IndexEntry)))
+    {
+        Log::Error() << "Ignoring invalid shader pack \"" << path_.string() << "\".";
+        return;
+    }
+
+    for (std::uint64_t i = 0; i < header.indexEntryCount; ++i) {
+        IndexEntry entry;
+        std::memcpy(&entry, mappedFile->data + header.indexOffset + i * sizeof(IndexEntry), sizeof(entry));
+
+        if (IsInFile(entry.dataOffset, entry.dataSize) && IsInFile(entry.sourceFilesOffset, entry.sourceFilesSize)) {
+            index_[entry.key] = entry;
+        }
+    }
+
+    mappedFile_ = std::move(mappedFile);
+}
+
+void ShaderPack::WritePackFile(const std::vector<PackEntry>& entries)
+{
+    const Trace::Scope traceScope("ShaderPack::WritePackFile");
+
+    const auto temporaryPath = std::filesystem::path(path_).concat(".tmp");
+
+    {
+        std::ofstream file(temporaryPath, std::ios::binary);
+
+        if (!file) {
+            throw std::runtime_error("Failed to open file \"" + temporaryPath.string() + "\"");
+        }
+
+        std::vector<IndexEntry> index;
+        std::uint64_t           offset = sizeof(Header);
+
+        const auto WriteAtOffset = [&](const std::uint64_t targetOffset, const void* data, const std::size_t size) {
+            // Pad up to target offset
+            static constexpr char Padding[DataAlignment] = {};
+            file.write(Padding, targetOffset - offset);
+
+            file.write(static_cast<const char*>(data), size);
+            offset = targetOffset + size;
+        };
+
+        for (const auto& entry : entries) {
+            IndexEntry indexEntry = {
+                .key        = entry.key,
+                .dataOffset = AlignUp(offset, DataAlignment),
+                .dataSize   = entry.dataSize,
+            };
+            indexEntry.sourceFilesOffset = indexEntry.dataOffset + indexEntry.dataSize;
+            indexEntry.sourceFilesSize   = entry.sourceFiles.size();
+
+            WriteAtOffset(indexEntry.dataOffset, entry.data, entry.dataSize);
+            WriteAtOffset(indexEntry.sourceFilesOffset, entry.sourceFiles.data(), entry.sourceFiles.size());
+
+            index.emplace_back(indexEntry);
+        }
+
+        const Header header = {
+            .magic           = PackMagic,
+            .version         = PackVersion,
+            .indexOffset     = AlignUp(offset, sizeof(std::uint64_t)),
+            .indexEntryCount = index.size(),
+        };
+
+        WriteAtOffset(header.indexOffset, index.data(), index.size() * sizeof(IndexEntry));
+
+        file.seekp(0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        if (!file) {
+            throw std::runtime_error("Failed to write file \"" + temporaryPath.string() + "\"");
+        }
+    }
+
+    // Release own mapping before replacing the file
+    mappedFile_.reset();
+    index_.clear();
+
+    if (!MoveFileExW(temporaryPath.wstring().c_str(), path_.wstring().c_str(), MOVEFILE_REPLACE_EXISTING)) {
+        std::filesystem::remove(temporaryPath);
+        Map();
+
+        throw std::runtime_error("Failed to replace shader pack \"" + path_.string() +
+                                 "\". Make sure that no other instance is running.");
+    }
+
+    Map();
+}
+
+ShaderCompileResult ShaderPack::ReadEntry(const IndexEntry& entry, const std::filesystem::path& includeDirectory) const
+{
+    ShaderCompileResult result;
+
+    result.success = true;
+    result.blob    = Blob::CreateView(mappedFile_->data + entry.dataOffset, entry.dataSize, mappedFile_);
+
+    const auto* data = mappedFile_->data + entry.sourceFilesOffset;
+    std::size_t size = entry.sourceFilesSize;
+
+    const auto Read = [&](void* value, const std::size_t valueSize) {
+        if (valueSize > size) {
+            throw std::runtime_error("Shader pack entry is corrupted");
+        }
+
+        std::memcpy(value, data, valueSize);
+        data += valueSize;
+        size -= valueSize;
+    };
+
+    std::uint32_t count;
+    Read(&count, sizeof(count));
+
+    for (std::uint32_t i = 0; i < count; ++i) {
+        std::uint32_t length;
+        Read(&length, sizeof(length));
+
+        if (length > size) {
+            throw std::runtime_error("Shader pack entry is corrupted");
+        }
+
+        std::u8string path(length, u8'\0');
+        Read(path.data(), path.size());
+
+        std::uint64_t contentHash;
+        Read(&contentHash, sizeof(contentHash));
+
+        result.sourceFiles.push_back({
+            .path        = std::filesystem::absolute(includeDirectory / path).generic_string(),
+            .contentHash = contentHash,
+        });
+    }
+
+    return result;
+}
@@ -23,6 +23,8 @@
 
 #include "Swapchain.h"
 
+#include "Trace.h"
+
 Swapchain::Swapchain(const Device* device, const Window* window) : device_(device)
 {
     width_  = window->GetWidth();
@@ -99,7 +101,11 @@ Swapchain::Swapchain(const Device* device, const Window* window) : device_(devic
 Swapchain::RenderTarget Swapchain::GetNextRenderTarget()
 {
     // Wait for swapchain biffer
-    WaitForSingleObject(swapchainWaitableObject_, INFINITE);
+    {
+        const Trace::Scope traceScope("Swapchain::WaitForFrameLatency");
+
+        WaitForSingleObject(swapchainWaitableObject_, INFINITE);
+    }
 
     const auto  backbufferIndex = swapchain_->GetCurrentBackBufferIndex();
     const auto& colorTarget     = colorTargets_[backbufferIndex];
@@ -114,6 +120,8 @@ Swapchain::RenderTarget Swapchain::GetNextRenderTarget()
 
 void Swapchain::Present(const bool vsync)
 {
+    const Trace::Scope traceScope("Swapchain::Present");
+
     if (vsync) {
         ThrowIfFailed(swapchain_->Present(1, 0));
     } else {
@@ -123,6 +131,8 @@ void Swapchain::Present(const bool vsync)
 
 void Swapchain::Resize(std::uint32_t width, std::uint32_t height)
 {
+    const Trace::Scope traceScope("Swapchain::Resize");
+
     // Release current resources
     for (std::uint32_t index = 0; index < BackbufferCount; ++index) {
         colorTargets_[index].resource.Reset();
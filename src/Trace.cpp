@@ -0,0 +1,190 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "Trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    struct Zone {
+        const char*               name;
+        Trace::Clock::time_point start;
+        Trace::Clock::time_point end;
+    };
+
+    // Single-producer ring buffer. Only the owning thread writes zones,
+    // WriteChromeTrace reads a snapshot and discards zones that might have been overwritten while copying.
+    struct ThreadBuffer {
+        std::uint32_t              threadId;
+        std::atomic<const char*>   threadName = nullptr;
+        std::unique_ptr<Zone[]>    zones      = std::make_unique<Zone[]>(Trace::ZonesPerThread);
+        std::atomic<std::uint64_t> writeIndex = 0;
+    };
+
+    // Thread buffers are never released, such that zones of finished threads can still be written.
+    struct Registry {
+        std::mutex                                 mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+        Trace::Clock::time_point                   startTime = Trace::Clock::now();
+    };
+
+    Registry& GetRegistry()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    ThreadBuffer& GetThreadBuffer()
+    {
+        thread_local ThreadBuffer* buffer = [] {
+            auto& registry = GetRegistry();
+
+            std::lock_guard lock(registry.mutex);
+
+            auto& result     = registry.buffers.emplace_back(std::make_unique<ThreadBuffer>());
+            result->threadId = static_cast<std::uint32_t>(registry.buffers.size());
+
+            return result.get();
+        }();
+
+        return *buffer;
+    }
+
+    void WriteEscaped(std::ostream& stream, const char* string)
+    {
+        for (; *string != '\0'; ++string) {
+            if ((*string == '"') || (*string == '\\')) {
+                stream << '\\';
+            }
+            stream << *string;
+        }
+    }
+}  // namespace
+
+Trace::Scope::Scope(const char* name) : name_(name), start_(Clock::now()) {}
+
+Trace::Scope::~Scope()
+{
+    const auto end = Clock::now();
+
+    auto& buffer = GetThreadBuffer();
+
+    const auto index = buffer.writeIndex.load(std::memory_order_relaxed);
+
+    buffer.zones[index % ZonesPerThread] = Zone{
+        .name  = name_,
+        .start = start_,
+        .end   = end,
+    };
+
+    // Publish zone to readers
+    buffer.writeIndex.store(index + 1, std::memory_order_release);
+}
+
+void Trace::SetThreadName(const char* name)
+{
+    GetThreadBuffer().threadName.store(name, std::memory_order_relaxed);
+}
+
+void Trace::WriteChromeTrace(const std::filesystem::path& path, const double lastSeconds)
+{
+    auto& registry = GetRegistry();
+
+    const auto now     = Clock::now();
+    const auto minTime = (lastSeconds > 0.0)
+                             ? now - std::chrono::duration_cast<Clock::duration>(
+                                         std::chrono::duration<double>(lastSeconds))
+                             : Clock::time_point::min();
+
+    std::ofstream file(path);
+
+    if (!file) {
+        throw std::runtime_error("Failed to open trace file \"" + path.string() + "\"");
+    }
+
+    const auto ToMicroseconds = [&](const Clock::duration duration) {
+        return std::chrono::duration<double, std::micro>(duration).count();
+    };
+
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    bool firstEvent = true;
+
+    std::lock_guard lock(registry.mutex);
+
+    for (const auto& buffer : registry.buffers) {
+        // Thread name metadata event
+        if (const auto* threadName = buffer->threadName.load(std::memory_order_relaxed)) {
+            file << (firstEvent ? "" : ",\n") << R"({"name":"thread_name","ph":"M","pid":1,"tid":)"
+                 << buffer->threadId << R"(,"args":{"name":")";
+            WriteEscaped(file, threadName);
+            file << "\"}}";
+
+            firstEvent = false;
+        }
+
+        // Copy snapshot of ring buffer
+        const auto endIndex   = buffer->writeIndex.load(std::memory_order_acquire);
+        const auto beginIndex = (endIndex > ZonesPerThread) ? endIndex - ZonesPerThread : 0;
+
+        std::vector<Zone> zones;
+        zones.reserve(endIndex - beginIndex);
+
+        for (auto index = beginIndex; index < endIndex; ++index) {
+            zones.push_back(buffer->zones[index % ZonesPerThread]);
+        }
+
+        // Zones written by the owning thread while copying may have overwritten the oldest entries of the snapshot.
+        // The owning thread may also be writing the slot of index overwrittenEndIndex, which still holds index
+        // overwrittenEndIndex - ZonesPerThread, thus that zone is not valid either.
+        const auto overwrittenEndIndex = buffer->writeIndex.load(std::memory_order_acquire);
+        const auto firstValidIndex =
+            (overwrittenEndIndex >= ZonesPerThread) ? overwrittenEndIndex - ZonesPerThread + 1 : 0;
+
+        for (auto index = std::max(beginIndex, firstValidIndex); index < endIndex; ++index) {
+            const auto& zone = zones[index - beginIndex];
+
+            if (zone.end < minTime) {
+                continue;
+            }
+
+            file << (firstEvent ? "" : ",\n") << R"({"name":")";
+            WriteEscaped(file, zone.name);
+            file << R"(","ph":"X","pid":1,"tid":)" << buffer->threadId
+                 << ",\"ts\":" << ToMicroseconds(zone.start - registry.startTime)
+                 << ",\"dur\":" << ToMicroseconds(zone.end - zone.start) << "}";
+
+            firstEvent = false;
+        }
+    }
+
+    file << "\n]}\n";
+}
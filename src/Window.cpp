@@ -103,6 +103,11 @@ std::uint32_t Window::GetHeight() const
     return height_;
 }
 
+bool Window::IsResizing() const
+{
+    return resizing_;
+}
+
 // Forward-declaration of ImGui Message Proc Handler
 extern IMGUI_IMPL_API LRESULT ImGui_ImplWin32_WndProcHandler(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
@@ -128,6 +133,14 @@ LRESULT WINAPI Window::MessageProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lP
         window->height_ = HIWORD(lParam);
     }
         return 0;
+    case WM_ENTERSIZEMOVE:
+    case WM_EXITSIZEMOVE: {
+        Window* window = reinterpret_cast<Window*>(GetWindowLongPtr(hWnd, GWLP_USERDATA));
+
+        // Swapchain resizing is deferred until the user stops dragging the window border
+        window->resizing_ = (msg == WM_ENTERSIZEMOVE);
+    }
+        return 0;
     case WM_SYSCOMMAND:
         if ((wParam & 0xfff0) == SC_KEYMENU)  // Disable ALT application menu
             return 0;
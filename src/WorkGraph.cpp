@@ -23,66 +23,110 @@
 
 #include "WorkGraph.h"
 
+#include <algorithm>
+#include <fstream>
+#include <regex>
+
 #include "Application.h"
 #include "Swapchain.h"
+#include "Trace.h"
+
+namespace {
+    // Format of declared textures, accessed as RWTexture2D<float4>
+    constexpr DXGI_FORMAT ResourceTextureFormat = DXGI_FORMAT_R32G32B32A32_FLOAT;
 
-WorkGraph::WorkGraph(const Device*        device,
-                     ShaderCompiler&      shaderCompiler,
-                     ID3D12RootSignature* rootSignature,
-                     const std::uint32_t  tutorialIndex,
-                     const bool           sampleSolution)
-    : tutorialIndex_(tutorialIndex), sampleSolution_(sampleSolution)
-{
     // Name for work graph program inside the state object
-    static const wchar_t* WorkGraphProgramName = L"WorkGraph";
+    constexpr const wchar_t* WorkGraphProgramName = L"WorkGraph";
+
+    // Node and function names are ASCII
+    std::wstring ToWideString(const std::string& string)
+    {
+        return std::wstring(string.begin(), string.end());
+    }
 
-    // Create work graph
-    CD3DX12_STATE_OBJECT_DESC stateObjectDesc(D3D12_STATE_OBJECT_TYPE_EXECUTABLE);
+    // Raw buffers are accessed in 32-bit elements
+    std::uint64_t GetBufferSize(const WorkGraph::ResourceDeclaration& declaration)
+    {
+        return (declaration.width + 3) & ~std::uint64_t(3);
+    }
 
-    // set root signature for work graph
-    auto rootSignatureSubobject = stateObjectDesc.CreateSubobject<CD3DX12_GLOBAL_ROOT_SIGNATURE_SUBOBJECT>();
-    rootSignatureSubobject->SetRootSignature(rootSignature);
+    // Creates work graph state object with all nodes of "library". If "entryFunctionName" is not empty, the node
+    // shader function is promoted to an entry point.
+    ComPtr<ID3D12StateObject> CreateStateObject(const Device*        device,
+                                                IDxcBlob*            library,
+                                                ID3D12RootSignature* rootSignature,
+                                                const std::wstring&  entryFunctionName)
+    {
+        // Create work graph
+        CD3DX12_STATE_OBJECT_DESC stateObjectDesc(D3D12_STATE_OBJECT_TYPE_EXECUTABLE);
 
-    auto workgraphSubobject = stateObjectDesc.CreateSubobject<CD3DX12_WORK_GRAPH_SUBOBJECT>();
-    workgraphSubobject->IncludeAllAvailableNodes();
-    workgraphSubobject->SetProgramName(WorkGraphProgramName);
+        // set root signature for work graph
+        auto rootSignatureSubobject = stateObjectDesc.CreateSubobject<CD3DX12_GLOBAL_ROOT_SIGNATURE_SUBOBJECT>();
+        rootSignatureSubobject->SetRootSignature(rootSignature);
 
-    // list of compiled shaders to be released once the work graph is created
-    std::vector<ComPtr<IDxcBlob>> compiledShaders;
+        auto workgraphSubobject = stateObjectDesc.CreateSubobject<CD3DX12_WORK_GRAPH_SUBOBJECT>();
+        workgraphSubobject->IncludeAllAvailableNodes();
+        workgraphSubobject->SetProgramName(WorkGraphProgramName);
 
-    // Helper function for adding a shader library to the work graph state object
-    const auto AddShaderLibrary = [&](const std::string& shaderFileName) {
-        // compile shader as library
-        auto blob           = shaderCompiler.CompileShader(shaderFileName, L"lib_6_8", nullptr);
-        auto shaderBytecode = CD3DX12_SHADER_BYTECODE(blob->GetBufferPointer(), blob->GetBufferSize());
+        if (!entryFunctionName.empty()) {
+            // Common compute overrides apply to all launch types
+            auto overrides = workgraphSubobject->CreateCommonComputeNodeOverrides(entryFunctionName.c_str());
+            overrides->ProgramEntry(TRUE);
+        }
 
-        // add blob to state object
+        // add shader library to state object
+        auto shaderBytecode   = CD3DX12_SHADER_BYTECODE(library->GetBufferPointer(), library->GetBufferSize());
         auto librarySubobject = stateObjectDesc.CreateSubobject<CD3DX12_DXIL_LIBRARY_SUBOBJECT>();
         librarySubobject->SetDXILLibrary(&shaderBytecode);
 
-        // add shader blob to be released later
-        compiledShaders.emplace_back(std::move(blob));
-    };
+        const Trace::Scope createTraceScope("ID3D12Device::CreateStateObject");
 
-    // ===================================
-    // Add shader libraries
-    const auto  tutorials = Application::GetTutorials();
-    const auto& tutorial  = tutorials[tutorialIndex_];
+        ComPtr<ID3D12StateObject> stateObject;
+        ThrowIfFailed(device->GetDevice()->CreateStateObject(stateObjectDesc, IID_PPV_ARGS(&stateObject)));
 
-    if (sampleSolution_) {
-        if (tutorial.solutionShaderFileName.empty()) {
-            throw std::runtime_error("selected tutorial does not provide a sample solution.");
-        }
-        AddShaderLibrary(tutorial.solutionShaderFileName);
-    } else {
-        AddShaderLibrary(tutorial.shaderFileName);
+        return stateObject;
     }
+}  // namespace
+
+WorkGraph::WorkGraph(const Device*        device,
+                     ShaderCompiler&      shaderCompiler,
+                     DescriptorHeap&      descriptorHeap,
+                     ID3D12RootSignature* rootSignature,
+                     const std::uint32_t  tutorialIndex,
+                     const bool           sampleSolution)
+    : WorkGraph(device,
+                shaderCompiler,
+                descriptorHeap,
+                CompileLibrary(shaderCompiler, tutorialIndex, sampleSolution),
+                rootSignature,
+                tutorialIndex,
+                sampleSolution)
+{
+}
+
+WorkGraph::WorkGraph(const Device*         device,
+                     const ShaderCompiler& shaderCompiler,
+                     DescriptorHeap&       descriptorHeap,
+                     ComPtr<IDxcBlob>      library,
+                     ID3D12RootSignature*  rootSignature,
+                     const std::uint32_t   tutorialIndex,
+                     const bool            sampleSolution,
+                     const EntryNode*      entryNode)
+    : tutorialIndex_(tutorialIndex),
+      sampleSolution_(sampleSolution),
+      resourceDeclarations_(ReadResourceDeclarations(shaderCompiler, tutorialIndex, sampleSolution)),
+      descriptorHeap_(descriptorHeap)
+{
+    const Trace::Scope traceScope("WorkGraph::WorkGraph");
+
+    const auto entryNodeName     = entryNode ? ToWideString(entryNode->name) : std::wstring(L"Entry");
+    const auto entryFunctionName = entryNode ? ToWideString(entryNode->functionName) : std::wstring();
 
     // Create work graph state object
-    ThrowIfFailed(device->GetDevice()->CreateStateObject(stateObjectDesc, IID_PPV_ARGS(&stateObject_)));
+    stateObject_ = CreateStateObject(device, library.Get(), rootSignature, entryFunctionName);
 
-    // release all compiled shaders
-    compiledShaders.clear();
+    // keep shader blob for analysis. Blobs loaded from the shader pack do not hold a copy of the DXIL.
+    libraries_.emplace_back(std::move(library));
 
     // Get work graph properties
     ComPtr<ID3D12StateObjectProperties1> stateObjectProperties;
@@ -94,61 +138,83 @@ WorkGraph::WorkGraph(const Device*        device,
     // Get the index of our work graph inside the state object (state object can contain multiple work graphs)
     const auto workGraphIndex = workGraphProperties->GetWorkGraphIndex(WorkGraphProgramName);
 
-    // Create backing memory buffer
+    // Get backing memory requirements
     // See https://microsoft.github.io/DirectX-Specs/d3d/WorkGraphs.html#getworkgraphmemoryrequirements
-    D3D12_WORK_GRAPH_MEMORY_REQUIREMENTS memoryRequirements = {};
-    workGraphProperties->GetWorkGraphMemoryRequirements(workGraphIndex, &memoryRequirements);
-
-    // Work graphs can also request no backing memory (i.e., MaxSizeInBytes = 0)
-    if (memoryRequirements.MaxSizeInBytes > 0) {
-        CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_DEFAULT);
-        CD3DX12_RESOURCE_DESC   resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(memoryRequirements.MaxSizeInBytes,
-                                                                           D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
-        ThrowIfFailed(device->GetDevice()->CreateCommittedResource(&heapProperties,
-                                                                   D3D12_HEAP_FLAG_NONE,
-                                                                   &resourceDesc,
-                                                                   D3D12_RESOURCE_STATE_COMMON,
-                                                                   NULL,
-                                                                   IID_PPV_ARGS(&backingMemory_)));
-    }
+    workGraphProperties->GetWorkGraphMemoryRequirements(workGraphIndex, &memoryRequirements_);
 
     // Prepare work graph desc
     // See https://microsoft.github.io/DirectX-Specs/d3d/WorkGraphs.html#d3d12_set_program_desc
     programDesc_.Type                        = D3D12_PROGRAM_TYPE_WORK_GRAPH;
     programDesc_.WorkGraph.ProgramIdentifier = stateObjectProperties->GetProgramIdentifier(WorkGraphProgramName);
-    // Set flag to initialize backing memory.
-    // We'll clear this flag once we've run the work graph for the first time.
-    programDesc_.WorkGraph.Flags             = D3D12_SET_WORK_GRAPH_FLAG_INITIALIZE;
-    // Set backing memory
-    if (backingMemory_) {
-        programDesc_.WorkGraph.BackingMemory.StartAddress = backingMemory_->GetGPUVirtualAddress();
-        programDesc_.WorkGraph.BackingMemory.SizeInBytes  = backingMemory_->GetDesc().Width;
-    }
+
+    // Create backing memory buffer with maximum size
+    CreateBackingMemory(device, memoryRequirements_.MaxSizeInBytes);
 
     // All tutorial work graphs must declare a node named "Entry" with an empty record (i.e., no input record).
     // The D3D12_DISPATCH_GRAPH_DESC uses entrypoint indices instead of string-based node IDs to reference the enty node.
     // GetEntrypointIndex allows us to translate from a node ID (i.e., node name and node array index)
     // to an entrypoint index.
     // See https://microsoft.github.io/DirectX-Specs/d3d/WorkGraphs.html#getentrypointindex
-    entryPointIndex_ = workGraphProperties->GetEntrypointIndex(workGraphIndex, {L"Entry", 0});
+    entryPointIndex_ = workGraphProperties->GetEntrypointIndex(
+        workGraphIndex, {entryNodeName.c_str(), entryNode ? entryNode->arrayIndex : 0});
 
     // Check if entrypoint was found.
     if (entryPointIndex_ == 0xFFFFFFFFU) {
+        if (entryNode) {
+            throw std::runtime_error("work graph does not contain node \"" + entryNode->name + "\".");
+        }
         throw std::runtime_error("work graph does not contain an entry node with [NodeId(\"Entry\", 0)].");
     }
+
+    entryRecordSize_ = workGraphProperties->GetEntrypointRecordSizeInBytes(workGraphIndex, entryPointIndex_);
+
+    resourceDescriptorIndex_ = CreateResources(device, descriptorHeap_, resourceDeclarations_, resources_);
+    resourceMemorySize_      = GetAllocationSize(device, resources_);
+}
+
+D3D12_WORK_GRAPH_MEMORY_REQUIREMENTS WorkGraph::QueryMemoryRequirements(const Device*        device,
+                                                                    IDxcBlob*            library,
+                                                                    ID3D12RootSignature* rootSignature)
+{
+    const Trace::Scope traceScope("WorkGraph::QueryMemoryRequirements");
+
+    const auto stateObject = CreateStateObject(device, library, rootSignature, {});
+
+    ComPtr<ID3D12WorkGraphProperties> workGraphProperties;
+    ThrowIfFailed(stateObject->QueryInterface(IID_PPV_ARGS(&workGraphProperties)));
+
+    D3D12_WORK_GRAPH_MEMORY_REQUIREMENTS memoryRequirements = {};
+    workGraphProperties->GetWorkGraphMemoryRequirements(
+        workGraphProperties->GetWorkGraphIndex(WorkGraphProgramName), &memoryRequirements);
+
+    return memoryRequirements;
+}
+
+WorkGraph::~WorkGraph()
+{
+    descriptorHeap_.Free(resourceDescriptorIndex_, MaxResourceCount);
 }
 
 void WorkGraph::Dispatch(ID3D12GraphicsCommandList10* commandList)
 {
-    D3D12_DISPATCH_GRAPH_DESC dispatchDesc        = {};
-    dispatchDesc.Mode                             = D3D12_DISPATCH_MODE_NODE_CPU_INPUT;
-    dispatchDesc.NodeCPUInput                     = {};
-    dispatchDesc.NodeCPUInput.EntrypointIndex     = entryPointIndex_;
-    // Launch graph with one record
-    dispatchDesc.NodeCPUInput.NumRecords          = 1;
-    // Record does not contain any data
-    dispatchDesc.NodeCPUInput.RecordStrideInBytes = 0;
-    dispatchDesc.NodeCPUInput.pRecords            = nullptr;
+    const Trace::Scope traceScope("WorkGraph::Dispatch");
+
+    D3D12_DISPATCH_GRAPH_DESC dispatchDesc = {};
+
+    if (gpuInput_ != 0) {
+        // Entrypoint, record count and records are read from GPU memory
+        dispatchDesc.Mode         = D3D12_DISPATCH_MODE_NODE_GPU_INPUT;
+        dispatchDesc.NodeGPUInput = gpuInput_;
+    } else {
+        dispatchDesc.Mode                             = D3D12_DISPATCH_MODE_NODE_CPU_INPUT;
+        dispatchDesc.NodeCPUInput                     = {};
+        dispatchDesc.NodeCPUInput.EntrypointIndex     = entryPointIndex_;
+        // Launch graph with one record
+        dispatchDesc.NodeCPUInput.NumRecords          = 1;
+        // Record does not contain any data
+        dispatchDesc.NodeCPUInput.RecordStrideInBytes = 0;
+        dispatchDesc.NodeCPUInput.pRecords            = nullptr;
+    }
 
     // Set program and dispatch the work graphs.
     // See
@@ -158,11 +224,41 @@ void WorkGraph::Dispatch(ID3D12GraphicsCommandList10* commandList)
     commandList->SetProgram(&programDesc_);
     commandList->DispatchGraph(&dispatchDesc);
 
+    // Remaining record batches of GPU input
+    for (std::uint32_t batch = 1; (gpuInput_ != 0) && (batch < gpuInputBatchCount_); ++batch) {
+        // Batches run one after another, like separate dispatches
+        const auto barrier = CD3DX12_RESOURCE_BARRIER::UAV(nullptr);
+        commandList->ResourceBarrier(1, &barrier);
+
+        dispatchDesc.NodeGPUInput = gpuInput_ + batch * GpuInputStride;
+
+        // Backing memory is only initialized once
+        programDesc_.WorkGraph.Flags &= ~D3D12_SET_WORK_GRAPH_FLAG_INITIALIZE;
+        commandList->SetProgram(&programDesc_);
+        commandList->DispatchGraph(&dispatchDesc);
+    }
+
     // Clear backing memory initialization flag, as the graph has run at least once now
     // See https://microsoft.github.io/DirectX-Specs/d3d/WorkGraphs.html#d3d12_set_work_graph_flags
     programDesc_.WorkGraph.Flags &= ~D3D12_SET_WORK_GRAPH_FLAG_INITIALIZE;
 }
 
+void WorkGraph::SetGpuInput(const D3D12_GPU_VIRTUAL_ADDRESS gpuInput, const std::uint32_t batchCount)
+{
+    gpuInput_           = gpuInput;
+    gpuInputBatchCount_ = std::max(batchCount, 1u);
+}
+
+std::uint32_t WorkGraph::GetEntryPointIndex() const
+{
+    return entryPointIndex_;
+}
+
+std::uint32_t WorkGraph::GetEntryRecordSize() const
+{
+    return entryRecordSize_;
+}
+
 std::uint32_t WorkGraph::GetTutorialIndex() const
 {
     return tutorialIndex_;
@@ -172,3 +268,256 @@ bool WorkGraph::IsSampleSolution() const
 {
     return sampleSolution_;
 }
+
+std::uint64_t WorkGraph::GetBackingMemorySize() const
+{
+    return backingMemory_ ? backingMemory_->GetDesc().Width : 0;
+}
+
+const D3D12_WORK_GRAPH_MEMORY_REQUIREMENTS& WorkGraph::GetMemoryRequirements() const
+{
+    return memoryRequirements_;
+}
+
+void WorkGraph::SetBackingMemorySize(const Device* device, const std::uint64_t size)
+{
+    const auto minSize     = memoryRequirements_.MinSizeInBytes;
+    const auto granularity = std::max<std::uint64_t>(memoryRequirements_.SizeGranularityInBytes, 1);
+
+    // Valid sizes are MinSizeInBytes plus a multiple of SizeGranularityInBytes
+    const auto stepCount = (std::max(size, minSize) - minSize + granularity - 1) / granularity;
+
+    CreateBackingMemory(device, std::min(minSize + stepCount * granularity, memoryRequirements_.MaxSizeInBytes));
+}
+
+void WorkGraph::InitializeBackingMemory()
+{
+    programDesc_.WorkGraph.Flags |= D3D12_SET_WORK_GRAPH_FLAG_INITIALIZE;
+}
+
+void WorkGraph::CreateBackingMemory(const Device* device, const std::uint64_t size)
+{
+    const Trace::Scope traceScope("WorkGraph::CreateBackingMemory");
+
+    backingMemory_.Reset();
+
+    // Work graphs can also request no backing memory (i.e., MaxSizeInBytes = 0)
+    if (size > 0) {
+        CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_DEFAULT);
+        CD3DX12_RESOURCE_DESC   resourceDesc =
+            CD3DX12_RESOURCE_DESC::Buffer(size, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+        ThrowIfFailed(device->GetDevice()->CreateCommittedResource(&heapProperties,
+                                                                   D3D12_HEAP_FLAG_NONE,
+                                                                   &resourceDesc,
+                                                                   D3D12_RESOURCE_STATE_COMMON,
+                                                                   NULL,
+                                                                   IID_PPV_ARGS(&backingMemory_)));
+    }
+
+    // Set backing memory
+    programDesc_.WorkGraph.BackingMemory = {};
+    if (backingMemory_) {
+        programDesc_.WorkGraph.BackingMemory.StartAddress = backingMemory_->GetGPUVirtualAddress();
+        programDesc_.WorkGraph.BackingMemory.SizeInBytes  = backingMemory_->GetDesc().Width;
+    }
+
+    // Set flag to initialize backing memory.
+    // We'll clear this flag once we've run the work graph for the first time.
+    InitializeBackingMemory();
+}
+
+std::uint64_t WorkGraph::GetResourceMemorySize() const
+{
+    return resourceMemorySize_;
+}
+
+std::span<const ComPtr<IDxcBlob>> WorkGraph::GetLibraries() const
+{
+    return libraries_;
+}
+
+std::span<const WorkGraph::ResourceDeclaration> WorkGraph::GetResourceDeclarations() const
+{
+    return resourceDeclarations_;
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE WorkGraph::GetResourceDescriptorTable() const
+{
+    return descriptorHeap_.GetGPUHandle(resourceDescriptorIndex_);
+}
+
+std::string WorkGraph::GetShaderFileName(const std::uint32_t tutorialIndex, const bool sampleSolution)
+{
+    const auto  tutorials = Application::GetTutorials();
+    const auto& tutorial  = tutorials[tutorialIndex];
+
+    if (sampleSolution) {
+        if (tutorial.solutionShaderFileName.empty()) {
+            throw std::runtime_error("selected tutorial does not provide a sample solution.");
+        }
+        return tutorial.solutionShaderFileName;
+    }
+
+    return tutorial.shaderFileName;
+}
+
+ComPtr<IDxcBlob> WorkGraph::CompileLibrary(ShaderCompiler&             shaderCompiler,
+                                           const std::uint32_t         tutorialIndex,
+                                           const bool                  sampleSolution,
+                                           const ShaderCompileOptions& options)
+{
+    // compile shader as library
+    return shaderCompiler.CompileShader(
+        GetShaderFileName(tutorialIndex, sampleSolution), L"lib_6_8", nullptr, options);
+}
+
+ComPtr<IDxcBlob> WorkGraph::FindCompiledLibrary(ShaderCompiler&     shaderCompiler,
+                                                const std::uint32_t tutorialIndex,
+                                                const bool          sampleSolution)
+{
+    return shaderCompiler.FindCompiledShader(GetShaderFileName(tutorialIndex, sampleSolution), L"lib_6_8", nullptr);
+}
+
+std::vector<WorkGraph::ResourceDeclaration> WorkGraph::ReadResourceDeclarations(const ShaderCompiler& shaderCompiler,
+                                                                              const std::uint32_t   tutorialIndex,
+                                                                              const bool            sampleSolution)
+{
+    return ReadResourceDeclarations(shaderCompiler, GetShaderFileName(tutorialIndex, sampleSolution));
+}
+
+std::vector<WorkGraph::ResourceDeclaration> WorkGraph::ReadResourceDeclarations(const ShaderCompiler& shaderCompiler,
+                                                                              const std::string&    shaderFileName)
+{
+    static const std::regex bufferPattern(R"(//\s*@Buffer\(\s*u(\d+)\s*,\s*(\d+)\s*\))");
+    static const std::regex texturePattern(R"(//\s*@Texture\(\s*u(\d+)\s*,\s*(\d+)\s*,\s*(\d+)\s*\))");
+
+    std::vector<ResourceDeclaration> declarations;
+
+    // Only the shader file itself is searched, not its includes
+    std::ifstream file(shaderCompiler.GetShaderSourceFilePath(shaderFileName));
+    std::string   line;
+
+    while (std::getline(file, line)) {
+        std::smatch match;
+
+        if (std::regex_search(line, match, bufferPattern)) {
+            declarations.push_back({
+                .type          = ResourceDeclaration::Type::Buffer,
+                .registerIndex = static_cast<std::uint32_t>(std::stoul(match[1])),
+                .width         = std::stoull(match[2]),
+                .height        = 1,
+            });
+        } else if (std::regex_search(line, match, texturePattern)) {
+            declarations.push_back({
+                .type          = ResourceDeclaration::Type::Texture,
+                .registerIndex = static_cast<std::uint32_t>(std::stoul(match[1])),
+                .width         = std::stoull(match[2]),
+                .height        = static_cast<std::uint32_t>(std::stoul(match[3])),
+            });
+        } else {
+            continue;
+        }
+
+        const auto& declaration = declarations.back();
+
+        if ((declaration.registerIndex < FirstResourceRegister) ||
+            (declaration.registerIndex >= FirstResourceRegister + MaxResourceCount))
+        {
+            throw std::runtime_error("resource declaration \"" + match.str() + "\" must use a register from u" +
+                                     std::to_string(FirstResourceRegister) + " to u" +
+                                     std::to_string(FirstResourceRegister + MaxResourceCount - 1) + ".");
+        }
+        if ((declaration.width == 0) || (declaration.height == 0)) {
+            throw std::runtime_error("resource declaration \"" + match.str() + "\" has zero size.");
+        }
+        if ((declaration.type == ResourceDeclaration::Type::Texture) &&
+            ((declaration.width > D3D12_REQ_TEXTURE2D_U_OR_V_DIMENSION) ||
+             (declaration.height > D3D12_REQ_TEXTURE2D_U_OR_V_DIMENSION)))
+        {
+            throw std::runtime_error("resource declaration \"" + match.str() + "\" exceeds maximum texture size.");
+        }
+        if (std::ranges::count(declarations, declaration.registerIndex, &ResourceDeclaration::registerIndex) > 1) {
+            throw std::runtime_error("register u" + std::to_string(declaration.registerIndex) +
+                                     " is declared more than once.");
+        }
+    }
+
+    return declarations;
+}
+
+std::uint32_t WorkGraph::CreateResources(const Device*                        device,
+                                         DescriptorHeap&                      descriptorHeap,
+                                         std::span<const ResourceDeclaration> declarations,
+                                         std::vector<ComPtr<ID3D12Resource>>& resources)
+{
+    const Trace::Scope traceScope("WorkGraph::CreateResources");
+
+    for (const auto& declaration : declarations) {
+        const auto resourceDesc =
+            (declaration.type == ResourceDeclaration::Type::Buffer)
+                ? CD3DX12_RESOURCE_DESC::Buffer(GetBufferSize(declaration), D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS)
+                : CD3DX12_RESOURCE_DESC::Tex2D(ResourceTextureFormat,
+                                               declaration.width,
+                                               declaration.height,
+                                               1,
+                                               1,
+                                               1,
+                                               0,
+                                               D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+
+        // Committed resources are zero-initialized
+        ComPtr<ID3D12Resource>  resource;
+        CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_DEFAULT);
+        ThrowIfFailed(device->GetDevice()->CreateCommittedResource(&heapProperties,
+                                                                   D3D12_HEAP_FLAG_NONE,
+                                                                   &resourceDesc,
+                                                                   D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+                                                                   nullptr,
+                                                                   IID_PPV_ARGS(&resource)));
+
+        resources.emplace_back(std::move(resource));
+    }
+
+    // Descriptors are allocated last, as they are only freed by the destructor of the owner
+    const auto descriptorIndex = descriptorHeap.Allocate(MaxResourceCount);
+
+    for (std::uint32_t slot = 0; slot < MaxResourceCount; ++slot) {
+        const auto it =
+            std::ranges::find(declarations, FirstResourceRegister + slot, &ResourceDeclaration::registerIndex);
+
+        // Unused registers get null descriptors
+        ID3D12Resource*                  resource = nullptr;
+        D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc  = {};
+        uavDesc.ViewDimension                     = D3D12_UAV_DIMENSION_BUFFER;
+        uavDesc.Format                            = DXGI_FORMAT_R32_TYPELESS;
+        uavDesc.Buffer.Flags                      = D3D12_BUFFER_UAV_FLAG_RAW;
+
+        if (it != declarations.end()) {
+            resource = resources[std::distance(declarations.begin(), it)].Get();
+
+            if (it->type == ResourceDeclaration::Type::Buffer) {
+                uavDesc.Buffer.NumElements = static_cast<UINT>(GetBufferSize(*it) / sizeof(std::uint32_t));
+            } else {
+                uavDesc.ViewDimension = D3D12_UAV_DIMENSION_TEXTURE2D;
+                uavDesc.Format        = ResourceTextureFormat;
+            }
+        }
+
+        device->GetDevice()->CreateUnorderedAccessView(
+            resource, nullptr, &uavDesc, descriptorHeap.GetCPUHandle(descriptorIndex + slot));
+    }
+
+    return descriptorIndex;
+}
+
+std::uint64_t WorkGraph::GetAllocationSize(const Device* device, std::span<const ComPtr<ID3D12Resource>> resources)
+{
+    std::uint64_t size = 0;
+
+    for (const auto& resource : resources) {
+        const auto desc = resource->GetDesc();
+        size += device->GetDevice()->GetResourceAllocationInfo(0, 1, &desc).SizeInBytes;
+    }
+
+    return size;
+}
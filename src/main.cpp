@@ -21,30 +21,311 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 // THE SOFTWARE.
 
-#include <iostream>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
 
 #include "Application.h"
+#include "CompileServer.h"
+#include "Log.h"
+#include "OptimizationReport.h"
+
+namespace {
+    // Parses numeric argument "value" of command line flag "flag". Throws if "value" is not a number in the range of
+    // "result" or has trailing characters, which is reported as usage error by main.
+    template <typename T>
+    void ParseNumber(const std::string& flag, const std::string& value, T& result)
+    {
+        const auto* end              = value.data() + value.size();
+        const auto [position, error] = std::from_chars(value.data(), end, result);
+
+        if (value.empty() || (error != std::errc()) || (position != end)) {
+            throw std::invalid_argument("\"" + value + "\" is not a valid value for " + flag + ".");
+        }
+    }
+
+    // Asks to restart the application in safe mode after a GPU hang, which starts with the last good work graph
+    void OfferSafeModeRestart(const std::string& message, bool safeMode)
+    {
+        const auto text = message + "\n\nRestart in safe mode with the last work graph that completed on the GPU?";
+
+        if (MessageBoxA(nullptr, text.c_str(), "Work Graph Playground", MB_YESNO | MB_ICONERROR) != IDYES) {
+            return;
+        }
+
+        std::wstring commandLine = GetCommandLineW();
+        if (!safeMode) {
+            commandLine += L" --safeMode";
+        }
+
+        STARTUPINFOW        startupInfo = {.cb = sizeof(STARTUPINFOW)};
+        PROCESS_INFORMATION processInfo = {};
+
+        if (!CreateProcessW(
+                nullptr, commandLine.data(), nullptr, nullptr, FALSE, 0, nullptr, nullptr, &startupInfo, &processInfo))
+        {
+            Log::Error() << "Failed to restart in safe mode.";
+            return;
+        }
+
+        CloseHandle(processInfo.hThread);
+        CloseHandle(processInfo.hProcess);
+    }
+}  // namespace
 
 int main(int argc, char* argv[])
 {
     Application::Options options = {};
 
-    // Simple arg parsing for flags
-    for (int argIdx = 1; argIdx < argc; ++argIdx) {
-        using namespace std::string_literals;
+    bool                  rebuildShaderPack = false;
+    bool                  compactShaderPack = false;
+    std::filesystem::path nodeCostReportFile;
+    bool                  skipGpuTiming = false;
+
+    // Simple arg parsing for flags. Invalid arguments (e.g. unknown log levels) are reported as usage error.
+    try {
+        for (int argIdx = 1; argIdx < argc; ++argIdx) {
+            using namespace std::string_literals;
+
+            const auto arg = argv[argIdx];
+
+            options.forceWarpAdapter /*   */ |= (arg == "--forceWarpAdapter"s);
+            options.enableDebugLayer /*   */ |= (arg == "--enableDebugLayer"s);
+            options.enableGpuValidationLayer |= (arg == "--enableGpuValidationLayer"s);
+            options.useCompileServer /*   */ |= (arg == "--useCompileServer"s);
+            options.benchmarkAdapters /*  */ |= (arg == "--benchmarkAdapters"s);
+
+            if ((arg == "--logLevel"s) && (argIdx + 1 < argc)) {
+                Log::SetLevel(Log::ParseLevel(argv[++argIdx]));
+            }
+
+            if (arg == "--compileServer"s) {
+                // Run as compile server for other instances instead of starting the playground
+                try {
+                    CompileServer server;
+                    server.Run();
+                } catch (const std::exception& e) {
+                    Log::Error() << e.what();
+                    return 1;
+                }
+
+                return 0;
+            }
+
+            if ((arg == "--shaderPack"s) && (argIdx + 1 < argc)) {
+                options.shaderPackFile = argv[++argIdx];
+            }
+            if ((arg == "--adapterCache"s) && (argIdx + 1 < argc)) {
+                options.adapterCacheFile = argv[++argIdx];
+            }
+            if (arg == "--noAdapterCache"s) {
+                options.adapterCacheFile.clear();
+            }
+            if (arg == "--noShaderPack"s) {
+                options.shaderPackFile.clear();
+            }
+            if (arg == "--noTieredCompilation"s) {
+                options.tieredCompilation = false;
+            }
+            if ((arg == "--workGraphCacheSize"s) && (argIdx + 1 < argc)) {
+                ParseNumber(arg, argv[++argIdx], options.workGraphCacheSize);
+            }
+            if ((arg == "--workGraphCacheMemory"s) && (argIdx + 1 < argc)) {
+                // Limit is given in MiB
+                ParseNumber(arg, argv[++argIdx], options.workGraphCacheMemoryLimit);
+                options.workGraphCacheMemoryLimit *= 1024 * 1024;
+            }
+            rebuildShaderPack |= (arg == "--rebuildShaderPack"s);
+            compactShaderPack |= (arg == "--compactShaderPack"s);
+
+            if ((arg == "--nodeCostReport"s) && (argIdx + 1 < argc)) {
+                nodeCostReportFile = argv[++argIdx];
+            }
+            if ((arg == "--renderSize"s) && (argIdx + 2 < argc)) {
+                ParseNumber(arg, argv[++argIdx], options.renderWidth);
+                ParseNumber(arg, argv[++argIdx], options.renderHeight);
+            }
+            if ((arg == "--resolutionSweep"s) && (argIdx + 1 < argc)) {
+                options.resolutionSweepFile = argv[++argIdx];
+            }
+            if ((arg == "--optimizationReport"s) && (argIdx + 1 < argc)) {
+                options.optimizationReportFile = argv[++argIdx];
+            }
+            skipGpuTiming |= (arg == "--skipGpuTiming"s);
+
+            if ((arg == "--nodeBenchmark"s) && (argIdx + 1 < argc)) {
+                options.nodeBenchmark.outputFile = argv[++argIdx];
+            }
+            if ((arg == "--benchmarkTutorial"s) && (argIdx + 1 < argc)) {
+                ParseNumber(arg, argv[++argIdx], options.nodeBenchmark.tutorialIndex);
+            }
+            if (arg == "--benchmarkSolution"s) {
+                options.nodeBenchmark.sampleSolution = true;
+            }
+            if ((arg == "--benchmarkNode"s) && (argIdx + 1 < argc)) {
+                options.nodeBenchmark.node = argv[++argIdx];
+            }
+            if ((arg == "--benchmarkRecord"s) && (argIdx + 1 < argc)) {
+                options.nodeBenchmark.recordFields = argv[++argIdx];
+            }
+            if ((arg == "--benchmarkRecordFile"s) && (argIdx + 1 < argc)) {
+                options.nodeBenchmark.recordFile = argv[++argIdx];
+            }
+            if ((arg == "--benchmarkRecordCounts"s) && (argIdx + 1 < argc)) {
+                // Comma separated list, e.g. "1,64,4096"
+                options.nodeBenchmark.recordCounts.clear();
+
+                std::istringstream recordCounts(argv[++argIdx]);
+                std::string        recordCount;
+                while (std::getline(recordCounts, recordCount, ',')) {
+                    ParseNumber(arg, recordCount, options.nodeBenchmark.recordCounts.emplace_back());
+                }
+            }
 
-        const auto arg = argv[argIdx];
+            if ((arg == "--baselineBenchmark"s) && (argIdx + 1 < argc)) {
+                options.baselineBenchmarkFile = argv[++argIdx];
+            }
 
-        options.forceWarpAdapter /*   */ |= (arg == "--forceWarpAdapter"s);
-        options.enableDebugLayer /*   */ |= (arg == "--enableDebugLayer"s);
-        options.enableGpuValidationLayer |= (arg == "--enableGpuValidationLayer"s);
+            if ((arg == "--backingMemorySweep"s) && (argIdx + 1 < argc)) {
+                options.backingMemorySweep.outputFile = argv[++argIdx];
+            }
+            if ((arg == "--backingMemorySteps"s) && (argIdx + 1 < argc)) {
+                ParseNumber(arg, argv[++argIdx], options.backingMemorySweep.stepCount);
+            }
+            if ((arg == "--backingMemoryTolerance"s) && (argIdx + 1 < argc)) {
+                ParseNumber(arg, argv[++argIdx], options.backingMemorySweep.tolerance);
+            }
+
+            if ((arg == "--traceFile"s) && (argIdx + 1 < argc)) {
+                options.traceFile        = argv[++argIdx];
+                options.writeTraceOnExit = true;
+            }
+            if ((arg == "--recordInput"s) && (argIdx + 1 < argc)) {
+                options.recordInputFile = argv[++argIdx];
+            }
+            if ((arg == "--replayInput"s) && (argIdx + 1 < argc)) {
+                options.replayInputFile = argv[++argIdx];
+            }
+
+            if (arg == "--regressionTest"s) {
+                options.regressionTest.enabled = true;
+            }
+            if (arg == "--updateGoldenImages"s) {
+                options.regressionTest.enabled            = true;
+                options.regressionTest.updateGoldenImages = true;
+            }
+            if ((arg == "--goldenImageDirectory"s) && (argIdx + 1 < argc)) {
+                options.regressionTest.goldenImageDirectory = argv[++argIdx];
+            }
+
+            if ((arg == "--dispatchBudget"s) && (argIdx + 1 < argc)) {
+                ParseNumber(arg, argv[++argIdx], options.dispatchBudget);
+            }
+            if ((arg == "--gpuTimeout"s) && (argIdx + 1 < argc)) {
+                // Timeout is given in milliseconds
+                ParseNumber(arg, argv[++argIdx], options.gpuTimeout);
+            }
+            if (arg == "--safeMode"s) {
+                options.safeMode = true;
+            }
+            if ((arg == "--lastGoodWorkGraph"s) && (argIdx + 1 < argc)) {
+                options.lastGoodWorkGraphFile = argv[++argIdx];
+            }
+            if ((arg == "--benchmarkMaxBatchRecords"s) && (argIdx + 1 < argc)) {
+                ParseNumber(arg, argv[++argIdx], options.nodeBenchmark.maxBatchRecordCount);
+            }
+
+            if ((arg == "--recordTrace"s) && (argIdx + 1 < argc)) {
+                options.recordTrace.outputFile = argv[++argIdx];
+            }
+            if ((arg == "--recordTraceFrame"s) && (argIdx + 1 < argc)) {
+                ParseNumber(arg, argv[++argIdx], options.recordTrace.captureFrame);
+            }
+            if ((arg == "--recordTraceCapacity"s) && (argIdx + 1 < argc)) {
+                ParseNumber(arg, argv[++argIdx], options.recordTrace.capacity);
+            }
+            if (arg == "--profileMaxRecords"s) {
+                options.maxRecords.profile = true;
+            }
+            if ((arg == "--maxRecordsReport"s) && (argIdx + 1 < argc)) {
+                options.maxRecords.reportFile = argv[++argIdx];
+            }
+        }
+    } catch (const std::exception& e) {
+        Log::Error() << "Invalid command line arguments: " << e.what();
+        return 1;
+    }
+
+    const bool staticOptimizationReport = !options.optimizationReportFile.empty() && skipGpuTiming;
+
+    if (rebuildShaderPack || compactShaderPack || !nodeCostReportFile.empty() || staticOptimizationReport) {
+        // Shader pack maintenance & static analysis do not require a window or D3D12 device
+        try {
+            ShaderCompiler shaderCompiler(options.useCompileServer, options.shaderPackFile);
+
+            std::vector<std::string> shaderFiles;
+            for (const auto& tutorial : Application::GetTutorials()) {
+                for (const auto& shaderFile : {tutorial.shaderFileName, tutorial.solutionShaderFileName}) {
+                    if (!shaderFile.empty()) {
+                        shaderFiles.emplace_back(shaderFile);
+                    }
+                }
+            }
+
+            if (rebuildShaderPack && !shaderCompiler.RebuildShaderPack(shaderFiles)) {
+                return 1;
+            }
+            if (compactShaderPack) {
+                shaderCompiler.CompactShaderPack();
+            }
+
+            if (!nodeCostReportFile.empty()) {
+                std::ofstream report(nodeCostReportFile, std::ios::trunc);
+                NodeCostModel::WriteReportHeader(report);
+
+                for (const auto& shaderFile : shaderFiles) {
+                    const auto blob = shaderCompiler.CompileShader(shaderFile, L"lib_6_8", nullptr);
+                    NodeCostModel::WriteReport(
+                        report, shaderFile, NodeCostModel::Analyze(shaderCompiler.Disassemble(blob.Get())));
+                }
+
+                Log::Info() << "Node cost report written to " << nodeCostReportFile.string();
+            }
+
+            if (staticOptimizationReport) {
+                OptimizationReport::Write(options.optimizationReportFile, shaderCompiler);
+            }
+        } catch (const std::exception& e) {
+            Log::Error() << e.what();
+            return 1;
+        }
+
+        return 0;
     }
 
     try {
         Application app(options);
         app.Run();
+    } catch (const DeviceLostError& e) {
+        Log::Error() << e.what();
+
+        // Batch modes (benchmarks, reports, tests and input replay) exit without asking
+        const bool interactive = !options.regressionTest.enabled && options.optimizationReportFile.empty() &&
+                                 options.resolutionSweepFile.empty() && options.nodeBenchmark.outputFile.empty() &&
+                                 options.baselineBenchmarkFile.empty() &&
+                                 options.backingMemorySweep.outputFile.empty() && options.replayInputFile.empty();
+
+        if (interactive) {
+            // Error must be written before the dialog blocks and the restarted process shares the console
+            Log::Flush();
+            OfferSafeModeRestart(e.what(), options.safeMode);
+        }
+
+        return 1;
     } catch (const std::exception& e) {
-        std::cerr << e.what() << std::endl;
+        Log::Error() << e.what();
         return 1;
     }
 
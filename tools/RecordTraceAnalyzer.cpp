@@ -0,0 +1,69 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// Offline analyzer for record trace captures (see RecordTrace.h), e.g. on a Linux workstation:
+//
+//   cmake -S tools -B build-tools && cmake --build build-tools
+//   ./build-tools/RecordTraceAnalyzer capture.wgrt --perfetto capture.json
+//
+// Prints recursion depth and fan-out per node and optionally converts the capture to Perfetto JSON.
+
+#include <cstring>
+#include <iostream>
+
+#include "RecordTrace.h"
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <capture> [--perfetto <file>]\n";
+        return 1;
+    }
+
+    const std::filesystem::path capturePath = argv[1];
+    std::filesystem::path       perfettoPath;
+
+    for (int argIdx = 2; argIdx < argc; ++argIdx) {
+        if ((std::strcmp(argv[argIdx], "--perfetto") == 0) && (argIdx + 1 < argc)) {
+            perfettoPath = argv[++argIdx];
+        }
+    }
+
+    try {
+        const auto capture = RecordTrace::ReadCapture(capturePath);
+        const auto tree    = RecordTrace::BuildTree(capture);
+
+        RecordTrace::WriteSummary(std::cout, capture, tree);
+
+        if (!perfettoPath.empty()) {
+            RecordTrace::WritePerfettoJson(perfettoPath, capture, tree);
+            std::cout << "Perfetto trace written to " << perfettoPath.string() << "\n";
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -58,6 +58,17 @@ RWByteAddressBuffer ScratchBuffer : register(u1);
 // You can use this buffer to read and write your user data.
 RWByteAddressBuffer PersistentScratchBuffer : register(u2);
 
+// Additional buffers and textures can be declared in registers u3 to u10 with an annotation comment
+// in the tutorial file, e.g.
+//
+//   // @Buffer(u3, 1048576)
+//   RWByteAddressBuffer Particles : register(u3);
+//   // @Texture(u4, 512, 512)
+//   RWTexture2D<float4> HeightMap : register(u4);
+//
+// Buffer sizes are given in bytes, texture sizes in pixels.
+// Declared resources are zero-initialized when the tutorial is loaded.
+
 // Constants provided by Work Graph Playground Application.
 cbuffer Constants : register(b0)
 {
@@ -69,6 +80,16 @@ cbuffer Constants : register(b0)
     uint   InputState;
     // Time since the application start in seconds.
     float  Time;
+    // Iteration of the current pass in compute baselines (e.g., recursion level), zero for work graphs.
+    // See "Compute Baseline" in the readme for details.
+    uint   PassIteration;
+    // Number of watchdog::Consume calls allowed per dispatch, zero if unlimited. See watchdog namespace below.
+    uint   DispatchBudget;
+    // Capacity of the record trace buffer in events, zero if no record trace is captured. See recordtrace namespace
+    // below.
+    uint   RecordTraceCapacity;
+    // Number of MaxRecords probes, zero if MaxRecords are not profiled. See maxrecords namespace below.
+    uint   MaxRecordsProbeCount;
 };
 
 /* Helper struct for printing text to the screen.
@@ -813,4 +834,187 @@ namespace input {
         return InputState & (1 << 11);
     }
 
-}  // namespace input
\ No newline at end of file
+}  // namespace input
+
+// Watchdog against runaway work graphs.
+// An accidental infinite loop or unbounded recursion hangs the GPU until the OS resets it, which also terminates the
+// application. Nodes can guard record emission and loops with watchdog::Consume, which counts against a budget per
+// dispatch (see "--dispatchBudget" in the readme). Once the budget is exhausted, Consume returns false and the
+// application shows a warning, e.g.
+//
+//   // Output records must be requested in uniform control flow, thus an exhausted budget requests zero records
+//   const uint recordCount = watchdog::Consume(childCount) ? childCount : 0;
+//   ThreadNodeOutputRecords<ChildRecord> records = output.GetThreadNodeOutputRecords(recordCount);
+//
+// GetGroupNodeOutputRecords requires a group-uniform record count, thus group-shared output should consume its budget
+// on a single thread and broadcast the result (e.g. with groupshared memory).
+namespace watchdog {
+
+    // Counter of the current dispatch, cleared every frame by the application
+    RWByteAddressBuffer DispatchBudgetBuffer : register(u11);
+
+    // Consumes "count" units of the dispatch budget.
+    // Returns false if the budget is exhausted, in which case no further records should be emitted.
+    bool Consume(in const uint count = 1)
+    {
+        uint previous;
+        DispatchBudgetBuffer.InterlockedAdd(0, count, previous);
+
+        // previous + count may overflow once many calls exceeded the budget, thus the remaining budget is compared
+        return (DispatchBudget == 0) || ((previous <= DispatchBudget) && (count <= DispatchBudget - previous));
+    }
+
+}  // namespace watchdog
+
+// Dynamic record trace.
+// Instrumented nodes report their thread groups and output records, from which the application rebuilds the execution
+// tree of a frame, e.g., to see how deep a recursion actually goes (see "Record Trace" in the readme).
+// Node ids are chosen by the tutorial and named with annotation comments in the tutorial file, e.g.
+//
+//   // @TraceNode(1, MandelbrotGrid)
+//
+// Every group reports itself with BeginGroup, passing the group id of its producer, which is stored in the input
+// record. Outputs are reported with Output next to the output record request:
+//
+//   const uint group = recordtrace::BeginThreadGroup(groupIndex, 1, inputRecord.Get().traceGroup);
+//   ...
+//   GroupNodeOutputRecords<ChildRecord> records = output.GetGroupNodeOutputRecords(childCount);
+//   if (groupIndex == 0) {
+//       recordtrace::Output(group, 2, childCount, childCount * sizeof(ChildRecord));
+//   }
+//   records.Get(i).traceGroup = group;
+//
+// All helpers return immediately if no record trace is captured. Instrumentation still adds a field to every record,
+// thus tutorials should only compile it on demand, e.g. behind a "#define RECORD_TRACE" switch.
+namespace recordtrace {
+
+    // Trace buffer: 16 byte header with the number of appended events, followed by events of 16 bytes.
+    // Layout must be in sync with RecordTrace.h.
+    RWByteAddressBuffer RecordTraceBuffer : register(u12);
+
+    // Parent group of records that are not emitted by an instrumented node (e.g., input of entry nodes)
+    static const uint NoGroup    = 0xFFFFFFFF;
+    static const uint OutputFlag = 0x80000000;
+
+    // Appends event and returns its index. Events beyond the capacity are counted, but dropped.
+    uint AppendEvent(in const uint node,
+                     in const uint parentGroup,
+                     in const uint recordCount,
+                     in const uint recordBytes)
+    {
+        if (RecordTraceCapacity == 0) {
+            return NoGroup;
+        }
+
+        uint index;
+        RecordTraceBuffer.InterlockedAdd(0, 1, index);
+
+        if (index < RecordTraceCapacity) {
+            RecordTraceBuffer.Store4(16 + index * 16, uint4(node, parentGroup, recordCount, recordBytes));
+        }
+
+        return index;
+    }
+
+    // Reports a launch of node "nodeId" with "recordCount" input records ("recordBytes" in total) emitted by
+    // "parentGroup". Returns the group id for Output and for the records emitted by this group.
+    uint BeginGroup(in const uint nodeId,
+                    in const uint parentGroup,
+                    in const uint recordCount = 1,
+                    in const uint recordBytes = 0)
+    {
+        return AppendEvent(nodeId, parentGroup, recordCount, recordBytes);
+    }
+
+    groupshared uint sharedGroup;
+
+    // Calls BeginGroup on the first thread of the thread group ("groupIndex" is SV_GroupIndex) and returns the group
+    // id on all threads. Must be called in thread group uniform control flow.
+    uint BeginThreadGroup(in const uint groupIndex,
+                          in const uint nodeId,
+                          in const uint parentGroup,
+                          in const uint recordCount = 1,
+                          in const uint recordBytes = 0)
+    {
+        // Root constants are uniform, thus all threads skip the barrier
+        if (RecordTraceCapacity == 0) {
+            return NoGroup;
+        }
+
+        if (groupIndex == 0) {
+            sharedGroup = BeginGroup(nodeId, parentGroup, recordCount, recordBytes);
+        }
+
+        GroupMemoryBarrierWithGroupSync();
+
+        return sharedGroup;
+    }
+
+    // Reports "recordCount" output records ("recordBytes" in total) for node "nodeId" emitted by "group".
+    // Outputs of multiple threads of a group are accumulated.
+    void Output(in const uint group, in const uint nodeId, in const uint recordCount, in const uint recordBytes)
+    {
+        if (recordCount > 0) {
+            AppendEvent(nodeId | OutputFlag, group, recordCount, recordBytes);
+        }
+    }
+
+}  // namespace recordtrace
+
+// MaxRecords profiling.
+// Instrumented nodes report how many records they request per thread group from an output, from which the application
+// derives the tightest [MaxRecords(...)] bound that was sufficient during the session (see "MaxRecords advisor" in the
+// readme). Profiled declarations are annotated with a probe id in the tutorial file, e.g.
+//
+//   // @MaxRecordsProbe(0)
+//   [MaxRecords(8 * 8)]
+//   [NodeId("Child")]
+//   NodeOutput<ChildRecord> output
+//
+// Records are reported next to the output record request:
+//
+//   ThreadNodeOutputRecords<ChildRecord> records = output.GetThreadNodeOutputRecords(childCount);
+//   maxrecords::ObserveThreads(groupIndex, 0, childCount);
+//
+// Outputs with [MaxRecordsSharedWith(...)] report the sum of all shared outputs with the probe of the declaration
+// they share. All helpers return immediately if MaxRecords are not profiled.
+namespace maxrecords {
+
+    // Peak record count per probe, accumulated by the application across frames
+    RWByteAddressBuffer MaxRecordsBuffer : register(u13);
+
+    // Reports "recordCount" records requested by the whole thread group, e.g. with GetGroupNodeOutputRecords or by a
+    // thread launch node. Group-uniform counts only need to be reported by a single thread.
+    void Observe(in const uint probe, in const uint recordCount)
+    {
+        if (probe < MaxRecordsProbeCount) {
+            MaxRecordsBuffer.InterlockedMax(probe * 4, recordCount);
+        }
+    }
+
+    groupshared uint sharedRecordCount;
+
+    // Reports the sum of "recordCount" over all threads of the thread group ("groupIndex" is SV_GroupIndex), e.g. with
+    // GetThreadNodeOutputRecords. Must be called in thread group uniform control flow.
+    void ObserveThreads(in const uint groupIndex, in const uint probe, in const uint recordCount)
+    {
+        if (MaxRecordsProbeCount == 0) {
+            return;
+        }
+
+        if (groupIndex == 0) {
+            sharedRecordCount = 0;
+        }
+
+        GroupMemoryBarrierWithGroupSync();
+
+        InterlockedAdd(sharedRecordCount, recordCount);
+
+        GroupMemoryBarrierWithGroupSync();
+
+        if (groupIndex == 0) {
+            Observe(probe, sharedRecordCount);
+        }
+    }
+
+}  // namespace maxrecords
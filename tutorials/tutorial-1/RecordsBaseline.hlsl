@@ -0,0 +1,173 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "Common.h"
+
+// Classic compute implementation of the sample solution, i.e., records without work graphs.
+// Records are written to buffers by the Entry pass, which also writes the indirect arguments for the thread launch
+// nodes with one thread per record:
+//
+//                         +-------+
+//                         | Entry |
+//                         +-------+
+//                             |
+//           +-----------------+-----------------+
+//           v                 v                 v
+//  +-----------------+   +----------+   +---------------+
+//  | PrintHelloWorld |   | PrintBox |   | DrawRectangle |
+//  +-----------------+   +----------+   +---------------+
+//     fixed dispatch      indirect dispatch per record buffer
+//
+// Without work graphs, record buffers must be allocated for the maximum number of records up front.
+
+// @Pass(Entry, 1, 1, 1)
+// @Pass(PrintHelloWorld, 1, 1, 1)
+// @Pass(PrintBox, Indirect, 0)
+// @Pass(DrawRectangle, Indirect, 16)
+
+// Constants that define layout and positioning of boxes.
+static const int  BoxMargin          = 10;
+static const int2 BoxSize            = int2(165, 20);
+static const int2 BoxCursorOffset    = int2(5, 3);
+static const int2 InitialBoxPosition = int2(BoxMargin * 2, 60);
+
+// Record capacities, must match the [MaxRecords(...)] of the outputs in the sample solution.
+static const uint BoxRecordCapacity       = 4;
+static const uint RectangleRecordCapacity = 5;
+// Box record: top left corner and index
+static const uint BoxRecordSize       = 16;
+// Rectangle record: top left corner, bottom right corner and color
+static const uint RectangleRecordSize = 28;
+
+// Threads per group of the PrintBox and DrawRectangle passes
+static const uint RecordsPerThreadGroup = 32;
+
+// ScratchBuffer layout:
+//   [0, 16):  D3D12_DISPATCH_ARGUMENTS of PrintBox. The fourth component counts the box records.
+//   [16, 32): D3D12_DISPATCH_ARGUMENTS of DrawRectangle. The fourth component counts the rectangle records.
+static const uint BoxArgumentsOffset       = 0;
+static const uint RectangleArgumentsOffset = 16;
+
+// @Buffer(u3, 64)
+RWByteAddressBuffer BoxRecords : register(u3);
+
+// @Buffer(u4, 140)
+RWByteAddressBuffer RectangleRecords : register(u4);
+
+groupshared uint boxRecordCount;
+groupshared uint rectangleRecordCount;
+
+void StoreRectangleRecord(in const int2 topLeft, in const int2 bottomRight, in const float3 color)
+{
+    uint index;
+    InterlockedAdd(rectangleRecordCount, 1, index);
+
+    RectangleRecords.Store4(index * RectangleRecordSize, uint4(topLeft, bottomRight));
+    RectangleRecords.Store3(index * RectangleRecordSize + 16, asuint(color));
+}
+
+void StoreArguments(in const uint offset, in const uint recordCount)
+{
+    ScratchBuffer.Store4(offset, uint4(DivideAndRoundUp(recordCount, RecordsPerThreadGroup), 1, 1, recordCount));
+}
+
+[NumThreads(4, 1, 1)]
+void Entry(uint2 dispatchThreadId : SV_DispatchThreadID, uint2 groupThreadId : SV_GroupThreadID)
+{
+    if (all(groupThreadId == 0)) {
+        boxRecordCount       = 0;
+        rectangleRecordCount = 0;
+    }
+
+    GroupMemoryBarrierWithGroupSync();
+
+    // Box position for each thread.
+    const int2 threadBoxPosition = InitialBoxPosition + dispatchThreadId * (BoxSize + BoxMargin);
+
+    // For demonstration purposes, we skip the second box.
+    const bool hasBoxOutput = !all(dispatchThreadId == int2(1, 0));
+
+    if (hasBoxOutput) {
+        uint index;
+        InterlockedAdd(boxRecordCount, 1, index);
+
+        BoxRecords.Store4(index * BoxRecordSize, uint4(threadBoxPosition, dispatchThreadId));
+
+        StoreRectangleRecord(threadBoxPosition, threadBoxPosition + BoxSize, float3(0, 0, 0));
+    }
+
+    // The shared rectangle record encloses the boxes of the first and the last thread in the group.
+    if (all(groupThreadId == 0)) {
+        const int2 lastBoxPosition = InitialBoxPosition + int2(3, 0) * (BoxSize + BoxMargin);
+
+        StoreRectangleRecord(threadBoxPosition - BoxMargin, lastBoxPosition + BoxSize + BoxMargin, float3(1, 0, 0));
+    }
+
+    GroupMemoryBarrierWithGroupSync();
+
+    if (all(groupThreadId == 0)) {
+        StoreArguments(BoxArgumentsOffset, boxRecordCount);
+        StoreArguments(RectangleArgumentsOffset, rectangleRecordCount);
+    }
+}
+
+[NumThreads(1, 1, 1)]
+void PrintHelloWorld()
+{
+    // Print a "Hello World!" message above all the boxes.
+    Cursor cursor = Cursor(InitialBoxPosition);
+    cursor.Up(2);
+    Print(cursor, "Hello World!");
+}
+
+[NumThreads(RecordsPerThreadGroup, 1, 1)]
+void PrintBox(uint index : SV_DispatchThreadID)
+{
+    if (index >= ScratchBuffer.Load(BoxArgumentsOffset + 12)) {
+        return;
+    }
+
+    const uint4 record  = BoxRecords.Load4(index * BoxRecordSize);
+    const int2  topLeft = record.xy;
+
+    // Offset the cursor inside the box & print "Box(x, y)"
+    Cursor cursor = Cursor(topLeft + BoxCursorOffset);
+    Print(cursor, "Box (");
+    PrintInt(cursor, record.z);
+    Print(cursor, ", ");
+    PrintInt(cursor, record.w);
+    Print(cursor, ")");
+}
+
+[NumThreads(RecordsPerThreadGroup, 1, 1)]
+void DrawRectangle(uint index : SV_DispatchThreadID)
+{
+    if (index >= ScratchBuffer.Load(RectangleArgumentsOffset + 12)) {
+        return;
+    }
+
+    const uint4  corners = RectangleRecords.Load4(index * RectangleRecordSize);
+    const float3 color   = asfloat(RectangleRecords.Load3(index * RectangleRecordSize + 16));
+
+    DrawRect(int2(corners.xy), int2(corners.zw), 1, color);
+}
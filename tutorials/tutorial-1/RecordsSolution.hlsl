@@ -71,11 +71,13 @@ void Entry(
     [MaxRecords(1)]
     EmptyNodeOutput PrintHelloWorld,
 
+    // @MaxRecordsProbe(0)
     [MaxRecords(4)]
     [NodeId("PrintBox")]
     NodeOutput<PrintBoxRecord> boxOutput,
 
     // [Task 4 Solution]: 5 records: 4 records (one per box) and one record enclosing all boxes.
+    // @MaxRecordsProbe(1)
     [MaxRecords(5)]
     [NodeId("DrawRectangle")]
     NodeOutput<DrawRectangleRecord> rectangleOutput
@@ -92,6 +94,7 @@ void Entry(
 
     ThreadNodeOutputRecords<PrintBoxRecord> boxOutputRecord =
         boxOutput.GetThreadNodeOutputRecords(hasBoxOutput ? 1 : 0);
+    maxrecords::ObserveThreads(groupThreadId.x, 0, hasBoxOutput ? 1 : 0);
 
     if (hasBoxOutput) {
         boxOutputRecord.Get(0).topLeft = threadBoxPosition;
@@ -115,6 +118,8 @@ void Entry(
     // [Task 6 Solution]:
     GroupNodeOutputRecords<DrawRectangleRecord> groupRectangleRecord =
         rectangleOutput.GetGroupNodeOutputRecords(1);
+    // Thread and group records of rectangleOutput share the same bound
+    maxrecords::ObserveThreads(groupThreadId.x, 1, (hasBoxOutput ? 1 : 0) + ((groupThreadId.x == 0) ? 1 : 0));
 
     // The first thread in the group wrote the record for the most top-left box,
     // thus only this thread must write the topLeft position of the shared rectangle record.
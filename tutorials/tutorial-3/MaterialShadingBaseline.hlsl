@@ -0,0 +1,199 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "Common.h"
+
+// Scene.h contains functionality for tracing rays into the scene and also
+// contains the material shading functions.
+#include "Scene.h"
+
+// Classic compute implementation of the sample solution, i.e., material binning without work graphs:
+//
+// +----------------+         +----------------+         +-------------------------+
+// | ClassifyPixels |-------->| BuildArguments |-------->| ShadePixels (3x)        |
+// +----------------+         +----------------+         |=========================|
+//   traces rays and            one indirect dispatch    | Iteration 0: Sky        |
+//   appends pixels to          per material             | Iteration 1: Sphere     |
+//   one queue per material                              | Iteration 2: Plane      |
+//                                                       +-------------------------+
+//
+// Unlike the "ShadePixel" node array, the queues must be allocated for the worst case up front, as the number of
+// pixels per material is only known after classification. Instead of allocating every queue for all samples on
+// screen, every thread group of ClassifyPixels allocates one contiguous range per material from a shared sample
+// pool and appends the range to the queue of this material. ShadePixels then launches one thread group per range.
+
+// @Pass(ClassifyPixels, RenderSize, 8, 8)
+// @Pass(BuildArguments, 1, 1, 1)
+// @Pass(ShadePixels, Indirect, 0, 3)
+
+static const uint MaterialCount = 3;
+
+// Pool capacity, enough for all samples at the largest render size (7680x4320).
+static const uint PoolCapacity = 7680 * 4320;
+// Pool entry: pixel position (16 bits per coordinate) and hit distance.
+static const uint PoolEntrySize = 8;
+
+// Queue capacity per material, enough for one range per thread group of ClassifyPixels at 7680x4320.
+static const uint QueueCapacity = (7680 / 8) * (4320 / 8);
+// Queue entry: first pool entry (25 bits) and number of pool entries minus one (6 bits) of a range.
+static const uint QueueEntrySize = 4;
+
+// Thread groups per row of the two-dimensional indirect dispatch of ShadePixels,
+// as the number of thread groups per dimension is limited to 65535.
+static const uint ShadeGroupsPerRow = 1024;
+
+// ScratchBuffer layout:
+//   [0, 48):  D3D12_DISPATCH_ARGUMENTS per material with 16 bytes stride (see ComputeBaseline::IndirectArgumentStride)
+//   [48, 60): number of queued ranges per material
+//   [60, 64): number of allocated pool entries
+static const uint ArgumentsOffset   = 0;
+static const uint ArgumentsStride   = 16;
+static const uint CountersOffset    = MaterialCount * ArgumentsStride;
+static const uint PoolCounterOffset = CountersOffset + MaterialCount * 4;
+
+// Samples of all materials
+// @Buffer(u3, 265420800)
+RWByteAddressBuffer SamplePool : register(u3);
+// One queue of ranges per material
+// @Buffer(u4, 6220800)
+RWByteAddressBuffer MaterialQueues : register(u4);
+
+groupshared uint materialSampleCount[MaterialCount];
+groupshared uint materialPoolOffset[MaterialCount];
+
+[NumThreads(8, 8, 1)]
+void ClassifyPixels(uint2 dispatchThreadId : SV_DispatchThreadID, uint groupIndex : SV_GroupIndex)
+{
+    if (groupIndex < MaterialCount) {
+        materialSampleCount[groupIndex] = 0;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // Scale dispatchThreadId by shading rate, as every sample (i.e., every thread) can cover multiple pixels.
+    // Threads outside the render target cannot return early, as they must participate in the barriers below.
+    const uint2 pixel   = dispatchThreadId * SHADING_RATE;
+    const bool  isValid = all(pixel < RenderSize);
+
+    const Ray    ray = GetCameraRay(pixel);
+    const RayHit hit = TraceRay(ray);
+
+    uint localIndex = 0;
+    if (isValid) {
+        InterlockedAdd(materialSampleCount[hit.material], 1, localIndex);
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // One thread per material allocates the pool range and appends it to the queue of its material
+    if (groupIndex < MaterialCount) {
+        const uint count = materialSampleCount[groupIndex];
+
+        uint poolOffset = PoolCapacity;
+        if (count > 0) {
+            ScratchBuffer.InterlockedAdd(PoolCounterOffset, count, poolOffset);
+
+            uint queueIndex = QueueCapacity;
+            if (poolOffset + count <= PoolCapacity) {
+                ScratchBuffer.InterlockedAdd(CountersOffset + groupIndex * 4, 1, queueIndex);
+            }
+
+            if (queueIndex < QueueCapacity) {
+                MaterialQueues.Store((groupIndex * QueueCapacity + queueIndex) * QueueEntrySize,
+                                     poolOffset | ((count - 1) << 25));
+            } else {
+                poolOffset = PoolCapacity;
+            }
+        }
+
+        materialPoolOffset[groupIndex] = poolOffset;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    if (!isValid) {
+        return;
+    }
+
+    const uint poolOffset = materialPoolOffset[hit.material];
+
+    if (poolOffset < PoolCapacity) {
+        SamplePool.Store2((poolOffset + localIndex) * PoolEntrySize,
+                          uint2(pixel.x | (pixel.y << 16), asuint(hit.distance)));
+    } else {
+        // Samples beyond the capacity (i.e., render sizes above 7680x4320) are reported in magenta instead of being
+        // silently left unshaded
+        WritePixel(pixel, float4(1, 0, 1, 1));
+    }
+}
+
+[NumThreads(MaterialCount, 1, 1)]
+void BuildArguments(uint material : SV_GroupThreadID)
+{
+    // One thread group per range
+    const uint groupCount = min(ScratchBuffer.Load(CountersOffset + material * 4), QueueCapacity);
+
+    ScratchBuffer.Store3(ArgumentsOffset + material * ArgumentsStride,
+                         uint3(min(groupCount, ShadeGroupsPerRow), DivideAndRoundUp(groupCount, ShadeGroupsPerRow), 1));
+}
+
+[NumThreads(64, 1, 1)]
+void ShadePixels(uint2 groupId : SV_GroupID, uint groupThreadId : SV_GroupThreadID)
+{
+    // Iteration of ShadePixels pass is the material of its queue
+    const uint material   = PassIteration;
+    const uint groupCount = min(ScratchBuffer.Load(CountersOffset + material * 4), QueueCapacity);
+    const uint queueIndex = groupId.y * ShadeGroupsPerRow + groupId.x;
+
+    if (queueIndex >= groupCount) {
+        return;
+    }
+
+    const uint range      = MaterialQueues.Load((material * QueueCapacity + queueIndex) * QueueEntrySize);
+    const uint poolOffset = range & 0x1FFFFFF;
+    const uint count      = (range >> 25) + 1;
+
+    if (groupThreadId >= count) {
+        return;
+    }
+
+    const uint2 entry       = SamplePool.Load2((poolOffset + groupThreadId) * PoolEntrySize);
+    const uint2 pixel       = uint2(entry.x & 0xFFFF, entry.x >> 16);
+    const float hitDistance = asfloat(entry.y);
+
+    // Recomputing the camera ray is cheaper than storing it in the queue
+    const Ray ray = GetCameraRay(pixel);
+
+    // Every thread group of a pass shades the same material, thus there is no divergence
+    float4 color;
+    switch (material) {
+        case RayHit::Sky:
+            color = ShadeSky(ray);
+            break;
+        case RayHit::Sphere:
+            color = ShadeSphere(ray, hitDistance);
+            break;
+        default:
+            color = ShadePlane(ray, hitDistance);
+            break;
+    }
+
+    WritePixel(pixel, color);
+}
@@ -0,0 +1,237 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "Common.h"
+
+// Classic compute implementation of the sample solution, i.e., recursion without work graphs.
+// Recursion is unrolled into one dispatch per recursion level. As the sample solution always subdivides until the
+// recursion limit, the number of records per level is known up front and children are stored at fixed indices:
+//
+// +-------+         +------------------------+         +---------------+
+// | Entry |-------->| Subdivide (4x)         |-------->| DrawFractals  |
+// +-------+         |========================|         +---------------+
+//   stores initial  | splits lines of level  |           draws lines and
+//   triangle and    | into four lines and    |           boxes of the last
+//   box to level 0  | boxes into eight boxes |           level
+//                   +------------------------+
+//
+// Unlike the recursive nodes, the watchdog budget (see Common.h) is not needed, as the passes are bounded.
+
+// @Pass(Entry, 1, 1, 1)
+// @Pass(Subdivide, 16, 1, 1, 4)
+// @Pass(DrawFractals, 76, 1, 1)
+
+struct Line
+{
+    float2 a, b;
+};
+
+struct Box
+{
+    float2 topLeft;
+    float size;
+};
+
+// Number of recursion levels, must match the repetitions of the Subdivide pass and [NodeMaxRecursionDepth(4)] of
+// the sample solution.
+static const uint levelCount = 4;
+
+// Lines and boxes of the last level, i.e., three lines and one box subdivided levelCount times.
+static const uint lineCapacity = 3 * 256;
+static const uint boxCapacity  = 4096;
+// Line: start and end point
+static const uint lineSize = 16;
+// Box: top left corner and size
+static const uint boxSize  = 12;
+
+// Thread groups of Subdivide, must match the pass declaration.
+// DrawFractals launches one thread per line and box of the last level, i.e., (lineCapacity + boxCapacity) / 64 groups.
+static const uint subdivideGroupCount = 16;
+
+// Lines of two consecutive levels
+// @Buffer(u3, 24576)
+RWByteAddressBuffer LineQueue : register(u3);
+
+// Boxes of two consecutive levels
+// @Buffer(u4, 98304)
+RWByteAddressBuffer BoxQueue : register(u4);
+
+// Number of lines and boxes of a level
+uint GetLineCount(in const uint level)
+{
+    return 3 * (1u << (2 * level));
+}
+
+uint GetBoxCount(in const uint level)
+{
+    return 1u << (3 * level);
+}
+
+uint GetLineAddress(in const uint level, in const uint index)
+{
+    return ((level % 2) * lineCapacity + index) * lineSize;
+}
+
+uint GetBoxAddress(in const uint level, in const uint index)
+{
+    return ((level % 2) * boxCapacity + index) * boxSize;
+}
+
+Line LoadLine(in const uint level, in const uint index)
+{
+    const float4 data = asfloat(LineQueue.Load4(GetLineAddress(level, index)));
+
+    Line result;
+    result.a = data.xy;
+    result.b = data.zw;
+    return result;
+}
+
+void StoreLine(in const uint level, in const uint index, in const float2 a, in const float2 b)
+{
+    LineQueue.Store4(GetLineAddress(level, index), asuint(float4(a, b)));
+}
+
+Box LoadBox(in const uint level, in const uint index)
+{
+    const float3 data = asfloat(BoxQueue.Load3(GetBoxAddress(level, index)));
+
+    Box result;
+    result.topLeft = data.xy;
+    result.size    = data.z;
+    return result;
+}
+
+void StoreBox(in const uint level, in const uint index, in const float2 topLeft, in const float size)
+{
+    BoxQueue.Store3(GetBoxAddress(level, index), asuint(float3(topLeft, size)));
+}
+
+[NumThreads(1, 1, 1)]
+void Entry()
+{
+    const bool   stackVertical = RenderSize.x > RenderSize.y;
+    const float  scale         = stackVertical? min(RenderSize.x * .225, RenderSize.y * .45) :
+                                                min(RenderSize.x * .45, RenderSize.y * .225);
+    // Initial equilateral triangle of the Snowflake fractal.
+    {
+        const float2 snowflakeCenter = RenderSize * (stackVertical? float2(.25, .5) : float2(.5, .25));
+
+        const float2 v0 = snowflakeCenter + scale * float2(0., -1.);
+        const float2 v1 = snowflakeCenter + scale * float2(-sqrt(3) * .5, .5);
+        const float2 v2 = snowflakeCenter + scale * float2(+sqrt(3) * .5, .5);
+
+        StoreLine(0, 0, v0, v1);
+        StoreLine(0, 1, v1, v2);
+        StoreLine(0, 2, v2, v0);
+    }
+
+    // Initial box of the Sponge fractal.
+    {
+        const float2 spongeCenter = RenderSize * (stackVertical? float2(.75, .5) : float2(.5, .75));
+
+        StoreBox(0, 0, spongeCenter - scale, 2 * scale);
+    }
+}
+
+void SubdivideLine(in const uint level, in const uint index)
+{
+    const Line segment = LoadLine(level, index);
+
+    const float2 a = segment.a;
+    const float2 b = segment.b;
+
+    // Perpendicular vector to current line segment.
+    const float2 perp = float2(a.y - b.y, b.x - a.x) * sqrt(3) / 6;
+
+    // Compute vertices for the four new line segments:
+    //
+    //             v2
+    //            /  \
+    //           /    \
+    // v0 ---- v1      v3 ---- v4
+    const float2 v0 = a;
+    const float2 v1 = lerp(a, b, 1./3.);
+    const float2 v2 = lerp(a, b, .5) + perp;
+    const float2 v3 = lerp(a, b, 2./3.);
+    const float2 v4 = b;
+
+    StoreLine(level + 1, index * 4 + 0, v0, v1);
+    StoreLine(level + 1, index * 4 + 1, v1, v2);
+    StoreLine(level + 1, index * 4 + 2, v2, v3);
+    StoreLine(level + 1, index * 4 + 3, v3, v4);
+}
+
+void SubdivideBox(in const uint level, in const uint index)
+{
+    const Box box = LoadBox(level, index);
+
+    const float newSize = box.size / 3.;
+
+    uint childIndex = index * 8;
+
+    // Split each box into eight boxes, skipping the center.
+    for (uint row = 0; row < 3; ++row) {
+        for (uint col = 0; col < 3; ++col) {
+            if (row == 1 && col == 1) continue;
+
+            StoreBox(level + 1, childIndex, box.topLeft + float2(col * newSize, row * newSize), newSize);
+
+            childIndex++;
+        }
+    }
+}
+
+[NumThreads(64, 1, 1)]
+void Subdivide(uint dispatchThreadId : SV_DispatchThreadID)
+{
+    // Iteration of Subdivide pass is the recursion level
+    const uint level = PassIteration;
+
+    const uint lineCount = GetLineCount(level);
+    const uint boxCount  = GetBoxCount(level);
+
+    // Threads loop over all lines and boxes of the level, as their number grows with every level
+    for (uint i = dispatchThreadId; i < lineCount + boxCount; i += subdivideGroupCount * 64) {
+        if (i < lineCount) {
+            SubdivideLine(level, i);
+        } else {
+            SubdivideBox(level, i - lineCount);
+        }
+    }
+}
+
+[NumThreads(64, 1, 1)]
+void DrawFractals(uint dispatchThreadId : SV_DispatchThreadID)
+{
+    // We've reached the recursion limit, thus we draw the lines and boxes of the last level to the output.
+    if (dispatchThreadId < lineCapacity) {
+        const Line segment = LoadLine(levelCount, dispatchThreadId);
+
+        DrawLine(segment.a, segment.b);
+    } else if (dispatchThreadId < lineCapacity + boxCapacity) {
+        const Box box = LoadBox(levelCount, dispatchThreadId - lineCapacity);
+
+        FillRect(box.topLeft, box.topLeft + box.size);
+    }
+}
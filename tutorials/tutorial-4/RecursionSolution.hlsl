@@ -114,8 +114,9 @@ void SnowflakeNode(
     const float2 a = inputRecord.Get().a;
     const float2 b = inputRecord.Get().b;
 
-    // Check if we have reached the recursion limit.
-    const bool hasOutput = GetRemainingRecursionLevels() != 0;
+    // Check if we have reached the recursion limit or exhausted the watchdog budget (see Common.h).
+    // Without budget, the current line is drawn as if the recursion limit was reached.
+    const bool hasOutput = (GetRemainingRecursionLevels() != 0) && watchdog::Consume(4);
 
     // Each recursion level has a 4x amplification factor, as each line
     // splits into four new lines.
@@ -166,6 +167,7 @@ void SnowflakeNode(
 void SpongeNode(
     ThreadNodeInputRecord<Box> inputRecord,
 
+    // @MaxRecordsProbe(0)
     [MaxRecords(8)]
     [NodeId("Sponge")]
     NodeOutput<Box> recursiveOutput
@@ -174,8 +176,9 @@ void SpongeNode(
     const float2 topLeft = inputRecord.Get().topLeft;
     const float  size    = inputRecord.Get().size;
 
-    // Check if we have reached the recursion limit.
-    const bool hasOutput = GetRemainingRecursionLevels() != 0;
+    // Check if we have reached the recursion limit or exhausted the watchdog budget (see Common.h).
+    // Without budget, the current box is drawn as if the recursion limit was reached.
+    const bool hasOutput = (GetRemainingRecursionLevels() != 0) && watchdog::Consume(8);
 
     // Split each box into eight boxes:
     // +---+---+---+
@@ -187,6 +190,7 @@ void SpongeNode(
     // +---+---+---+
     ThreadNodeOutputRecords<Box> outputRecords
         = recursiveOutput.GetThreadNodeOutputRecords(hasOutput * 8);
+    maxrecords::Observe(0, hasOutput * 8);
 
     if (hasOutput) {
         const float newSize = size / 3.;
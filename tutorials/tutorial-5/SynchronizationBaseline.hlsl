@@ -0,0 +1,88 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "Common.h"
+
+// Classic compute implementation of the sample solution, i.e., the bounding box without input record sharing.
+// The shared input record is replaced by the ScratchBuffer, and instead of the last thread group to finish, a separate
+// pass draws the bounding box after all thread groups of the previous pass have finished:
+//
+// +-------------------------+         +----------------+         +-----------------+
+// | InitializeBoundingBox   |-------->| DrawCircles    |-------->| DrawBoundingBox |
+// +-------------------------+         +----------------+         +-----------------+
+//   writes initial min and              draws circles and          draws bounding box
+//   max to ScratchBuffer                updates bounding box       with a single thread
+//
+// Without work graphs, no globallycoherent record or FinishedCrossGroupSharing() is needed, as the barrier between
+// the passes ensures that all atomic operations have finished.
+
+// @Pass(InitializeBoundingBox, 1, 1, 1)
+// @Pass(DrawCircles, 32, 1, 1)
+// @Pass(DrawBoundingBox, 1, 1, 1)
+
+// DrawCircles launches numPoints / groupSize thread groups, must match the pass declaration.
+static const int numPoints = 1024;
+static const int groupSize = 32;
+
+// ScratchBuffer layout:
+//   [0, 8):  minimum of the bounding box
+//   [8, 16): maximum of the bounding box
+static const uint aabbMinOffset = 0;
+static const uint aabbMaxOffset = 8;
+
+[NumThreads(1, 1, 1)]
+void InitializeBoundingBox()
+{
+    // Initialize min and max values.
+    ScratchBuffer.Store2(aabbMinOffset, RenderSize);
+    ScratchBuffer.Store2(aabbMaxOffset, uint2(0, 0));
+}
+
+[NumThreads(groupSize, 1, 1)]
+void DrawCircles(uint dtid : SV_DispatchThreadID)
+{
+    // Timestamp offset of the current circle
+    const float t      = float(dtid) / numPoints;
+    const int2  pixel  = RenderSize * .5 + 0.9 * RenderSize * float2(
+        random::PerlinNoise2D(float2('x', 2 * Time + t * 2)),
+        random::PerlinNoise2D(float2('y', 2 * Time + t * 2)));
+    // Radius of the circle to draw. The radius will slowly get smaller over time.
+    const float radius = pow(t, 2) * 15;
+    // Draw a circle around the sampled pixel. The color slowly fades out over time.
+    FillCircle(pixel, radius, lerp(float3(1, 1, 1), float3(0, 0, 1), pow(t, 2)));
+
+    // Signed atomic min/max, as the padded bounding box can extend beyond the top left corner of the render target.
+    ScratchBuffer.InterlockedMin(aabbMinOffset + 0, int(floor(pixel.x - radius)));
+    ScratchBuffer.InterlockedMin(aabbMinOffset + 4, int(floor(pixel.y - radius)));
+    ScratchBuffer.InterlockedMax(aabbMaxOffset + 0, int(ceil(pixel.x + radius)));
+    ScratchBuffer.InterlockedMax(aabbMaxOffset + 4, int(ceil(pixel.y + radius)));
+}
+
+[NumThreads(1, 1, 1)]
+void DrawBoundingBox()
+{
+    const int2 aabbmin = int2(ScratchBuffer.Load2(aabbMinOffset));
+    const int2 aabbmax = int2(ScratchBuffer.Load2(aabbMaxOffset));
+
+    DrawRect(aabbmin, aabbmax, 1);
+}
@@ -0,0 +1,272 @@
+// This file is part of the AMD & HSC Work Graph Playground.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc. and Coburg University of Applied Sciences and Arts.
+// All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "Common.h"
+
+// Mandelbrot.h contains functionality for computing and drawing the Mandelbrot fractal
+#include "Mandelbrot.h"
+
+// Enable/disable visualization of grid cells with same dwell values.
+#define VISUALIZE_GRID_CELLS 1
+
+// Classic compute implementation of the sample solution, i.e., the Mariani-Silver algorithm without work graphs.
+// Recursion is unrolled into one indirect dispatch per recursion level, and the fill and naive nodes are replaced by
+// a single pass that draws all filled and naive cells in blocks of 8x8 pixels:
+//
+// +---------------+         +------------------------+         +------------+
+// | SubdivideGrid |-------->| MarianiSilver (7x)     |-------->| DrawBlocks |
+// +---------------+         |========================|         +------------+
+//   appends tiles to        | one thread group per   |
+//   level 0                 | cell, appends sub-cells|
+//                           | to next level and 8x8  |
+//                           | blocks to block queue  |
+//                           +------------------------+
+//
+// Without work graphs, the queues between the passes must be allocated for the worst case up front.
+
+// @Pass(SubdivideGrid, 1, 1, 1)
+// @Pass(MarianiSilver, Indirect, 16, 7)
+// @Pass(DrawBlocks, 1024, 1, 1)
+
+static const int tilePow  = 8;
+static const int tileSize = 3 * (1l << tilePow) - 2;
+static const int minSize  = 16;
+
+// Number of recursion levels, must match the repetitions of the MarianiSilver pass.
+// Cells of the last level always compute all pixels (cf. GetRemainingRecursionLevels() == 0).
+static const uint levelCount = 7;
+// Cells per level, limited by the maximum number of thread groups per dimension.
+static const uint cellCapacity = 65535;
+// Cell: top left corner and size
+static const uint cellSize     = 12;
+
+// Blocks of 8x8 pixels that are either filled or computed per pixel.
+static const uint blockCapacity = 524288;
+// Block: top left corner of block, top left corner of cell (16 bits per coordinate), cell size and dwell.
+static const uint blockSize     = 16;
+// Dwell of blocks that compute the dwell of every pixel.
+static const uint naiveDwell    = 0xFFFFFFFF;
+
+// Thread groups of DrawBlocks, must match the pass declaration.
+static const uint drawBlocksGroupCount = 1024;
+
+// ScratchBuffer layout:
+//   [0, 4):   number of blocks
+//   [16, 128): D3D12_DISPATCH_ARGUMENTS of each level with 16 bytes stride.
+//              The fourth component counts the cells of the level, including cells beyond capacity.
+static const uint blockCounterOffset   = 0;
+static const uint levelArgumentsOffset = 16;
+static const uint levelArgumentsStride = 16;
+
+// Cells of two consecutive levels
+// @Buffer(u3, 1572840)
+RWByteAddressBuffer CellQueue : register(u3);
+
+// @Buffer(u4, 8388608)
+RWByteAddressBuffer BlockQueue : register(u4);
+
+uint GetCellAddress(in const uint level, in const uint index)
+{
+    return ((level % 2) * cellCapacity + index) * cellSize;
+}
+
+uint PackPosition(in const int2 position)
+{
+    return position.x | (position.y << 16);
+}
+
+int2 UnpackPosition(in const uint position)
+{
+    return int2(position & 0xFFFF, position >> 16);
+}
+
+// Appends "count" cells to "level" and returns the index of the first cell, or cellCapacity if they do not fit.
+uint AllocateCells(in const uint level, in const uint count)
+{
+    const uint argumentsAddress = levelArgumentsOffset + level * levelArgumentsStride;
+
+    uint index;
+    ScratchBuffer.InterlockedAdd(argumentsAddress + 12, count, index);
+
+    if (index + count > cellCapacity) {
+        return cellCapacity;
+    }
+
+    // Thread group count of the level
+    ScratchBuffer.InterlockedMax(argumentsAddress, index + count);
+
+    return index;
+}
+
+void StoreCell(in const uint level, in const uint index, in const int2 topLeft, in const int size)
+{
+    CellQueue.Store3(GetCellAddress(level, index), uint3(topLeft, size));
+}
+
+[NumThreads(8, 8, 1)]
+void SubdivideGrid(uint2 groupThreadId : SV_GroupThreadID)
+{
+    if (all(groupThreadId == 0)) {
+        // Thread group count in y and z is one for every level
+        for (uint level = 0; level < levelCount; ++level) {
+            ScratchBuffer.Store2(levelArgumentsOffset + level * levelArgumentsStride + 4, uint2(1, 1));
+        }
+    }
+
+    const int2 tileCount = DivideAndRoundUp(RenderSize, tileSize);
+
+    for (int y = groupThreadId.y; y < tileCount.y; y += 8) {
+        for (int x = groupThreadId.x; x < tileCount.x; x += 8) {
+            const uint index = AllocateCells(0, 1);
+
+            if (index != cellCapacity) {
+                StoreCell(0, index, int2(x, y) * tileSize, tileSize);
+            }
+        }
+    }
+}
+
+groupshared int  minDwell;
+groupshared int  maxDwell;
+groupshared uint firstBlock;
+
+[NumThreads(64, 1, 1)]
+void MarianiSilver(uint groupId : SV_GroupID, uint groupThreadId : SV_GroupThreadID)
+{
+    // Iteration of MarianiSilver pass is the recursion level
+    const uint level = PassIteration;
+
+    const uint3 cell    = CellQueue.Load3(GetCellAddress(level, groupId));
+    int2        topLeft = cell.xy;
+    int         size    = cell.z;
+
+    if (groupThreadId == 0) {
+        minDwell = maxIteration;
+        maxDwell = 0;
+    }
+
+    GroupMemoryBarrierWithGroupSync();
+
+    // Number of pixels along one edge to check
+    const int pixelsOnEdge = size - 1;
+
+    for (int i = groupThreadId; i < 4 * pixelsOnEdge; i += 64) {
+        const int side = i / pixelsOnEdge;
+        const int j    = i % pixelsOnEdge;
+
+        // Lookup for side of the tile to test
+        const int4 lookup = int4(0, j, size - 1, size - 1 - j);
+        // Compute pixel position to test
+        const int2 pixel  = topLeft + int2(lookup[(side + 1) % 4], lookup[side]);
+
+        const int dwell = GetPixelDwell(pixel);
+
+        InterlockedMin(minDwell, dwell);
+        InterlockedMax(maxDwell, dwell);
+
+        RenderTarget[pixel] = float4(DwellToColor(dwell), 1);
+    }
+
+    GroupMemoryBarrierWithGroupSync();
+
+    topLeft += int2(1, 1);
+    size    -= 2;
+
+    const bool allEqual     = minDwell == maxDwell;
+    const bool hasRecursion = !allEqual && (level + 1 < levelCount) && (size >= minSize);
+
+    if (hasRecursion) {
+        if (groupThreadId == 0) {
+            const uint index = AllocateCells(level + 1, 4);
+
+            if (index != cellCapacity) {
+                // Size is always multiple of 2, thus we can split the current grid cell into
+                // 2x2 grid cells with equal size.
+                const int nextSize = size / 2;
+
+                for (uint child = 0; child < 4; ++child) {
+                    const int2 coord = int2(child % 2, child / 2);
+
+                    StoreCell(level + 1, index + child, topLeft + coord * nextSize, nextSize);
+                }
+            }
+        }
+        return;
+    }
+
+    // Filled and naive cells are drawn in blocks of 8x8 pixels by DrawBlocks
+    const int2 blockCount = DivideAndRoundUp(int2(size, size), 8);
+
+    if (groupThreadId == 0) {
+        ScratchBuffer.InterlockedAdd(blockCounterOffset, blockCount.x * blockCount.y, firstBlock);
+    }
+
+    GroupMemoryBarrierWithGroupSync();
+
+    for (int block = groupThreadId; block < blockCount.x * blockCount.y; block += 64) {
+        if (firstBlock + block >= blockCapacity) {
+            break;
+        }
+
+        const int2 blockTopLeft = topLeft + int2(block % blockCount.x, block / blockCount.x) * 8;
+        const uint dwell        = allEqual ? minDwell : naiveDwell;
+
+        BlockQueue.Store4((firstBlock + block) * blockSize,
+                          uint4(PackPosition(blockTopLeft), PackPosition(topLeft), size, dwell));
+    }
+}
+
+[NumThreads(8, 8, 1)]
+void DrawBlocks(uint groupId : SV_GroupID, uint2 groupThreadId : SV_GroupThreadID)
+{
+    const uint blockCount = min(ScratchBuffer.Load(blockCounterOffset), blockCapacity);
+
+    // Thread groups loop over all blocks, as their number is only known on the GPU
+    for (uint block = groupId; block < blockCount; block += drawBlocksGroupCount) {
+        const uint4 entry = BlockQueue.Load4(block * blockSize);
+
+        const int2 pixel = UnpackPosition(entry.x) + groupThreadId;
+        // Position in cell
+        const int2 coord = pixel - UnpackPosition(entry.y);
+        const int  size  = entry.z;
+
+        if (any(pixel >= int2(RenderSize))) {
+            continue;
+        }
+
+        if (entry.w == naiveDwell) {
+            if (all(coord < size)) {
+                RenderTarget[pixel] = float4(DwellToColor(GetPixelDwell(pixel)), 1);
+            }
+        } else {
+#if VISUALIZE_GRID_CELLS
+            // The outer edge is left blank to visualize grid cells.
+            if (all(coord > 0) && all(coord < (size - 1))) {
+#else
+            if (all(coord < size)) {
+#endif
+                RenderTarget[pixel] = float4(DwellToColor(entry.w), 1);
+            }
+        }
+    }
+}
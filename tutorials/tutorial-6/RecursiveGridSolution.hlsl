@@ -29,8 +29,25 @@
 // Enable/disable visualization of grid cells with same dwell values.
 #define VISUALIZE_GRID_CELLS 1
 
+// Enable/disable record trace instrumentation (see "Record trace" in the readme).
+// Instrumentation adds a field to the records and a barrier to the nodes, thus it is disabled by default.
+#define RECORD_TRACE 0
+
+#if RECORD_TRACE
+// Node ids for the record trace (see recordtrace namespace in Common.h)
+static const uint EntryTraceNode         = 0; // @TraceNode(0, Entry)
+static const uint GridTraceNode          = 1; // @TraceNode(1, MandelbrotGrid)
+static const uint MarianiSilverTraceNode = 2; // @TraceNode(2, MandelbrotMarianiSilver)
+static const uint NaiveTraceNode         = 3; // @TraceNode(3, MandelbrotNaive)
+static const uint FillTraceNode          = 4; // @TraceNode(4, MandelbrotFill)
+#endif
+
 struct MandelbrotGridRecord {
     uint2 dispatchGrid : SV_DispatchGrid;
+#if RECORD_TRACE
+    // Record trace group of the producer
+    uint  traceGroup;
+#endif
 };
 
 struct NaiveMandelbrotRecord {
@@ -47,6 +64,10 @@ struct [NodeTrackRWInputSharing] MarianiSilverRecord {
     // That is why we need the NodeTrackRWInputSharing above.
     int minDwell;
     int maxDwell;
+#if RECORD_TRACE
+    // Record trace group of the producer
+    uint traceGroup;
+#endif
 };
 
 struct MandelbrotFillRecord {
@@ -74,11 +95,20 @@ void EntryNode(
     NodeOutput<MandelbrotGridRecord> gridOutput
 )
 {
+#if RECORD_TRACE
+    const uint traceGroup = recordtrace::BeginGroup(EntryTraceNode, recordtrace::NoGroup);
+#endif
+
     ThreadNodeOutputRecords<MandelbrotGridRecord> outputRecord =
         gridOutput.GetThreadNodeOutputRecords(1);
 
     outputRecord.Get().dispatchGrid = DivideAndRoundUp(RenderSize, 8 * tileSize);
 
+#if RECORD_TRACE
+    recordtrace::Output(traceGroup, GridTraceNode, 1, sizeof(MandelbrotGridRecord));
+    outputRecord.Get().traceGroup = traceGroup;
+#endif
+
     outputRecord.OutputComplete();
 }
 
@@ -90,9 +120,11 @@ void EntryNode(
 [NumThreads(8, 8, 1)]
 void MandelbrotGridNode(
     uint2 dtid : SV_DispatchThreadID,
+    uint  gi   : SV_GroupIndex,
 
     DispatchNodeInputRecord<MandelbrotGridRecord> inputRecord,
 
+    // @MaxRecordsProbe(0)
     [MaxRecords(8 * 8)]
     [NodeId("MandelbrotMarianiSilver")]
     NodeOutput<MarianiSilverRecord> mandelbrotOutput
@@ -101,8 +133,17 @@ void MandelbrotGridNode(
     const int2 topLeft   = dtid * tileSize;
     const bool hasOutput = all(topLeft < RenderSize);
 
+#if RECORD_TRACE
+    const uint traceGroup = recordtrace::BeginThreadGroup(
+        gi, GridTraceNode, inputRecord.Get().traceGroup, 1, sizeof(MandelbrotGridRecord));
+#endif
+
     ThreadNodeOutputRecords<MarianiSilverRecord> outputRecord =
         mandelbrotOutput.GetThreadNodeOutputRecords(hasOutput);
+#if RECORD_TRACE
+    recordtrace::Output(traceGroup, MarianiSilverTraceNode, hasOutput, hasOutput * sizeof(MarianiSilverRecord));
+#endif
+    maxrecords::ObserveThreads(gi, 0, hasOutput);
 
     if(hasOutput){
         outputRecord.Get().dispatchSize = DivideAndRoundUp(tileSize, 8);
@@ -110,6 +151,9 @@ void MandelbrotGridNode(
         outputRecord.Get().size         = tileSize;
         outputRecord.Get().minDwell     = maxIteration;
         outputRecord.Get().maxDwell     = 0;
+#if RECORD_TRACE
+        outputRecord.Get().traceGroup   = traceGroup;
+#endif
     }
 
     outputRecord.OutputComplete();
@@ -167,6 +211,9 @@ void MandelbrotNaiveNode(
     }
 }
 
+// Result of watchdog::Consume for the recursive output of the current group
+groupshared bool hasRecursionBudget;
+
 [Shader("node")]
 [NodeLaunch("broadcasting")]
 [NodeMaxRecursionDepth(12)]
@@ -176,9 +223,11 @@ void MandelbrotNaiveNode(
 void MandelbrotMarianiSilverNode(
     uint2 gtid : SV_GroupThreadID,
     uint2 dtid : SV_DispatchThreadID,
+    uint  gi   : SV_GroupIndex,
 
     globallycoherent RWDispatchNodeInputRecord<MarianiSilverRecord> inputRecord,
 
+    // @MaxRecordsProbe(1)
     [MaxRecords(4)]
     [NodeId("MandelbrotMarianiSilver")]
     NodeOutput<MarianiSilverRecord> recursiveOutput,
@@ -225,11 +274,39 @@ void MandelbrotMarianiSilverNode(
         return;
     }
 
-    const bool allEqual           = inputRecord.Get().minDwell == inputRecord.Get().maxDwell;
-    const bool hasFillOutput      = allEqual;
-    const bool hasNaiveOutput     = !allEqual &&
-                                    ((GetRemainingRecursionLevels() == 0) || (size < minSize));
-    const bool hasRecursiveOutput = !allEqual && !hasNaiveOutput;
+    const bool allEqual       = inputRecord.Get().minDwell == inputRecord.Get().maxDwell;
+    const bool hasNaiveOutput = !allEqual &&
+                                ((GetRemainingRecursionLevels() == 0) || (size < minSize));
+    const bool needsRecursion = !allEqual && !hasNaiveOutput;
+
+    // The recursive record count must be group-uniform, thus the first thread consumes the watchdog budget for the
+    // whole group (see Common.h).
+    if (gi == 0) {
+        hasRecursionBudget = needsRecursion && watchdog::Consume(4);
+    }
+
+    GroupMemoryBarrierWithGroupSync();
+
+    const bool hasRecursiveOutput = hasRecursionBudget;
+    // Once the budget is exhausted, grid cells are filled instead of being subdivided further
+    const bool hasFillOutput      = allEqual || (needsRecursion && !hasRecursiveOutput);
+
+#if RECORD_TRACE
+    // Only the last group of the record reports to the record trace
+    const uint traceGroup = recordtrace::BeginThreadGroup(
+        gi, MarianiSilverTraceNode, inputRecord.Get().traceGroup, 1, sizeof(MarianiSilverRecord));
+#endif
+
+    if (gi == 0) {
+#if RECORD_TRACE
+        recordtrace::Output(traceGroup, FillTraceNode, hasFillOutput, sizeof(MandelbrotFillRecord));
+        recordtrace::Output(traceGroup, NaiveTraceNode, hasNaiveOutput, sizeof(NaiveMandelbrotRecord));
+        recordtrace::Output(
+            traceGroup, MarianiSilverTraceNode, hasRecursiveOutput ? 4 : 0, 4 * sizeof(MarianiSilverRecord));
+#endif
+        // Budget of recursiveOutput is shared with naiveOutput and fillOutput
+        maxrecords::Observe(1, hasFillOutput + hasNaiveOutput + (hasRecursiveOutput ? 4 : 0));
+    }
 
     GroupNodeOutputRecords<MandelbrotFillRecord> fillOutputRecord =
         fillOutput.GetGroupNodeOutputRecords(hasFillOutput);
@@ -276,6 +353,9 @@ void MandelbrotMarianiSilverNode(
             recursiveOutputRecord.Get(gtid.y).size         = nextSize;
             recursiveOutputRecord.Get(gtid.y).minDwell     = maxIteration;
             recursiveOutputRecord.Get(gtid.y).maxDwell     = 0;
+#if RECORD_TRACE
+            recursiveOutputRecord.Get(gtid.y).traceGroup   = traceGroup;
+#endif
         }
     }
 